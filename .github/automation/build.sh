@@ -59,6 +59,9 @@ if [ "${BUILD_THREADING}" == "tbb" ]; then
 elif [ "${BUILD_THREADING}" == "omp" ]; then
     echo "Info: Setting DNNL_CPU_RUNTIME to OMP..."
     CPU_RUNTIME="OMP"
+elif [ "${BUILD_THREADING}" == "work_stealing" ]; then
+    echo "Info: Setting DNNL_CPU_RUNTIME to WORK_STEALING..."
+    CPU_RUNTIME="WORK_STEALING"
 elif [ "${BUILD_THREADING}" == "ocl" ]; then
     echo "Info: Setting DNNL_CPU_RUNTIME to OMP..."
     echo "Info: Setting DNNL_GPU_RUNTIME to OCL..."
@@ -269,6 +269,57 @@ dnnl_status_t DNNL_API dnnl_primitive_get_primitive_desc(
 ///     otherwise.
 dnnl_status_t DNNL_API dnnl_primitive_destroy(dnnl_primitive_t primitive);
 
+/// Starts creating a primitive on a library-owned worker thread and returns
+/// immediately. The created primitive is put into the primitive cache, hence
+/// the function can also be used to prepare primitives that are likely to be
+/// needed later.
+///
+/// The number of worker threads is controlled by the
+/// DNNL_PRIMITIVE_CREATION_THREADS environment variable (1 by default).
+///
+/// The future keeps its own copy of the primitive descriptor, so
+/// @p primitive_desc can be destroyed right after the call.
+///
+/// @param future Output primitive future.
+/// @param primitive_desc Primitive descriptor.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_create_async(
+        dnnl_primitive_future_t *future,
+        const_dnnl_primitive_desc_t primitive_desc);
+
+/// Checks whether the creation of a primitive started with
+/// #dnnl_primitive_create_async() is complete.
+///
+/// @param future Primitive future.
+/// @param is_ready Output value: 1 if the creation is complete and 0
+///     otherwise.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_future_is_ready(
+        const_dnnl_primitive_future_t future, int *is_ready);
+
+/// Waits for the creation of a primitive started with
+/// #dnnl_primitive_create_async() to complete and returns the primitive.
+/// The function may be called multiple times, each call returns a new
+/// handle that must be destroyed with #dnnl_primitive_destroy().
+///
+/// @param future Primitive future.
+/// @param primitive Output primitive.
+/// @returns #dnnl_success on success and a status describing the error
+///     of the primitive creation otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_future_get(
+        const_dnnl_primitive_future_t future, dnnl_primitive_t *primitive);
+
+/// Destroys a primitive future. Waits for the creation to complete if it is
+/// still in progress.
+///
+/// @param future Primitive future to destroy.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_future_destroy(
+        dnnl_primitive_future_t future);
+
 /// @} dnnl_api_primitives_common
 
 /// @addtogroup dnnl_api_attributes
@@ -532,6 +583,34 @@ dnnl_status_t DNNL_API dnnl_primitive_attr_set_zero_points(
         dnnl_primitive_attr_t attr, int arg, dnnl_dim_t count, int mask,
         const int32_t *zero_points);
 
+/// Returns the data type to which the source tensor is dynamically quantized,
+/// previously set by dnnl_primitive_attr_set_src_dynamic_quantization.
+///
+/// @param attr Primitive attributes.
+/// @param data_type Output data type of the quantized source tensor, or
+///     #dnnl_data_type_undef if the source is not quantized.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_get_src_dynamic_quantization(
+        const_dnnl_primitive_attr_t attr, dnnl_data_type_t *data_type);
+
+/// Sets dynamic quantization of the source tensor.
+///
+/// At execution time, each row of the floating-point source tensor is scaled
+/// by 127 over its maximum absolute value and rounded to @p data_type. The
+/// computations are performed in integer arithmetic and the result is scaled
+/// back by the inverse of the row scale before bias and output scales are
+/// applied.
+///
+/// @param attr Primitive attributes.
+/// @param data_type Data type of the quantized source tensor. The possible
+///     values are #dnnl_data_type_undef (default, no quantization) and
+///     #dnnl_s8.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_primitive_attr_set_src_dynamic_quantization(
+        dnnl_primitive_attr_t attr, dnnl_data_type_t data_type);
+
 /// Returns primitive attributes post-ops.
 ///
 /// @warning
@@ -1161,6 +1240,33 @@ dnnl_status_t DNNL_API dnnl_memory_create(dnnl_memory_t *memory,
         const dnnl_memory_desc_t *memory_desc, dnnl_engine_t engine,
         void *handle);
 
+/// Creates a memory object backed by a read-only mapping of a file region.
+///
+/// The file region starting at @p offset must hold the data laid out
+/// according to @p memory_desc, e.g. weights reordered to the format
+/// expected by a primitive ahead of time. The data is not copied: all the
+/// processes that map the same file share its physical pages. The memory
+/// object must only be used as a primitive input. Writing to it, e.g. by
+/// passing it as a primitive output, results in a segmentation fault.
+///
+/// @note
+///     Only native CPU engines on Linux are supported.
+///
+/// @param memory Output memory object.
+/// @param memory_desc Memory descriptor.
+/// @param engine Engine to use.
+/// @param path Path to the file to map.
+/// @param offset Offset of the data in the file in bytes. Must be a multiple
+///     of the alignment of the data type (and of 4 if the memory descriptor
+///     has extra buffers, e.g. compensations).
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise. #dnnl_invalid_arguments is returned if the file cannot be
+///     opened, the region does not fit into the file, or the offset is not
+///     properly aligned.
+dnnl_status_t DNNL_API dnnl_memory_create_from_file(dnnl_memory_t *memory,
+        const dnnl_memory_desc_t *memory_desc, dnnl_engine_t engine,
+        const char *path, size_t offset);
+
 /// Returns the memory descriptor for a memory object.
 ///
 /// @param memory Memory object.
@@ -3325,6 +3431,38 @@ dnnl_status_t DNNL_API dnnl_matmul_desc_init(dnnl_matmul_desc_t *matmul_desc,
         const dnnl_memory_desc_t *bias_desc,
         const dnnl_memory_desc_t *dst_desc);
 
+/// Initializes a grouped matrix multiplication descriptor.
+///
+/// The rows of the source and destination matrices are split into G
+/// contiguous groups, and each group is multiplied by its own weights
+/// matrix. The group boundaries are passed at execution time as an s32 tensor
+/// of G + 1 offsets (#DNNL_ARG_GROUP_OFFSETS): the rows of group g are
+/// [offsets[g], offsets[g + 1]). The offsets must be non-decreasing, with
+/// offsets[0] = 0 and offsets[G] = M. Empty groups are allowed.
+///
+/// @param matmul_desc Output descriptor for grouped matmul primitive.
+/// @param src_desc Source memory descriptor (matrix A) of dimensions
+///     {M, K}.
+/// @param weights_desc Weights memory descriptor (matrices B) of dimensions
+///     {G, K, N}.
+/// @param bias_desc Bias memory descriptor of dimensions {G, 1, N} or
+///     {1, 1, N}. Passing NULL, a zero memory descriptor, or a memory
+///     descriptor with format_kind set to #dnnl_format_kind_undef disables
+///     the bias term.
+/// @param dst_desc Destination memory descriptor (matrix C) of dimensions
+///     {M, N}.
+/// @param group_offsets_desc Group offsets memory descriptor of dimensions
+///     {G + 1} and data type #dnnl_s32.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_matmul_grouped_desc_init(
+        dnnl_matmul_grouped_desc_t *matmul_desc,
+        const dnnl_memory_desc_t *src_desc,
+        const dnnl_memory_desc_t *weights_desc,
+        const dnnl_memory_desc_t *bias_desc,
+        const dnnl_memory_desc_t *dst_desc,
+        const dnnl_memory_desc_t *group_offsets_desc);
+
 /// @} dnnl_api_matmul
 
 /// @addtogroup dnnl_api_resampling Resampling
@@ -3421,6 +3559,79 @@ size_t DNNL_API dnnl_engine_get_count(dnnl_engine_kind_t kind);
 dnnl_status_t DNNL_API dnnl_engine_create(
         dnnl_engine_t *engine, dnnl_engine_kind_t kind, size_t index);
 
+/// Creates an engine that allocates memory through user-provided functions.
+///
+/// The functions are used for the buffers of memory objects allocated by the
+/// library and for the scratchpads of primitives created on the engine. The
+/// buffers are freed with @p free together with the usage hint passed to
+/// @p alloc. Both functions may be called concurrently from different
+/// threads and must remain valid until all the objects created on the
+/// engine are destroyed.
+///
+/// @note
+///     Only CPU engines with the OpenMP, TBB, sequential, or threadpool
+///     runtime support user allocators.
+///
+/// @param engine Output engine.
+/// @param kind Engine kind.
+/// @param index Engine index that should be between 0 and the count of
+///     engines of the requested kind.
+/// @param alloc Allocation function.
+/// @param free Deallocation function.
+/// @param context User context passed to @p alloc and @p free.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_engine_create_with_allocator(dnnl_engine_t *engine,
+        dnnl_engine_kind_t kind, size_t index, dnnl_allocator_alloc_f alloc,
+        dnnl_allocator_free_f free, void *context);
+
+/// Creates an engine that executes primitives on a set of cores.
+///
+/// The threads executing primitives on streams of the engine are bound to the
+/// cores. With the OpenMP runtime each thread of a parallel region is bound
+/// to its own core, and with other runtimes each thread is bound to the whole
+/// set of cores. The original binding of each thread is restored at the end
+/// of the region. The number of threads is limited by the number of cores in
+/// the same way as with #dnnl_stream_create_with_max_threads(), so primitives
+/// meant for the engine should be created with the same limit set for the
+/// creating thread (#dnnl_set_max_threads_limit()).
+///
+/// If all the cores belong to a single NUMA node, the buffers of memory
+/// objects allocated by the library and the scratchpads of primitives created
+/// on the engine are placed on this node. Such scratchpads are private to the
+/// primitive.
+///
+/// @note
+///     Only CPU engines with the OpenMP, TBB, sequential, or threadpool
+///     runtime on Linux support core binding.
+///
+/// @sa dnnl_get_numa_node_cores()
+///
+/// @param engine Output engine.
+/// @param kind Engine kind.
+/// @param index Engine index that should be between 0 and the count of
+///     engines of the requested kind.
+/// @param ncores Number of cores.
+/// @param cores Array of @p ncores logical core indices.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_engine_create_with_cpu_affinity(
+        dnnl_engine_t *engine, dnnl_engine_kind_t kind, size_t index,
+        int ncores, const int *cores);
+
+/// Returns the logical core indices of a NUMA node.
+///
+/// @param numa_node NUMA node index.
+/// @param ncores Output number of cores. Set to 0 if the node does not exist
+///     or the platform topology is unknown.
+/// @param cores Output array of at least @p max_cores elements that receives
+///     the core indices. May be NULL to query the number of cores only.
+/// @param max_cores Size of the @p cores array.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_get_numa_node_cores(
+        int numa_node, int *ncores, int *cores, int max_cores);
+
 /// Returns the kind of an engine.
 ///
 /// @param engine Engine to query.
@@ -3452,6 +3663,36 @@ dnnl_status_t DNNL_API dnnl_engine_destroy(dnnl_engine_t engine);
 dnnl_status_t DNNL_API dnnl_stream_create(
         dnnl_stream_t *stream, dnnl_engine_t engine, unsigned flags);
 
+/// Creates an execution stream that limits the number of threads used by the
+/// primitives executed on it. The limit also applies to the threads of the
+/// OpenMP and TBB runtimes.
+///
+/// @note
+///     The blocking of some primitive implementations depends on the number
+///     of threads available at primitive creation. A primitive executed on
+///     such a stream must be created with a limit that is not greater than
+///     the limit of the stream (see dnnl_set_max_threads_limit()) to use all
+///     the threads efficiently.
+///
+/// @param stream Output execution stream.
+/// @param engine CPU engine to create the execution stream on.
+/// @param flags Stream behavior flags (@sa dnnl_stream_flags_t).
+/// @param max_threads Maximum number of threads. 0 means no limit.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_stream_create_with_max_threads(
+        dnnl_stream_t *stream, dnnl_engine_t engine, unsigned flags,
+        int max_threads);
+
+/// Returns the maximum number of threads of a stream.
+///
+/// @param stream Stream object.
+/// @param max_threads Output maximum number of threads. 0 means no limit.
+/// @returns #dnnl_success on success and a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_stream_get_max_threads(
+        const_dnnl_stream_t stream, int *max_threads);
+
 /// Returns the engine of a stream object.
 ///
 /// @param stream Stream object.
@@ -3503,6 +3744,99 @@ dnnl_status_t DNNL_API dnnl_get_primitive_cache_capacity(int *capacity);
 ///     success.
 dnnl_status_t DNNL_API dnnl_set_primitive_cache_capacity(int capacity);
 
+/// Returns the limit of the total footprint of the primitives held in the
+/// primitive cache in bytes.
+///
+/// @param capacity Primitive cache capacity in bytes to query. The value of 0
+///     means that the footprint is not limited.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p capacity value is invalid, and #dnnl_success/#dnnl::status::success on
+///     success.
+dnnl_status_t DNNL_API dnnl_get_primitive_cache_capacity_bytes(
+        size_t *capacity);
+
+/// Limits the total footprint of the primitives held in the primitive cache.
+/// The footprint of a primitive is estimated as the size of its generated
+/// code and of the objects it consists of. Once the limit is exceeded,
+/// primitives are evicted starting from the ones with the largest product of
+/// the footprint and the time since the last use. The limit applies on top of
+/// the capacity set with #dnnl_set_primitive_cache_capacity().
+///
+/// @param capacity Primitive cache capacity in bytes to set. The value of 0
+///     removes the limit.
+/// @returns #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_set_primitive_cache_capacity_bytes(
+        size_t capacity);
+
+/// Returns the number of primitives held in the primitive cache and their
+/// total estimated footprint in bytes.
+///
+/// @param n_entries Output number of primitives. May be NULL.
+/// @param n_bytes Output footprint in bytes. May be NULL.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if both
+///     @p n_entries and @p n_bytes are NULL, and
+///     #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_get_primitive_cache_usage(
+        int *n_entries, size_t *n_bytes);
+
+/// Writes the descriptors of the primitives held in the primitive cache to a
+/// file. Each entry records the operation descriptor, the attributes and the
+/// chosen implementation so that the primitive can be re-created with
+/// #dnnl_import_primitive_cache() without going through the list of
+/// implementations. Primitives that depend on a forward primitive descriptor
+/// hint or on attributes that cannot be stored (e.g. depthwise post-op) are
+/// skipped.
+///
+/// @param path Path of the file to write.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     file cannot be opened, #dnnl_runtime_error/#dnnl::status::runtime_error
+///     if it cannot be written, and #dnnl_success/#dnnl::status::success on
+///     success.
+dnnl_status_t DNNL_API dnnl_export_primitive_cache(const char *path);
+
+/// Re-creates the primitives listed in a file written by
+/// #dnnl_export_primitive_cache() and puts them into the primitive cache.
+/// Subsequent creation of the same primitives is served from the cache
+/// without generating code. Only entries created for the kind of @p engine
+/// are imported.
+///
+/// @param engine Engine to create the primitives for.
+/// @param path Path of the file to read.
+/// @param n_imported Output number of imported primitives. May be NULL.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     file cannot be read, is corrupted or was written by another version
+///     of the library or on a machine with another ISA, and
+///     #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_import_primitive_cache(
+        dnnl_engine_t engine, const char *path, int *n_imported);
+
+/// Returns the number of primitive creation requests that were served by
+/// primitives imported with #dnnl_import_primitive_cache() instead of
+/// generating code. Each imported primitive is counted once.
+///
+/// @param hits Output number of hits.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p hits value is invalid, and #dnnl_success/#dnnl::status::success on
+///     success.
+dnnl_status_t DNNL_API dnnl_get_primitive_cache_persistent_hits(size_t *hits);
+
+/// Returns primitive cache statistics.
+///
+/// @param kind Primitive kind to return the statistics for. Statistics of
+///     all primitive kinds, including the ones used internally by the
+///     library, are summed up if @p kind is #dnnl_undefined_primitive.
+/// @param stats Output statistics.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p stats value is invalid, and #dnnl_success/#dnnl::status::success on
+///     success.
+dnnl_status_t DNNL_API dnnl_primitive_cache_get_stats(
+        dnnl_primitive_kind_t kind, dnnl_primitive_cache_stats_t *stats);
+
+/// Resets primitive cache statistics.
+///
+/// @returns #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_primitive_cache_reset_stats(void);
+
 /// @} dnnl_api_primitive_cache
 
 /// @addtogroup dnnl_api_mathmode
@@ -3548,6 +3882,34 @@ dnnl_status_t DNNL_API dnnl_set_default_fpmath_mode(dnnl_fpmath_mode_t mode);
 ///     success.
 dnnl_status_t DNNL_API dnnl_set_verbose(int level);
 
+/// Configures tracing of primitive creation and execution.
+///
+/// When tracing is enabled, the library records the start and the duration
+/// of each primitive creation and execution together with the primitive
+/// information printed in verbose mode. The events are kept in per-thread
+/// ring buffers and are written to the trace file in the Chrome trace event
+/// format, which can be viewed with chrome://tracing or Perfetto UI, at the
+/// program exit or on a dnnl_flush_trace() call.
+///
+/// @note
+///     This setting overrides the DNNL_TRACE_FILE environment variable.
+///
+/// @param path Path to the trace file. Pass NULL or an empty string to
+///     disable tracing. Events recorded so far are written to the previous
+///     trace file.
+/// @returns #dnnl_success/#dnnl::status::success on success and
+///     #dnnl_unimplemented/#dnnl::status::unimplemented if verbose support
+///     was disabled at build time.
+dnnl_status_t DNNL_API dnnl_set_trace_file(const char *path);
+
+/// Writes the recorded tracing events to the trace file and clears the
+/// per-thread buffers. Events of subsequent calls are appended to the file.
+///
+/// @returns #dnnl_success/#dnnl::status::success on success and
+///     #dnnl_runtime_error/#dnnl::status::runtime_error if the trace file
+///     cannot be written.
+dnnl_status_t DNNL_API dnnl_flush_trace(void);
+
 /// Configures dumping of JIT-generated code.
 ///
 /// @note
@@ -3694,6 +4056,67 @@ dnnl_status_t DNNL_API dnnl_set_cpu_isa_hints(dnnl_cpu_isa_hints_t isa_hints);
 /// library can follow.
 dnnl_cpu_isa_hints_t DNNL_API dnnl_get_cpu_isa_hints(void);
 
+/// Sets the huge pages mode for buffers allocated by the library on CPU
+/// engines. The mode applies to the buffers of memory objects and to
+/// scratchpads that are at least as large as a huge page (2 MB) and are
+/// allocated after the call. See #dnnl_cpu_hugepages_mode_t and
+/// #dnnl::cpu_hugepages_mode for the list of the values accepted by the C and
+/// C++ API functions respectively.
+///
+/// This function overrides the DNNL_CPU_HUGEPAGES environment variable.
+///
+/// @param mode Huge pages mode.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p mode value is invalid, #dnnl_unimplemented/
+///     #dnnl::status::unimplemented if huge pages are not supported on the
+///     platform, and #dnnl_success/#dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_set_cpu_hugepages_mode(
+        dnnl_cpu_hugepages_mode_t mode);
+
+/// Returns the huge pages mode for buffers allocated by the library on CPU
+/// engines.
+///
+/// @returns Huge pages mode.
+dnnl_cpu_hugepages_mode_t DNNL_API dnnl_get_cpu_hugepages_mode(void);
+
+/// Limits the number of threads that the library uses on CPU for the calling
+/// thread. The limit applies to the primitives created by the calling thread,
+/// which choose their blocking for the limited number of threads, and to the
+/// primitives it executes. A stream limit (see
+/// dnnl_stream_create_with_max_threads()) further reduces the number of
+/// threads during execution.
+///
+/// The setting is thread-local and is taken into account by the primitive
+/// cache, so primitives created with different limits are not shared. It is
+/// also passed on to the threads that create primitives asynchronously and
+/// that import the primitive cache on behalf of the calling thread. A
+/// primitive never uses more threads than it was created for, even if it is
+/// executed by a thread with a greater limit.
+///
+/// @param max_threads Maximum number of threads. 0 means no limit.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p max_threads value is negative and #dnnl_success/
+///     #dnnl::status::success on success.
+dnnl_status_t DNNL_API dnnl_set_max_threads_limit(int max_threads);
+
+/// Returns the limit on the number of threads set for the calling thread.
+///
+/// @returns Maximum number of threads. 0 means no limit.
+int DNNL_API dnnl_get_max_threads_limit(void);
+
+/// Returns statistics of the scratchpad pool. The pool is enabled with the
+/// DNNL_SCRATCHPAD_POOL environment variable, all statistics are zero
+/// otherwise.
+///
+/// @sa @ref dev_guide_attributes_scratchpad for more details
+///
+/// @param stats Output statistics.
+/// @returns #dnnl_invalid_arguments/#dnnl::status::invalid_arguments if the
+///     @p stats value is invalid, and #dnnl_success/#dnnl::status::success on
+///     success.
+dnnl_status_t DNNL_API dnnl_get_scratchpad_pool_stats(
+        dnnl_scratchpad_pool_stats_t *stats);
+
 /// @} dnnl_api_service
 
 /// @addtogroup dnnl_api_blas
@@ -242,6 +242,13 @@ struct handle_traits<dnnl_primitive_t> {
     }
 };
 
+template <>
+struct handle_traits<dnnl_primitive_future_t> {
+    static dnnl_status_t destructor(dnnl_primitive_future_t p) {
+        return dnnl_primitive_future_destroy(p);
+    }
+};
+
 template <>
 struct handle_traits<dnnl_primitive_desc_iterator_t> {
     static dnnl_status_t destructor(dnnl_primitive_desc_iterator_t p) {
@@ -313,6 +320,9 @@ struct primitive : public handle<dnnl_primitive_t> {
         reduction = dnnl_reduction,
         /// A PReLU primitive.
         prelu = dnnl_prelu,
+        /// A grouped matmul operation descriptor. The primitive created from
+        /// it is a #matmul primitive.
+        matmul_grouped = dnnl_matmul_grouped,
     };
 
     using handle::handle;
@@ -383,6 +393,41 @@ dnnl::primitive::kind primitive::get_kind() const {
     return static_cast<dnnl::primitive::kind>(kind);
 }
 
+/// A primitive being created in the background by a library-owned worker
+/// thread. The created primitive is put into the primitive cache, hence
+/// creating the same primitive later is cheap even if the future is not
+/// used.
+struct primitive_future : public handle<dnnl_primitive_future_t> {
+    using handle::handle;
+
+    /// Default constructor. Constructs an empty object.
+    primitive_future() = default;
+
+    /// Starts creating a primitive in the background. The primitive
+    /// descriptor can be destroyed right after the call.
+    ///
+    /// @param pd Primitive descriptor.
+    primitive_future(const primitive_desc &pd);
+
+    /// Returns whether the creation is complete.
+    bool is_ready() const {
+        int result = 0;
+        error::wrap_c_api(dnnl_primitive_future_is_ready(get(), &result),
+                "could not query a primitive future");
+        return result != 0;
+    }
+
+    /// Waits for the creation to complete and returns the primitive.
+    ///
+    /// @returns The created primitive.
+    primitive get_primitive() const {
+        dnnl_primitive_t result;
+        error::wrap_c_api(dnnl_primitive_future_get(get(), &result),
+                "could not create a primitive");
+        return primitive(result);
+    }
+};
+
 /// @} dnnl_api_primitives_common
 
 /// @addtogroup dnnl_api_attributes
@@ -953,6 +998,43 @@ struct engine : public handle<dnnl_engine_t> {
         reset(engine);
     }
 
+    /// Constructs an engine that allocates memory through user-provided
+    /// functions. See dnnl_engine_create_with_allocator() for details.
+    ///
+    /// @param akind The kind of engine to construct.
+    /// @param index The index of the engine. Must be less than the value
+    ///     returned by #get_count() for this particular kind of engine.
+    /// @param alloc Allocation function.
+    /// @param free Deallocation function.
+    /// @param context User context passed to @p alloc and @p free.
+    engine(kind akind, size_t index, dnnl_allocator_alloc_f alloc,
+            dnnl_allocator_free_f free, void *context = nullptr) {
+        dnnl_engine_t engine;
+        error::wrap_c_api(dnnl_engine_create_with_allocator(&engine,
+                                  convert_to_c(akind), index, alloc, free,
+                                  context),
+                "could not create an engine with a user allocator");
+        reset(engine);
+    }
+
+    /// Constructs an engine that executes primitives on a set of cores. See
+    /// dnnl_engine_create_with_cpu_affinity() for details.
+    ///
+    /// @param akind The kind of engine to construct.
+    /// @param index The index of the engine. Must be less than the value
+    ///     returned by #get_count() for this particular kind of engine.
+    /// @param cores Logical core indices, e.g. returned by
+    ///     dnnl::get_numa_node_cores().
+    engine(kind akind, size_t index, const std::vector<int> &cores) {
+        dnnl_engine_t engine;
+        error::wrap_c_api(
+                dnnl_engine_create_with_cpu_affinity(&engine,
+                        convert_to_c(akind), index, (int)cores.size(),
+                        cores.data()),
+                "could not create an engine with a cpu affinity");
+        reset(engine);
+    }
+
     /// Constructs an engine based on a primitive from the primitive
     /// descriptor @p pd by querying its engine.
     ///
@@ -1008,6 +1090,24 @@ inline dnnl_engine_kind_t convert_to_c(engine::kind akind) {
     return static_cast<dnnl_engine_kind_t>(akind);
 }
 
+/// Returns the logical core indices of a NUMA node. See
+/// dnnl_get_numa_node_cores() for details.
+///
+/// @param numa_node NUMA node index.
+/// @returns Core indices, empty if the node does not exist or the platform
+///     topology is unknown.
+inline std::vector<int> get_numa_node_cores(int numa_node) {
+    int ncores = 0;
+    error::wrap_c_api(
+            dnnl_get_numa_node_cores(numa_node, &ncores, nullptr, 0),
+            "could not get cores of a numa node");
+    std::vector<int> cores(ncores);
+    error::wrap_c_api(dnnl_get_numa_node_cores(
+                              numa_node, &ncores, cores.data(), ncores),
+            "could not get cores of a numa node");
+    return cores;
+}
+
 /// @} dnnl_api_engine
 
 /// @addtogroup dnnl_api_stream Stream
@@ -1058,6 +1158,24 @@ struct stream : public handle<dnnl_stream_t> {
         reset(stream);
     }
 
+    /// Constructs a stream for the specified CPU engine that limits the
+    /// number of threads used by the primitives executed on it.
+    ///
+    /// @sa dnnl_stream_create_with_max_threads()
+    ///
+    /// @param aengine Engine to create the stream on.
+    /// @param aflags Flags controlling stream behavior.
+    /// @param max_threads Maximum number of threads. 0 means no limit.
+    stream(const engine &aengine, flags aflags, int max_threads) {
+        dnnl_stream_t stream;
+        error::wrap_c_api(dnnl_stream_create_with_max_threads(&stream,
+                                  aengine.get(),
+                                  static_cast<dnnl_stream_flags_t>(aflags),
+                                  max_threads),
+                "could not create a stream");
+        reset(stream);
+    }
+
     /// Returns the associated engine.
     engine get_engine() const {
         dnnl_engine_t c_engine;
@@ -1066,6 +1184,15 @@ struct stream : public handle<dnnl_stream_t> {
         return engine(c_engine, true);
     }
 
+    /// Returns the maximum number of threads of the stream or 0 if the
+    /// number of threads is not limited.
+    int get_max_threads() const {
+        int max_threads;
+        error::wrap_c_api(dnnl_stream_get_max_threads(get(), &max_threads),
+                "could not get the maximum number of threads of a stream");
+        return max_threads;
+    }
+
     /// Waits for all primitives executing in the stream to finish.
     /// @returns The stream itself.
     stream &wait() {
@@ -2663,6 +2790,23 @@ struct memory : public handle<dnnl_memory_t> {
     memory(const desc &md, const engine &aengine)
         : memory(md, aengine, DNNL_MEMORY_ALLOCATE) {}
 
+    /// Creates a memory object backed by a read-only mapping of a file
+    /// region. See dnnl_memory_create_from_file() for details.
+    ///
+    /// @param md Memory descriptor.
+    /// @param aengine Engine to store the data on.
+    /// @param path Path to the file to map.
+    /// @param offset Offset of the data in the file in bytes.
+    /// @returns Memory object.
+    static memory create_from_file(const desc &md, const engine &aengine,
+            const std::string &path, size_t offset = 0) {
+        dnnl_memory_t result;
+        error::wrap_c_api(dnnl_memory_create_from_file(&result, &md.data,
+                                  aengine.get(), path.c_str(), offset),
+                "could not create a memory object from a file");
+        return memory(result);
+    }
+
     /// Returns the associated memory descriptor.
     desc get_desc() const {
         const dnnl_memory_desc_t *cdesc;
@@ -3523,6 +3667,32 @@ struct primitive_attr : public handle<dnnl_primitive_attr_t> {
                 "could not set zero points primitive attribute");
     }
 
+    /// Returns the data type to which the source tensor is dynamically
+    /// quantized.
+    ///
+    /// @returns Data type of the quantized source tensor, or
+    ///     #dnnl::memory::data_type::undef if the source is not quantized.
+    memory::data_type get_src_dynamic_quantization() const {
+        dnnl_data_type_t result;
+        error::wrap_c_api(dnnl_primitive_attr_get_src_dynamic_quantization(
+                                  get(), &result),
+                "could not get src dynamic quantization primitive attribute");
+        return memory::data_type(result);
+    }
+
+    /// Sets dynamic quantization of the source tensor.
+    ///
+    /// @sa dnnl_primitive_attr_set_src_dynamic_quantization
+    ///
+    /// @param data_type Data type of the quantized source tensor. The
+    ///     possible values are #dnnl::memory::data_type::undef (no
+    ///     quantization) and #dnnl::memory::data_type::s8.
+    void set_src_dynamic_quantization(memory::data_type data_type) {
+        error::wrap_c_api(dnnl_primitive_attr_set_src_dynamic_quantization(
+                                  get(), memory::convert_to_c(data_type)),
+                "could not set src dynamic quantization primitive attribute");
+    }
+
     /// Returns post-ops previously set via set_post_ops().
     ///
     /// @returns Post-ops.
@@ -10414,6 +10584,33 @@ struct matmul : public primitive {
         }
     };
 
+    /// Descriptor for a grouped matmul primitive.
+    struct grouped_desc {
+        dnnl_matmul_grouped_desc_t data;
+
+        /// Constructs a descriptor for a grouped matmul primitive.
+        ///
+        /// @sa dnnl_matmul_grouped_desc_init
+        ///
+        /// @param src_desc Memory descriptor for source (matrix A).
+        /// @param weights_desc Memory descriptor for weights (matrices B).
+        /// @param bias_desc Memory descriptor for bias. Passing a zero memory
+        ///     descriptor disables the bias term.
+        /// @param dst_desc Memory descriptor for destination (matrix C).
+        /// @param group_offsets_desc Memory descriptor for group offsets.
+        grouped_desc(const memory::desc &src_desc,
+                const memory::desc &weights_desc,
+                const memory::desc &bias_desc, const memory::desc &dst_desc,
+                const memory::desc &group_offsets_desc) {
+            error::wrap_c_api(
+                    dnnl_matmul_grouped_desc_init(&data, &src_desc.data,
+                            &weights_desc.data, &bias_desc.data,
+                            &dst_desc.data, &group_offsets_desc.data),
+                    "could not create a descriptor for a grouped matmul "
+                    "primitive");
+        }
+    };
+
     /// Primitive descriptor for a matmul primitive.
     struct primitive_desc : public dnnl::primitive_desc {
         /// Default constructor. Produces an empty object.
@@ -10446,6 +10643,33 @@ struct matmul : public primitive {
             : dnnl::primitive_desc(
                     &adesc.data, &attr, aengine, nullptr, allow_empty) {}
 
+        /// Constructs a primitive descriptor for a grouped matmul primitive.
+        ///
+        /// @param adesc Descriptor for a grouped matmul primitive.
+        /// @param aengine Engine to use.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const grouped_desc &adesc, const engine &aengine,
+                bool allow_empty = false)
+            : dnnl::primitive_desc(
+                    &adesc.data, nullptr, aengine, nullptr, allow_empty) {}
+
+        /// Constructs a primitive descriptor for a grouped matmul primitive.
+        ///
+        /// @param adesc Descriptor for a grouped matmul primitive.
+        /// @param attr Primitive attributes to use.
+        /// @param aengine Engine to use.
+        /// @param allow_empty A flag signifying whether construction is
+        ///     allowed to fail without throwing an exception. In this case an
+        ///     empty object will be produced. This flag is optional and
+        ///     defaults to false.
+        primitive_desc(const grouped_desc &adesc, const primitive_attr &attr,
+                const engine &aengine, bool allow_empty = false)
+            : dnnl::primitive_desc(
+                    &adesc.data, &attr, aengine, nullptr, allow_empty) {}
+
         /// Constructs a primitive descriptor for a matmul primitive from a C
         /// API primitive descriptor that must have a matching kind.
         ///
@@ -10468,6 +10692,13 @@ struct matmul : public primitive {
 
         /// @copydoc dnnl::primitive_desc_base::dst_desc()const
         memory::desc dst_desc() const { return query_md(query::dst_md, 0); }
+
+        /// Returns the group offsets memory descriptor.
+        /// @returns Group offsets memory descriptor.
+        /// @returns A zero memory descriptor if the primitive is not grouped.
+        memory::desc group_offsets_desc() const {
+            return query_md(query::exec_arg_md, DNNL_ARG_GROUP_OFFSETS);
+        }
     };
 
     /// Default constructor. Produces an empty object.
@@ -11338,6 +11569,16 @@ inline status set_verbose(int level) {
     return static_cast<status>(dnnl_set_verbose(level));
 }
 
+/// @copydoc dnnl_set_trace_file()
+inline status set_trace_file(const std::string &path) {
+    return static_cast<status>(dnnl_set_trace_file(path.c_str()));
+}
+
+/// @copydoc dnnl_flush_trace()
+inline status flush_trace() {
+    return static_cast<status>(dnnl_flush_trace());
+}
+
 /// @copydoc dnnl_version()
 inline const version_t *version() {
     return dnnl_version();
@@ -11362,6 +11603,21 @@ inline status set_jit_dump(int enable) {
     return static_cast<status>(dnnl_set_jit_dump(enable));
 }
 
+/// Scratchpad pool statistics.
+using scratchpad_pool_stats = dnnl_scratchpad_pool_stats_t;
+
+/// Returns statistics of the scratchpad pool. The pool is enabled with the
+/// DNNL_SCRATCHPAD_POOL environment variable, all statistics are zero
+/// otherwise.
+///
+/// @returns Scratchpad pool statistics.
+inline scratchpad_pool_stats get_scratchpad_pool_stats() {
+    scratchpad_pool_stats result;
+    error::wrap_c_api(dnnl_get_scratchpad_pool_stats(&result),
+            "could not get scratchpad pool statistics");
+    return result;
+}
+
 /// @copydoc dnnl_set_jit_profiling_flags()
 inline status set_jit_profiling_flags(unsigned flags) {
     return static_cast<status>(dnnl_set_jit_profiling_flags(flags));
@@ -11428,6 +11684,37 @@ inline cpu_isa_hints get_cpu_isa_hints() {
     return static_cast<cpu_isa_hints>(dnnl_get_cpu_isa_hints());
 }
 
+/// @copydoc dnnl_cpu_hugepages_mode_t
+enum class cpu_hugepages_mode {
+    /// @copydoc dnnl_cpu_hugepages_none
+    none = dnnl_cpu_hugepages_none,
+    /// @copydoc dnnl_cpu_hugepages_thp
+    thp = dnnl_cpu_hugepages_thp,
+    /// @copydoc dnnl_cpu_hugepages_hugetlb
+    hugetlb = dnnl_cpu_hugepages_hugetlb,
+};
+
+/// @copydoc dnnl_set_cpu_hugepages_mode()
+inline status set_cpu_hugepages_mode(cpu_hugepages_mode mode) {
+    return static_cast<status>(dnnl_set_cpu_hugepages_mode(
+            static_cast<dnnl_cpu_hugepages_mode_t>(mode)));
+}
+
+/// @copydoc dnnl_get_cpu_hugepages_mode()
+inline cpu_hugepages_mode get_cpu_hugepages_mode() {
+    return static_cast<cpu_hugepages_mode>(dnnl_get_cpu_hugepages_mode());
+}
+
+/// @copydoc dnnl_set_max_threads_limit()
+inline status set_max_threads_limit(int max_threads) {
+    return static_cast<status>(dnnl_set_max_threads_limit(max_threads));
+}
+
+/// @copydoc dnnl_get_max_threads_limit()
+inline int get_max_threads_limit() {
+    return dnnl_get_max_threads_limit();
+}
+
 /// @} dnnl_api_service
 
 /// @addtogroup dnnl_api_primitive_cache Primitive Cache
@@ -11451,6 +11738,92 @@ inline void set_primitive_cache_capacity(int capacity) {
             "could not set primitive cache capacity");
 }
 
+/// Returns the limit of the total footprint of the primitives held in the
+/// primitive cache in bytes.
+inline size_t get_primitive_cache_capacity_bytes() {
+    size_t result = 0;
+    error::wrap_c_api(dnnl_get_primitive_cache_capacity_bytes(&result),
+            "could not get primitive cache capacity in bytes");
+    return result;
+}
+
+/// @copydoc dnnl_set_primitive_cache_capacity_bytes(size_t capacity)
+inline void set_primitive_cache_capacity_bytes(size_t capacity) {
+    error::wrap_c_api(dnnl_set_primitive_cache_capacity_bytes(capacity),
+            "could not set primitive cache capacity in bytes");
+}
+
+/// Returns the number of primitives held in the primitive cache.
+inline int get_primitive_cache_usage_entries() {
+    int result = 0;
+    error::wrap_c_api(dnnl_get_primitive_cache_usage(&result, nullptr),
+            "could not get primitive cache usage");
+    return result;
+}
+
+/// Returns the total estimated footprint of the primitives held in the
+/// primitive cache in bytes.
+inline size_t get_primitive_cache_usage_bytes() {
+    size_t result = 0;
+    error::wrap_c_api(dnnl_get_primitive_cache_usage(nullptr, &result),
+            "could not get primitive cache usage");
+    return result;
+}
+
+/// @copydoc dnnl_export_primitive_cache(const char *path)
+inline void export_primitive_cache(const std::string &path) {
+    error::wrap_c_api(dnnl_export_primitive_cache(path.c_str()),
+            "could not export primitive cache");
+}
+
+/// Re-creates the primitives listed in a file written by
+/// #dnnl::export_primitive_cache() and puts them into the primitive cache.
+///
+/// @param aengine Engine to create the primitives for.
+/// @param path Path of the file to read.
+/// @returns The number of imported primitives.
+inline int import_primitive_cache(
+        const engine &aengine, const std::string &path) {
+    int result = 0;
+    error::wrap_c_api(
+            dnnl_import_primitive_cache(aengine.get(), path.c_str(), &result),
+            "could not import primitive cache");
+    return result;
+}
+
+/// Returns the number of primitive creation requests that were served by
+/// imported primitives instead of generating code.
+inline size_t get_primitive_cache_persistent_hits() {
+    size_t result = 0;
+    error::wrap_c_api(dnnl_get_primitive_cache_persistent_hits(&result),
+            "could not get primitive cache persistent hits");
+    return result;
+}
+
+/// Primitive cache statistics.
+using primitive_cache_stats = dnnl_primitive_cache_stats_t;
+
+/// Returns primitive cache statistics.
+///
+/// @param akind Primitive kind to return the statistics for. Statistics of
+///     all primitive kinds are summed up if @p akind is
+///     #dnnl::primitive::kind::undef.
+/// @returns Primitive cache statistics.
+inline primitive_cache_stats get_primitive_cache_stats(
+        primitive::kind akind = primitive::kind::undef) {
+    primitive_cache_stats result;
+    error::wrap_c_api(
+            dnnl_primitive_cache_get_stats(convert_to_c(akind), &result),
+            "could not get primitive cache statistics");
+    return result;
+}
+
+/// @copydoc dnnl_primitive_cache_reset_stats()
+inline void reset_primitive_cache_stats() {
+    error::wrap_c_api(dnnl_primitive_cache_reset_stats(),
+            "could not reset primitive cache statistics");
+}
+
 /// @} dnnl_api_primitive_cache
 
 /// @addtogroup dnnl_api_blas BLAS functions
@@ -11500,6 +11873,13 @@ inline primitive::primitive(const_dnnl_primitive_desc_t c_pd) {
 
 inline primitive::primitive(const primitive_desc &pd) : primitive(pd.get()) {}
 
+inline primitive_future::primitive_future(const primitive_desc &pd) {
+    dnnl_primitive_future_t result;
+    error::wrap_c_api(dnnl_primitive_create_async(&result, pd.get()),
+            "could not start creating a primitive");
+    reset(result);
+}
+
 inline void primitive::execute(const stream &astream,
         const std::unordered_map<int, memory> &args) const {
     std::vector<dnnl_exec_arg_t> c_args;
@@ -1386,6 +1386,9 @@ typedef enum {
     dnnl_reduction,
     /// A PReLU primitive.
     dnnl_prelu,
+    /// A grouped matrix multiplication operation descriptor. The primitive
+    /// created from it is a #dnnl_matmul primitive.
+    dnnl_matmul_grouped,
 
     /// Parameter to allow internal only primitives without undefined behavior.
     /// This parameter is chosen to be valid for so long as sizeof(int) >= 2.
@@ -2400,6 +2403,32 @@ typedef struct {
     dnnl_data_type_t accum_data_type;
 } dnnl_matmul_desc_t;
 
+/// A descriptor of a grouped matrix multiplication operation. The rows of the
+/// source and destination matrices are split into groups, and each group is
+/// multiplied by its own weights matrix:
+///     dst[m, n] = src[m, k] * weights[g, k, n] + bias[g, 0, n],
+///     where g is such that group_offsets[g] <= m < group_offsets[g + 1]
+///
+/// The first members are the same as the members of #dnnl_matmul_desc_t. The
+/// primitive created from the descriptor is a #dnnl_matmul primitive.
+typedef struct {
+    /// The kind of primitive. Used for self-identifying the primitive
+    /// descriptor. Must be #dnnl_matmul_grouped.
+    dnnl_primitive_kind_t primitive_kind;
+    /// Source memory descriptor.
+    dnnl_memory_desc_t src_desc;
+    /// Weights memory descriptor.
+    dnnl_memory_desc_t weights_desc;
+    /// Bias memory descriptor.
+    dnnl_memory_desc_t bias_desc;
+    /// Destination memory descriptor.
+    dnnl_memory_desc_t dst_desc;
+    /// The accumulator data type. Initialized automatically.
+    dnnl_data_type_t accum_data_type;
+    /// Group offsets memory descriptor.
+    dnnl_memory_desc_t group_offsets_desc;
+} dnnl_matmul_grouped_desc_t;
+
 /// @} dnnl_api_matmul
 
 /// @addtogroup dnnl_api_resampling
@@ -2490,6 +2519,32 @@ typedef struct dnnl_engine *dnnl_engine_t;
 typedef const struct dnnl_engine *const_dnnl_engine_t;
 #endif
 
+/// @brief Usage hints of the buffers allocated through a user allocator.
+typedef enum {
+    /// Buffer of a memory object allocated by the library.
+    dnnl_allocation_usage_memory = 1,
+    /// Scratchpad of a primitive.
+    dnnl_allocation_usage_scratchpad = 2,
+} dnnl_allocation_usage_t;
+
+/// @brief A user function that allocates engine memory.
+///
+/// @param size Size of the buffer in bytes.
+/// @param alignment Required alignment of the buffer in bytes.
+/// @param usage Usage hint of the buffer.
+/// @param context User context passed at engine creation.
+/// @returns Pointer to the allocated buffer or NULL on failure.
+typedef void *(*dnnl_allocator_alloc_f)(size_t size, size_t alignment,
+        dnnl_allocation_usage_t usage, void *context);
+
+/// @brief A user function that frees engine memory.
+///
+/// @param ptr Buffer returned by the corresponding allocation function.
+/// @param usage Usage hint passed at the buffer allocation.
+/// @param context User context passed at engine creation.
+typedef void (*dnnl_allocator_free_f)(
+        void *ptr, dnnl_allocation_usage_t usage, void *context);
+
 /// @} dnnl_api_engine
 
 /// @addtogroup dnnl_api_primitives
@@ -2614,6 +2669,15 @@ typedef struct dnnl_primitive *dnnl_primitive_t;
 /// A constant primitive handle.
 typedef const struct dnnl_primitive *const_dnnl_primitive_t;
 
+/// @struct dnnl_primitive_future
+/// An opaque structure to describe a primitive being created in the
+/// background.
+struct dnnl_primitive_future;
+/// A primitive future handle.
+typedef struct dnnl_primitive_future *dnnl_primitive_future_t;
+/// A constant primitive future handle.
+typedef const struct dnnl_primitive_future *const_dnnl_primitive_future_t;
+
 /// Source argument #0.
 #define DNNL_ARG_SRC_0 1
 /// A special mnemonic for source argument for primitives that have a
@@ -2704,6 +2768,9 @@ typedef const struct dnnl_primitive *const_dnnl_primitive_t;
 /// A special mnemonic for shift argument of normalization primitives.
 #define DNNL_ARG_SHIFT 52
 
+/// Group offsets argument of grouped matrix multiplication.
+#define DNNL_ARG_GROUP_OFFSETS 53
+
 /// Workspace tensor argument. Workspace is used to pass information
 /// from forward propagation to backward propagation computations.
 #define DNNL_ARG_WORKSPACE 64
@@ -2906,6 +2973,7 @@ typedef enum {
     dnnl_query_pooling_v2_d, ///< pooling version 2 descriptor
     dnnl_query_reduction_d, ///< reduction descriptor
     dnnl_query_prelu_d, ///< prelu descriptor
+    dnnl_query_matmul_grouped_d, ///< grouped matmul descriptor
 
     // memory descriptor section
     dnnl_query_some_md = 128, ///< stub
@@ -2968,6 +3036,9 @@ typedef const struct dnnl_stream *const_dnnl_stream_t;
 /// Threadpool runtime (CPU only)
 #define DNNL_RUNTIME_THREADPOOL 8u
 
+/// Built-in work-stealing runtime (CPU only)
+#define DNNL_RUNTIME_WORK_STEALING 16u
+
 /// OpenCL runtime
 #define DNNL_RUNTIME_OCL 256u
 
@@ -3063,8 +3134,60 @@ typedef enum {
     dnnl_cpu_isa_prefer_ymm = 0x1,
 } dnnl_cpu_isa_hints_t;
 
+/// Huge pages modes for large buffers allocated by the library on CPU
+typedef enum {
+    /// Use the default page size
+    dnnl_cpu_hugepages_none = 0x0,
+
+    /// Align buffers to the huge page size and advise the kernel to back
+    /// them with transparent huge pages
+    dnnl_cpu_hugepages_thp = 0x1,
+
+    /// Allocate buffers from the hugetlbfs pool and fall back to
+    /// transparent huge pages if the pool is exhausted
+    dnnl_cpu_hugepages_hugetlb = 0x2,
+} dnnl_cpu_hugepages_mode_t;
+
+/// Scratchpad pool statistics. All sizes are in bytes.
+typedef struct {
+    /// Size of the buffers currently used by executing primitives.
+    size_t in_use;
+    /// High-water mark of @p in_use.
+    size_t peak_in_use;
+    /// Size of the buffers kept in the pool for reuse.
+    size_t cached;
+    /// High-water mark of the sum of @p in_use and @p cached.
+    size_t peak_total;
+    /// Number of buffers allocated by the pool.
+    size_t n_allocations;
+    /// Number of executions that reused a buffer from the pool.
+    size_t n_reuses;
+} dnnl_scratchpad_pool_stats_t;
+
 /// @} dnnl_api_service
 
+/// @addtogroup dnnl_api_primitive_cache
+/// @{
+
+/// Primitive cache statistics. The counters are accumulated from the library
+/// load or from the last call to #dnnl_primitive_cache_reset_stats().
+typedef struct {
+    /// Number of primitive creation requests served from the cache.
+    size_t hits;
+    /// Number of primitive creation requests that created a new primitive.
+    size_t misses;
+    /// Number of primitives evicted from the cache to keep it within the
+    /// capacity.
+    size_t evictions;
+    /// Number of hits that had to wait for the primitive being created by
+    /// another thread.
+    size_t in_flight_waits;
+    /// Total time spent creating new primitives, in milliseconds.
+    double creation_time_ms;
+} dnnl_primitive_cache_stats_t;
+
+/// @} dnnl_api_primitive_cache
+
 /// @} dnnl_api
 
 #ifdef __cplusplus
@@ -26,6 +26,7 @@
 // to give names that better reflects the meaning of the entities
 using primitive_iface_t = dnnl_primitive;
 using primitive_desc_iface_t = dnnl_primitive_desc;
+using primitive_future_t = dnnl_primitive_future;
 
 namespace dnnl {
 namespace impl {
@@ -1192,6 +1193,7 @@ enum runtime_kind_t {
     dnnl_runtime_omp,
     dnnl_runtime_tbb,
     dnnl_runtime_threadpool,
+    dnnl_runtime_work_stealing,
     dnnl_runtime_ocl,
     dnnl_runtime_sycl,
 };
@@ -1202,6 +1204,7 @@ const runtime_kind_t seq = dnnl_runtime_seq;
 const runtime_kind_t omp = dnnl_runtime_omp;
 const runtime_kind_t tbb = dnnl_runtime_tbb;
 const runtime_kind_t threadpool = dnnl_runtime_threadpool;
+const runtime_kind_t work_stealing = dnnl_runtime_work_stealing;
 const runtime_kind_t ocl = dnnl_runtime_ocl;
 const runtime_kind_t sycl = dnnl_runtime_sycl;
 } // namespace runtime_kind
@@ -1229,6 +1232,7 @@ const primitive_kind_t gemm = dnnl_gemm;
 const primitive_kind_t binary = dnnl_binary;
 const primitive_kind_t logsoftmax = dnnl_logsoftmax;
 const primitive_kind_t matmul = dnnl_matmul;
+const primitive_kind_t matmul_grouped = dnnl_matmul_grouped;
 const primitive_kind_t resampling = dnnl_resampling;
 const primitive_kind_t reduction = dnnl_reduction;
 
@@ -1269,6 +1273,7 @@ const query_t softmax_d = dnnl_query_softmax_d;
 const query_t pooling_d = dnnl_query_pooling_d;
 const query_t pooling_v2_d = dnnl_query_pooling_v2_d;
 const query_t prelu_d = dnnl_query_prelu_d;
+const query_t matmul_grouped_d = dnnl_query_matmul_grouped_d;
 const query_t lrn_d = dnnl_query_lrn_d;
 const query_t batch_normalization_d = dnnl_query_batch_normalization_d;
 const query_t layer_normalization_d = dnnl_query_layer_normalization_d;
@@ -1318,6 +1323,7 @@ using inner_product_desc_t = dnnl_inner_product_desc_t;
 using binary_desc_t = dnnl_binary_desc_t;
 using logsoftmax_desc_t = dnnl_logsoftmax_desc_t;
 using matmul_desc_t = dnnl_matmul_desc_t;
+using matmul_grouped_desc_t = dnnl_matmul_grouped_desc_t;
 using resampling_desc_t = dnnl_resampling_desc_t;
 using reduction_desc_t = dnnl_reduction_desc_t;
 
@@ -1358,6 +1364,7 @@ struct op_desc_t {
         sum_desc_t sum;
         binary_desc_t binary;
         matmul_desc_t matmul;
+        matmul_grouped_desc_t matmul_grouped;
         resampling_desc_t resampling;
         zero_pad_desc_t zero_pad;
         reduction_desc_t reduction;
@@ -1389,6 +1396,7 @@ struct op_desc_t {
     DECL_CTOR_AND_CONVERTERS(sum_desc_t);
     DECL_CTOR_AND_CONVERTERS(binary_desc_t);
     DECL_CTOR_AND_CONVERTERS(matmul_desc_t);
+    DECL_CTOR_AND_CONVERTERS(matmul_grouped_desc_t);
     DECL_CTOR_AND_CONVERTERS(resampling_desc_t);
     DECL_CTOR_AND_CONVERTERS(zero_pad_desc_t);
     DECL_CTOR_AND_CONVERTERS(reduction_desc_t);
@@ -14,7 +14,13 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <chrono>
 #include <functional>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
 
 #include "dnnl_thread.hpp"
 
@@ -24,6 +30,8 @@
 
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
 #include "counting_barrier.hpp"
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_WORK_STEALING
+#include "work_stealing_pool.hpp"
 #endif
 
 namespace dnnl {
@@ -38,8 +46,142 @@ static int adjust_num_threads(int nthr, dim_t work_amount) {
 #endif
 }
 
-void parallel(int nthr, const std::function<void(int, int)> &f) {
-    nthr = adjust_num_threads(nthr, INT64_MAX);
+namespace {
+// The statistics are reported with the verbose output only, so builds
+// without it do not pay for the accounting in for_nd().
+#if !defined(DISABLE_VERBOSE)
+// The statistics collected for parallel regions started from the thread.
+thread_local parallel_stats_t *current_parallel_stats = nullptr;
+// The counter of work items processed by the thread in the current parallel
+// region.
+thread_local dim_t *current_work_items = nullptr;
+
+inline void count_work_items(dim_t start, dim_t end) {
+    if (current_work_items) *current_work_items += end - start;
+}
+#else
+inline void count_work_items(dim_t start, dim_t end) {}
+#endif
+
+// The affinity of parallel regions started from the thread.
+thread_local const cpu_affinity_t *current_cpu_affinity = nullptr;
+
+// The limit on the number of threads or 0.
+thread_local int current_max_threads_limit = 0;
+
+// Binds the calling thread to the core of the thread `ithr` or to all the
+// cores of an affinity for the lifetime of the object. The original binding
+// is restored on destruction, so the application thread and the threads of
+// the runtime are not left bound after the region. A null affinity does not
+// change the binding.
+struct scoped_thread_binding_t {
+    scoped_thread_binding_t(const cpu_affinity_t *affinity, int ithr) {
+#if defined(__linux__)
+        if (!affinity) return;
+        const auto &cores = affinity->cores();
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+        const int core = cores[ithr % cores.size()];
+#else
+        MAYBE_UNUSED(ithr);
+        const int core = -1;
+#endif
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (core >= 0)
+            CPU_SET(core, &set);
+        else
+            for (int c : cores)
+                CPU_SET(c, &set);
+
+        if (sched_getaffinity(0, sizeof(prev_set_), &prev_set_) != 0) return;
+        if (CPU_EQUAL(&set, &prev_set_)) return;
+        // A core the process is not allowed to run on is a user error that
+        // does not affect the results, so the failure is ignored.
+        is_bound_ = sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+        MAYBE_UNUSED(affinity);
+        MAYBE_UNUSED(ithr);
+#endif
+    }
+
+    ~scoped_thread_binding_t() {
+#if defined(__linux__)
+        if (is_bound_) sched_setaffinity(0, sizeof(prev_set_), &prev_set_);
+#endif
+    }
+
+private:
+#if defined(__linux__)
+    cpu_set_t prev_set_;
+    bool is_bound_ = false;
+#endif
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(scoped_thread_binding_t);
+};
+} // namespace
+
+cpu_affinity_t::cpu_affinity_t(const std::vector<int> &cores, int numa_node)
+    : cores_(cores), numa_node_(numa_node) {}
+
+bool is_cpu_affinity_supported() {
+#if defined(__linux__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void set_cpu_affinity(const cpu_affinity_t *affinity) {
+    current_cpu_affinity = affinity;
+}
+
+int get_max_threads_limit() {
+    return current_max_threads_limit;
+}
+
+void set_max_threads_limit(int nthr) {
+    current_max_threads_limit = nstl::max(0, nthr);
+}
+
+void parallel_stats_t::add_region(
+        int nthr, const double *busy_ms, const dim_t *items) {
+    double max_busy = 0, sum_busy = 0;
+    dim_t max_work = 0, sum_work = 0;
+    for (int ithr = 0; ithr < nthr; ithr++) {
+        max_busy = std::max(max_busy, busy_ms[ithr]);
+        sum_busy += busy_ms[ithr];
+        max_work = std::max(max_work, items[ithr]);
+        sum_work += items[ithr];
+    }
+    n_regions++;
+    max_nthr = std::max(max_nthr, nthr);
+    max_busy_ms += max_busy;
+    avg_busy_ms += sum_busy / nthr;
+    max_items += (double)max_work;
+    avg_items += (double)sum_work / nthr;
+}
+
+bool is_parallel_stats_enabled() {
+#if !defined(DISABLE_VERBOSE)
+    static const bool enabled
+            = getenv_int("DNNL_VERBOSE_PARALLEL_STATS", 0) != 0;
+    return enabled;
+#else
+    return false;
+#endif
+}
+
+status_t set_parallel_stats(parallel_stats_t *stats) {
+#if !defined(DISABLE_VERBOSE)
+    current_parallel_stats = stats;
+    return status::success;
+#else
+    MAYBE_UNUSED(stats);
+    return status::unimplemented;
+#endif
+}
+
+static void parallel_impl(int nthr, const std::function<void(int, int)> &f) {
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_SEQ
     assert(nthr == 1);
     f(0, 1);
@@ -82,6 +224,19 @@ void parallel(int nthr, const std::function<void(int, int)> &f) {
 #endif
             },
             tbb::static_partitioner());
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_WORK_STEALING
+#if defined(DNNL_ENABLE_ITT_TASKS)
+    work_stealing::pool_t::get().parallel(nthr, [&](int ithr, int nthr) {
+        bool mark_task = itt::primitive_task_get_current_kind()
+                == primitive_kind::undefined;
+        if (mark_task && itt_enable)
+            itt::primitive_task_start(task_primitive_kind);
+        f(ithr, nthr);
+        if (mark_task && itt_enable) itt::primitive_task_end();
+    });
+#else
+    work_stealing::pool_t::get().parallel(nthr, f);
+#endif
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
     using namespace dnnl::impl::threadpool_utils;
     dnnl::threadpool_interop::threadpool_iface *tp = get_active_threadpool();
@@ -119,6 +274,56 @@ void parallel(int nthr, const std::function<void(int, int)> &f) {
 #endif
 }
 
+void parallel(int nthr, const std::function<void(int, int)> &f_) {
+    nthr = adjust_num_threads(nthr, INT64_MAX);
+
+    // Nested regions run on the threads that are already bound and already
+    // have the limit.
+    const bool is_outermost = !dnnl_in_parallel();
+    const cpu_affinity_t *affinity = current_cpu_affinity;
+    const bool bind = is_outermost && affinity && affinity->is_set();
+    const int max_threads_limit = current_max_threads_limit;
+    const bool pass_limit = is_outermost && nthr > 1 && max_threads_limit > 0;
+    std::function<void(int, int)> wrapped_f;
+    if (bind || pass_limit)
+        wrapped_f = [&](int ithr, int nthr) {
+            scoped_thread_binding_t binding(bind ? affinity : nullptr, ithr);
+            const int prev_limit = current_max_threads_limit;
+            current_max_threads_limit = max_threads_limit;
+            f_(ithr, nthr);
+            current_max_threads_limit = prev_limit;
+        };
+    const std::function<void(int, int)> &f
+            = (bind || pass_limit) ? wrapped_f : f_;
+
+#if !defined(DISABLE_VERBOSE)
+    parallel_stats_t *stats = is_outermost ? current_parallel_stats : nullptr;
+#else
+    parallel_stats_t *stats = nullptr;
+#endif
+    if (stats == nullptr) {
+        parallel_impl(nthr, f);
+        return;
+    }
+
+    std::vector<double> busy_ms(nthr, 0);
+    std::vector<dim_t> items(nthr, 0);
+#if !defined(DISABLE_VERBOSE)
+    parallel_impl(nthr, [&](int ithr, int nthr) {
+        using namespace std::chrono;
+        const auto start = steady_clock::now();
+        dim_t *prev_work_items = current_work_items;
+        current_work_items = &items[ithr];
+        f(ithr, nthr);
+        current_work_items = prev_work_items;
+        busy_ms[ithr] = duration<double, std::milli>(
+                steady_clock::now() - start)
+                                .count();
+    });
+#endif
+    stats->add_region(nthr, busy_ms.data(), items.data());
+}
+
 using F_1D_t = std::function<void(dim_t)>;
 using F_2D_t = std::function<void(dim_t, dim_t)>;
 using F_3D_t = std::function<void(dim_t, dim_t, dim_t)>;
@@ -138,6 +343,7 @@ using F_6D_thr_t = std::function<void(
 void for_nd(const int ithr, const int nthr, dim_t D0, const F_1D_t &f) {
     dim_t start {0}, end {0};
     balance211(D0, nthr, ithr, start, end);
+    count_work_items(start, end);
     for (dim_t d0 = start; d0 < end; ++d0)
         f(d0);
 }
@@ -148,6 +354,7 @@ void for_nd(
     if (work_amount == 0) return;
     dim_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    count_work_items(start, end);
 
     dim_t d0 {0}, d1 {0};
     utils::nd_iterator_init(start, d0, D0, d1, D1);
@@ -163,6 +370,7 @@ void for_nd(const int ithr, const int nthr, dim_t D0, dim_t D1, dim_t D2,
     if (work_amount == 0) return;
     dim_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    count_work_items(start, end);
 
     dim_t d0 {0}, d1 {0}, d2 {0};
     utils::nd_iterator_init(start, d0, D0, d1, D1, d2, D2);
@@ -178,6 +386,7 @@ void for_nd(const int ithr, const int nthr, dim_t D0, dim_t D1, dim_t D2,
     if (work_amount == 0) return;
     dim_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    count_work_items(start, end);
 
     dim_t d0 {0}, d1 {0}, d2 {0}, d3 {0};
     utils::nd_iterator_init(start, d0, D0, d1, D1, d2, D2, d3, D3);
@@ -193,6 +402,7 @@ void for_nd(const int ithr, const int nthr, dim_t D0, dim_t D1, dim_t D2,
     if (work_amount == 0) return;
     dim_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    count_work_items(start, end);
 
     dim_t d0 {0}, d1 {0}, d2 {0}, d3 {0}, d4 {0};
     utils::nd_iterator_init(start, d0, D0, d1, D1, d2, D2, d3, D3, d4, D4);
@@ -208,6 +418,7 @@ void for_nd(const int ithr, const int nthr, dim_t D0, dim_t D1, dim_t D2,
     if (work_amount == 0) return;
     dim_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    count_work_items(start, end);
 
     dim_t d0 {0}, d1 {0}, d2 {0}, d3 {0}, d4 {0}, d5 {0};
     utils::nd_iterator_init(
@@ -223,6 +434,7 @@ void for_nd(const int ithr, const int nthr, dim_t D0, dim_t D1, dim_t D2,
 void for_nd_ext(const int ithr, const int nthr, dim_t D0, const F_1D_thr_t &f) {
     dim_t start {0}, end {0};
     balance211(D0, nthr, ithr, start, end);
+    count_work_items(start, end);
     for (dim_t d0 = start; d0 < end; ++d0)
         f(ithr, nthr, d0);
 }
@@ -233,6 +445,7 @@ void for_nd_ext(const int ithr, const int nthr, dim_t D0, dim_t D1,
     if (work_amount == 0) return;
     dim_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    count_work_items(start, end);
 
     dim_t d0 {0}, d1 {0};
     utils::nd_iterator_init(start, d0, D0, d1, D1);
@@ -248,6 +461,7 @@ void for_nd_ext(const int ithr, const int nthr, dim_t D0, dim_t D1, dim_t D2,
     if (work_amount == 0) return;
     dim_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    count_work_items(start, end);
 
     dim_t d0 {0}, d1 {0}, d2 {0};
     utils::nd_iterator_init(start, d0, D0, d1, D1, d2, D2);
@@ -263,6 +477,7 @@ void for_nd_ext(const int ithr, const int nthr, dim_t D0, dim_t D1, dim_t D2,
     if (work_amount == 0) return;
     dim_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    count_work_items(start, end);
 
     dim_t d0 {0}, d1 {0}, d2 {0}, d3 {0};
     utils::nd_iterator_init(start, d0, D0, d1, D1, d2, D2, d3, D3);
@@ -278,6 +493,7 @@ void for_nd_ext(const int ithr, const int nthr, dim_t D0, dim_t D1, dim_t D2,
     if (work_amount == 0) return;
     dim_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    count_work_items(start, end);
 
     dim_t d0 {0}, d1 {0}, d2 {0}, d3 {0}, d4 {0};
     utils::nd_iterator_init(start, d0, D0, d1, D1, d2, D2, d3, D3, d4, D4);
@@ -293,6 +509,7 @@ void for_nd_ext(const int ithr, const int nthr, dim_t D0, dim_t D1, dim_t D2,
     if (work_amount == 0) return;
     dim_t start {0}, end {0};
     balance211(work_amount, nthr, ithr, start, end);
+    count_work_items(start, end);
 
     dim_t d0 {0}, d1 {0}, d2 {0}, d3 {0}, d4 {0}, d5 {0};
     utils::nd_iterator_init(
@@ -20,10 +20,26 @@
 #include <algorithm>
 #include <functional>
 #include <mutex>
+#include <vector>
 
 #include "utils.hpp"
 #include "z_magic.hpp"
 
+namespace dnnl {
+namespace impl {
+
+// Returns the limit on the number of threads set for the calling thread (see
+// set_max_threads_limit()) or 0 if there is no limit.
+int DNNL_API get_max_threads_limit();
+
+inline int apply_max_threads_limit(int nthr) {
+    const int limit = get_max_threads_limit();
+    return limit > 0 && limit < nthr ? limit : nthr;
+}
+
+} // namespace impl
+} // namespace dnnl
+
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_SEQ
 #define DNNL_THR_SYNC 1
 inline int dnnl_get_max_threads() {
@@ -38,7 +54,7 @@ inline void dnnl_thr_barrier() {}
 #include "omp.h"
 #define DNNL_THR_SYNC 1
 inline int dnnl_get_max_threads() {
-    return omp_get_max_threads();
+    return dnnl::impl::apply_max_threads_limit(omp_get_max_threads());
 }
 inline int dnnl_in_parallel() {
     return omp_in_parallel();
@@ -52,7 +68,8 @@ inline void dnnl_thr_barrier() {
 #include "tbb/task_arena.h"
 #define DNNL_THR_SYNC 0
 inline int dnnl_get_max_threads() {
-    return tbb::this_task_arena::max_concurrency();
+    return dnnl::impl::apply_max_threads_limit(
+            tbb::this_task_arena::max_concurrency());
 }
 inline int dnnl_in_parallel() {
     return 0;
@@ -61,6 +78,31 @@ inline void dnnl_thr_barrier() {
     assert(!"no barrier in TBB");
 }
 
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_WORK_STEALING
+#define DNNL_THR_SYNC 0
+
+namespace dnnl {
+namespace impl {
+namespace work_stealing {
+// Returns the number of threads of the pool including the calling thread.
+int DNNL_API get_num_threads();
+} // namespace work_stealing
+} // namespace impl
+} // namespace dnnl
+
+inline int dnnl_get_max_threads() {
+    return dnnl::impl::apply_max_threads_limit(
+            dnnl::impl::work_stealing::get_num_threads());
+}
+// Like with TBB, nested regions are supported: their tasks are pushed to the
+// deque of the worker and are stolen by the idle workers.
+inline int dnnl_in_parallel() {
+    return 0;
+}
+inline void dnnl_thr_barrier() {
+    assert(!"no barrier in the work-stealing runtime");
+}
+
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
 #include <thread>
 #include "oneapi/dnnl/dnnl_threadpool_iface.hpp"
@@ -111,8 +153,10 @@ inline int dnnl_get_max_threads() {
 
     // Use the default value if the threadpool-provided is outside the range
     // [1, def_max_threads]
-    return tp ? std::min(std::max(1, tp->get_num_threads()), def_max_threads)
-              : def_max_threads;
+    const int max_threads = tp
+            ? std::min(std::max(1, tp->get_num_threads()), def_max_threads)
+            : def_max_threads;
+    return dnnl::impl::apply_max_threads_limit(max_threads);
 }
 inline int dnnl_in_parallel() {
     using namespace dnnl::impl::threadpool_utils;
@@ -128,8 +172,10 @@ inline void dnnl_thr_barrier() {
  * is aware of when this function is invoked. Since oneDNN does not allow nested
  * parallelism, inside a parallel region the number of available threads is 1.
  * Otherwise, the number of current threads varies between threading runtimes:
- * - for OpenMP and TBB, return the max number of threads since the number of
- *   threads is held in a global object throughout the entire execution.
+ * - for OpenMP, TBB and the work-stealing runtime, return the max number of
+ *   threads since the number of threads is held in a global object
+ *   throughout the entire execution. The limit set for the calling thread
+ *   (e.g. by a stream) is applied.
  * - for Threadpool, since the global object in oneDNN changes throughout
  *   execution, two situations can occur:
  *   a) if the library *is* aware of a threadpool when this function is invoked,
@@ -139,10 +185,10 @@ inline void dnnl_thr_barrier() {
  */
 inline int dnnl_get_current_num_threads() {
     if (dnnl_in_parallel()) return 1;
-#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
-    return omp_get_max_threads();
-#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
-    return tbb::this_task_arena::max_concurrency();
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_WORK_STEALING
+    return dnnl_get_max_threads();
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
     using namespace dnnl::impl::threadpool_utils;
     dnnl::threadpool_interop::threadpool_iface *tp = get_active_threadpool();
@@ -256,6 +302,66 @@ void balance2D(U nthr, U ithr, T ny, T &ny_start, T &ny_end, T nx, T &nx_start,
 /* general parallelization */
 void DNNL_API parallel(int nthr, const std::function<void(int, int)> &f);
 
+// Work distribution statistics of the parallel regions started from a thread,
+// typically during a primitive execution. For each region the busy time of
+// the threads and the number of work items processed by them in for_nd()
+// calls are measured. The per-region maximum and average values are summed
+// over the regions, so the imbalance ratio shows how much longer the
+// execution takes compared to a perfectly balanced work distribution.
+struct parallel_stats_t {
+    int n_regions = 0;
+    int max_nthr = 0;
+    double max_busy_ms = 0;
+    double avg_busy_ms = 0;
+    double max_items = 0;
+    double avg_items = 0;
+
+    void add_region(int nthr, const double *busy_ms, const dim_t *items);
+    double imbalance() const {
+        return avg_busy_ms > 0 ? max_busy_ms / avg_busy_ms : 1.;
+    }
+};
+
+// Returns true if DNNL_VERBOSE_PARALLEL_STATS is set.
+bool is_parallel_stats_enabled();
+// Sets the object that collects the statistics of outermost parallel regions
+// started from the calling thread. Passing nullptr stops the collection.
+// Returns status::unimplemented if the library is built without verbose
+// support.
+status_t DNNL_API set_parallel_stats(parallel_stats_t *stats);
+
+// The cores the threads of parallel regions are bound to. With the OpenMP
+// runtime the thread `ithr` of a region is bound to the core
+// cores()[ithr % cores().size()]. Threads of other runtimes do not keep their
+// indices between regions, so each of them is bound to the whole set of
+// cores. The binding persists after the region ends.
+struct cpu_affinity_t {
+    cpu_affinity_t() = default;
+    // `numa_node` is the NUMA node all the cores belong to or -1.
+    cpu_affinity_t(const std::vector<int> &cores, int numa_node);
+
+    const std::vector<int> &cores() const { return cores_; }
+    int numa_node() const { return numa_node_; }
+    bool is_set() const { return !cores_.empty(); }
+
+private:
+    std::vector<int> cores_;
+    int numa_node_ = -1;
+};
+
+// Returns true if the threads can be bound to cores on this platform.
+bool is_cpu_affinity_supported();
+// Sets the affinity applied to the outermost parallel regions started from
+// the calling thread. Passing nullptr stops the binding.
+void set_cpu_affinity(const cpu_affinity_t *affinity);
+
+// Limits the number of threads returned by dnnl_get_max_threads() on the
+// calling thread, which sets both the blocking chosen at primitive creation
+// and the default width of parallel regions. The threads of the regions
+// started from the calling thread inherit the limit. Passing 0 removes the
+// limit.
+void set_max_threads_limit(int nthr);
+
 /* for_nd section */
 void for_nd(const int ithr, const int nthr, dim_t D0,
         const std::function<void(dim_t)> &f);
@@ -328,7 +434,8 @@ void parallel_nd_in_omp(Args &&... args) {
     for_nd(omp_get_thread_num(), omp_get_num_threads(),
             utils::forward<Args>(args)...);
 #elif (DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB \
-        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL)
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_WORK_STEALING)
     assert(!"parallel_nd_in_omp() is not supported by this DNNL_CPU_RUNTIME");
 #endif
 }
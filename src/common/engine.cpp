@@ -14,11 +14,14 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "oneapi/dnnl/dnnl.h"
 
 #include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
 #include "engine.hpp"
 #include "memory.hpp"
 #include "nstl.hpp"
@@ -85,6 +88,75 @@ status_t dnnl_engine_create(
     return ef->engine_create(engine, index);
 }
 
+status_t dnnl_engine_create_with_allocator(engine_t **engine,
+        engine_kind_t kind, size_t index, dnnl_allocator_alloc_f alloc,
+        dnnl_allocator_free_f free, void *context) {
+    if (any_null(engine, alloc, free)) return invalid_arguments;
+
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+    if (kind == engine_kind::cpu
+            && is_native_runtime(get_default_runtime(kind))) {
+        if (index >= cpu::cpu_engine_factory_t().count())
+            return invalid_arguments;
+        cpu::cpu_allocator_t allocator;
+        allocator.alloc = alloc;
+        allocator.free = free;
+        allocator.context = context;
+        *engine = new cpu::cpu_engine_t(allocator);
+        return success;
+    }
+#endif
+    MAYBE_UNUSED(index);
+    MAYBE_UNUSED(context);
+    return unimplemented;
+}
+
+status_t dnnl_engine_create_with_cpu_affinity(engine_t **engine,
+        engine_kind_t kind, size_t index, int ncores, const int *cores) {
+    if (any_null(engine, cores) || ncores <= 0) return invalid_arguments;
+
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+    if (kind == engine_kind::cpu
+            && is_native_runtime(get_default_runtime(kind))) {
+        if (index >= cpu::cpu_engine_factory_t().count())
+            return invalid_arguments;
+        if (!is_cpu_affinity_supported()) return unimplemented;
+        // The limit comes from the size of cpu_set_t.
+        const int max_cores = 1024;
+        for (int i = 0; i < ncores; i++)
+            if (cores[i] < 0 || cores[i] >= max_cores)
+                return invalid_arguments;
+        const std::vector<int> core_list(cores, cores + ncores);
+        const cpu_affinity_t affinity(
+                core_list, cpu::platform::get_numa_node(core_list));
+        *engine = new cpu::cpu_engine_t(cpu::cpu_allocator_t(), affinity);
+        return success;
+    }
+#endif
+    MAYBE_UNUSED(index);
+    return unimplemented;
+}
+
+status_t dnnl_get_numa_node_cores(
+        int numa_node, int *ncores, int *cores, int max_cores) {
+    if (ncores == nullptr || (cores != nullptr && max_cores < 0))
+        return invalid_arguments;
+    *ncores = 0;
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+    const auto node_cores = cpu::platform::get_numa_node_cores(numa_node);
+    if (cores != nullptr && (int)node_cores.size() > max_cores)
+        return invalid_arguments;
+    *ncores = (int)node_cores.size();
+    if (cores != nullptr)
+        std::copy(node_cores.begin(), node_cores.end(), cores);
+#else
+    MAYBE_UNUSED(numa_node);
+    MAYBE_UNUSED(cores);
+    MAYBE_UNUSED(max_cores);
+#endif
+    return success;
+}
+
 status_t dnnl_engine_get_kind(engine_t *engine, engine_kind_t *kind) {
     if (engine == nullptr) return invalid_arguments;
     *kind = engine->kind();
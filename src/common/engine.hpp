@@ -159,6 +159,8 @@ inline runtime_kind_t get_default_runtime(engine_kind_t kind) {
     return runtime_kind::tbb;
 #elif DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
     return runtime_kind::threadpool;
+#elif DNNL_CPU_RUNTIME == DNNL_RUNTIME_WORK_STEALING
+    return runtime_kind::work_stealing;
 #elif DNNL_CPU_RUNTIME == DNNL_RUNTIME_SYCL
     return runtime_kind::sycl;
 #else
@@ -175,6 +177,8 @@ inline runtime_kind_t get_cpu_native_runtime() {
     return runtime_kind::tbb;
 #elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
     return runtime_kind::threadpool;
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_WORK_STEALING
+    return runtime_kind::work_stealing;
 #else
     return runtime_kind::none;
 #endif
@@ -79,6 +79,7 @@ void primitive_task_start(primitive_kind_t kind) {
             CASE(pooling_v2),
             CASE(reduction),
             CASE(prelu),
+            CASE(matmul_grouped),
     };
 #undef CASE
     int kind_idx = (int)kind;
@@ -15,6 +15,7 @@
 *******************************************************************************/
 
 #include <assert.h>
+#include <stddef.h>
 
 #include "oneapi/dnnl/dnnl.h"
 
@@ -26,6 +27,16 @@ using namespace dnnl::impl;
 using namespace dnnl::impl::utils;
 using namespace dnnl::impl::types;
 
+namespace {
+data_type_t matmul_accum_data_type(
+        data_type_t src_dt, data_type_t wei_dt, data_type_t dst_dt) {
+    using namespace data_type;
+    // s8 weights are dequantized to f32 (weights-only quantization)
+    if (src_dt == f32 && wei_dt == s8 && dst_dt == f32) return f32;
+    return default_accum_data_type(src_dt, wei_dt, dst_dt, prop_kind::forward);
+}
+} // namespace
+
 status_t dnnl_matmul_desc_init(matmul_desc_t *matmul_desc,
         const memory_desc_t *src_md, const memory_desc_t *weights_md,
         const memory_desc_t *bias_md, const memory_desc_t *dst_md) {
@@ -83,8 +94,65 @@ status_t dnnl_matmul_desc_init(matmul_desc_t *matmul_desc,
         }
     }
 
-    op_d.accum_data_type = types::default_accum_data_type(src_md->data_type,
-            weights_md->data_type, dst_md->data_type, prop_kind::forward);
+    op_d.accum_data_type = matmul_accum_data_type(
+            src_md->data_type, weights_md->data_type, dst_md->data_type);
+    if (op_d.accum_data_type == data_type::undef)
+        return status::invalid_arguments;
+
+    *matmul_desc = op_d;
+    return status::success;
+}
+
+// The library keeps matmul descriptors in the grouped version, which must
+// extend the matmul one.
+static_assert(offsetof(matmul_grouped_desc_t, accum_data_type)
+                        == offsetof(matmul_desc_t, accum_data_type)
+                && offsetof(matmul_grouped_desc_t, group_offsets_desc)
+                        >= sizeof(matmul_desc_t),
+        "matmul_grouped_desc_t must start with the members of matmul_desc_t");
+
+status_t dnnl_matmul_grouped_desc_init(matmul_grouped_desc_t *matmul_desc,
+        const memory_desc_t *src_md, const memory_desc_t *weights_md,
+        const memory_desc_t *bias_md, const memory_desc_t *dst_md,
+        const memory_desc_t *group_offsets_md) {
+    bool args_ok = !any_null(
+            matmul_desc, src_md, weights_md, dst_md, group_offsets_md);
+    if (!args_ok) return status::invalid_arguments;
+
+    auto op_d = matmul_grouped_desc_t();
+    op_d.primitive_kind = primitive_kind::matmul_grouped;
+
+    op_d.src_desc = *src_md;
+    op_d.weights_desc = *weights_md;
+    if (bias_md) op_d.bias_desc = *bias_md;
+    op_d.dst_desc = *dst_md;
+    op_d.group_offsets_desc = *group_offsets_md;
+
+    const bool with_bias = op_d.bias_desc.ndims != 0;
+    bool ok = everyone_is(2, src_md->ndims, dst_md->ndims)
+            && weights_md->ndims == 3 && group_offsets_md->ndims == 1
+            && group_offsets_md->data_type == data_type::s32
+            && IMPLICATION(with_bias, op_d.bias_desc.ndims == 3);
+    if (!ok) return status::invalid_arguments;
+
+    // check: groups, m, n, k
+    const dim_t G = weights_md->dims[0];
+    const dim_t M = dst_md->dims[0];
+    const dim_t N = dst_md->dims[1];
+    ok = G > 0 && group_offsets_md->dims[0] == G + 1
+            && src_md->dims[0] == M
+            && IMPLICATION(M != DNNL_RUNTIME_DIM_VAL, M >= 0)
+            && weights_md->dims[2] == N
+            && src_md->dims[1] == weights_md->dims[1]
+            && !one_of(DNNL_RUNTIME_DIM_VAL, N, src_md->dims[1])
+            && IMPLICATION(with_bias,
+                    one_of(op_d.bias_desc.dims[0], 1, G)
+                            && op_d.bias_desc.dims[1] == 1
+                            && one_of(op_d.bias_desc.dims[2], 1, N));
+    if (!ok) return status::invalid_arguments;
+
+    op_d.accum_data_type = matmul_accum_data_type(
+            src_md->data_type, weights_md->data_type, dst_md->data_type);
     if (op_d.accum_data_type == data_type::undef)
         return status::invalid_arguments;
 
@@ -34,9 +34,11 @@ struct matmul_pd_t : public primitive_desc_t {
     typedef matmul_pd_t base_class;
     typedef matmul_pd_t hint_class;
 
-    const matmul_desc_t *desc() const { return &desc_; }
+    const matmul_desc_t *desc() const {
+        return reinterpret_cast<const matmul_desc_t *>(&desc_);
+    }
     const op_desc_t *op_desc() const override {
-        return reinterpret_cast<const op_desc_t *>(this->desc());
+        return reinterpret_cast<const op_desc_t *>(&desc_);
     }
 
     status_t query(query_t what, int idx, void *result) const override {
@@ -44,6 +46,10 @@ struct matmul_pd_t : public primitive_desc_t {
             case query::matmul_d:
                 *(const matmul_desc_t **)result = desc();
                 break;
+            case query::matmul_grouped_d:
+                if (!is_grouped()) return status::unimplemented;
+                *(const matmul_grouped_desc_t **)result = &desc_;
+                break;
             default: return primitive_desc_t::query(what, idx, result);
         }
         return status::success;
@@ -54,6 +60,9 @@ struct matmul_pd_t : public primitive_desc_t {
                 arg, DNNL_ARG_SRC, DNNL_ARG_WEIGHTS, DNNL_ARG_BIAS);
         if (input) return arg_usage_t::input;
 
+        if (arg == DNNL_ARG_GROUP_OFFSETS && is_grouped())
+            return arg_usage_t::input;
+
         if (arg == DNNL_ARG_DST) return arg_usage_t::output;
 
         return primitive_desc_t::arg_usage(arg);
@@ -65,6 +74,7 @@ struct matmul_pd_t : public primitive_desc_t {
             case DNNL_ARG_WEIGHTS: return weights_md(0);
             case DNNL_ARG_BIAS: return weights_md(1);
             case DNNL_ARG_DST: return dst_md(0);
+            case DNNL_ARG_GROUP_OFFSETS: return group_offsets_md();
             default: return primitive_desc_t::arg_md(arg);
         }
     }
@@ -81,8 +91,12 @@ struct matmul_pd_t : public primitive_desc_t {
         return index == 0 ? &dst_md_ : &glob_zero_md;
     }
 
+    const memory_desc_t *group_offsets_md() const {
+        return &group_offsets_md_;
+    }
+
     int n_inputs() const override {
-        return 2 + with_bias() + n_binary_po_inputs();
+        return 2 + with_bias() + is_grouped() + n_binary_po_inputs();
     }
     int n_outputs() const override { return 1; }
 
@@ -108,6 +122,13 @@ struct matmul_pd_t : public primitive_desc_t {
     bool with_bias() const { return bias_md_.ndims != 0; }
     bool batched() const { return ndims() > 2; }
 
+    // Grouped matmul multiplies contiguous groups of rows of a 2D source by
+    // their own weights matrices. The group boundaries are only known at
+    // execution time.
+    bool is_grouped() const { return group_offsets_md_.ndims != 0; }
+    // Number of groups
+    dim_t G() const { return is_grouped() ? weights_md_.dims[0] : 1; }
+
     dim_t batch() const {
         return utils::array_product(dst_md_.dims, ndims() - 2);
     }
@@ -119,7 +140,7 @@ struct matmul_pd_t : public primitive_desc_t {
         if (!with_bias()) return false;
 
         const auto &dims = weights_md(1)->dims;
-        const int n_dims = ndims();
+        const int n_dims = weights_md(1)->ndims;
         for (int i = 0; i < n_dims - 1; ++i) {
             if (dims[i] != 1) return false;
         }
@@ -127,26 +148,39 @@ struct matmul_pd_t : public primitive_desc_t {
         return dims[n_dims - 1] == N();
     }
 
+    // Grouped matmul only: a bias row per group.
+    bool is_bias_Gx1xN() const {
+        if (!with_bias() || !is_grouped()) return false;
+
+        const auto &dims = weights_md(1)->dims;
+        return dims[0] == G() && dims[1] == 1 && dims[2] == N();
+    }
+
 protected:
-    matmul_desc_t desc_;
+    // Grouped matmul descriptors start with the members of matmul ones, so
+    // the grouped version of the descriptor is kept for both.
+    matmul_grouped_desc_t desc_;
 
     memory_desc_t src_md_;
     memory_desc_t weights_md_;
     memory_desc_t bias_md_;
     memory_desc_t dst_md_;
+    memory_desc_t group_offsets_md_;
 
     matmul_pd_t(const matmul_desc_t *adesc, const primitive_attr_t *attr,
             const matmul_pd_t *hint_fwd_pd)
         : primitive_desc_t(attr, base_pkind)
-        , desc_(*adesc)
+        , desc_(cast_to_grouped(*adesc))
         , src_md_(desc_.src_desc)
         , weights_md_(desc_.weights_desc)
         , bias_md_(desc_.bias_desc)
-        , dst_md_(desc_.dst_desc) {}
+        , dst_md_(desc_.dst_desc)
+        , group_offsets_md_(desc_.group_offsets_desc) {}
 
     // temporary solution to deal with format `any`
     bool set_default_formats() {
-        for (auto md : {&src_md_, &weights_md_, &bias_md_, &dst_md_}) {
+        for (auto md : {&src_md_, &weights_md_, &bias_md_, &dst_md_,
+                     &group_offsets_md_}) {
             memory_desc_wrapper mdw(md);
             if (mdw.format_any()) {
                 if (mdw.has_runtime_dims_or_strides()) return false;
@@ -157,6 +191,21 @@ protected:
 
         return true;
     }
+
+private:
+    static matmul_grouped_desc_t cast_to_grouped(const matmul_desc_t &desc) {
+        if (desc.primitive_kind == primitive_kind::matmul_grouped)
+            return reinterpret_cast<const matmul_grouped_desc_t &>(desc);
+
+        auto grouped_desc = matmul_grouped_desc_t();
+        grouped_desc.primitive_kind = desc.primitive_kind;
+        grouped_desc.src_desc = desc.src_desc;
+        grouped_desc.weights_desc = desc.weights_desc;
+        grouped_desc.bias_desc = desc.bias_desc;
+        grouped_desc.dst_desc = desc.dst_desc;
+        grouped_desc.accum_data_type = desc.accum_data_type;
+        return grouped_desc;
+    }
 };
 
 } // namespace impl
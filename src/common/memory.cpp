@@ -33,6 +33,10 @@
 #include "type_helpers.hpp"
 #include "utils.hpp"
 
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+#include "cpu/cpu_memory_storage.hpp"
+#endif
+
 using namespace dnnl::impl;
 using namespace dnnl::impl::utils;
 using namespace dnnl::impl::status;
@@ -530,6 +534,37 @@ status_t dnnl_memory_create(memory_t **memory, const memory_desc_t *md,
     return success;
 }
 
+status_t dnnl_memory_create_from_file(memory_t **memory,
+        const memory_desc_t *md, engine_t *engine, const char *path,
+        size_t offset) {
+    if (any_null(memory, md, engine, path)) return invalid_arguments;
+
+    const auto mdw = memory_desc_wrapper(md);
+    if (mdw.format_any() || mdw.has_runtime_dims_or_strides()
+            || mdw.size() == 0)
+        return invalid_arguments;
+
+    // Elements and extra buffers must be aligned to their data types.
+    const size_t alignment = mdw.is_additional_buffer()
+            ? nstl::max<size_t>(mdw.data_type_size(), sizeof(int32_t))
+            : mdw.data_type_size();
+    if (offset % alignment != 0) return invalid_arguments;
+
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+    if (engine->kind() != engine_kind::cpu
+            || !is_native_runtime(engine->runtime_kind()))
+        return unimplemented;
+
+    std::unique_ptr<cpu::cpu_memory_storage_t> storage(
+            new cpu::cpu_memory_storage_t(engine));
+    CHECK(storage->init_file_mapping(path, offset, mdw.size()));
+    return safe_ptr_assign(
+            *memory, new memory_t(engine, md, std::move(storage)));
+#else
+    return unimplemented;
+#endif
+}
+
 status_t dnnl_memory_get_memory_desc(
         const memory_t *memory, const memory_desc_t **md) {
     if (any_null(memory, md)) return invalid_arguments;
@@ -33,7 +33,9 @@ namespace impl {
 
 struct exec_ctx_t;
 
-enum memory_flags_t { alloc = 0x1, use_runtime_ptr = 0x2 };
+// The scratchpad flag is a usage hint for engines with a user allocator and
+// can only be combined with alloc.
+enum memory_flags_t { alloc = 0x1, use_runtime_ptr = 0x2, scratchpad = 0x4 };
 } // namespace impl
 } // namespace dnnl
 
@@ -166,6 +166,8 @@ enum {
     key_brgemm_primitive_buffer_comp,
     key_brgemm_primitive_zp_comp_a,
     key_brgemm_primitive_zp_comp_b,
+    key_brgemm_primitive_src_quantized,
+    key_brgemm_primitive_src_row_scales,
     key_concat_iptrs,
     key_concat_istrides,
     key_concat_nelems,
@@ -19,6 +19,7 @@
 #include <assert.h>
 
 #include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
 #include "engine.hpp"
 
 #if defined(DNNL_ENABLE_ITT_TASKS)
@@ -32,6 +33,7 @@
 #include "scratchpad_debug.hpp"
 #include "stack_checker.hpp"
 #include "stream.hpp"
+#include "tracing.hpp"
 #include "utils.hpp"
 
 using namespace dnnl::impl;
@@ -89,6 +91,10 @@ status_t primitive_create(primitive_iface_t **primitive_iface,
 
     std::pair<primitive_iface_t *, bool> p_iface;
 
+    const bool is_traced = tracing::is_enabled();
+    const uint64_t trace_start_ns
+            = is_traced ? tracing::get_timestamp_ns() : 0;
+
     if (get_verbose() >= 2) {
         double start_ms = get_msec();
         CHECK(primitive_desc_iface->create_primitive_iface(p_iface));
@@ -103,6 +109,10 @@ status_t primitive_create(primitive_iface_t **primitive_iface,
     } else {
         CHECK(primitive_desc_iface->create_primitive_iface(p_iface));
     }
+
+    if (is_traced)
+        tracing::record_create(
+                p_iface.first->pd(), p_iface.second, trace_start_ns);
     return safe_ptr_assign((*primitive_iface), p_iface.first);
 }
 
@@ -119,6 +129,20 @@ status_t primitive_execute(
         itt::primitive_task_start(primitive_iface->pd()->impl()->kind());
 #endif
 
+    // Unlike verbose mode, tracing does not wait for the stream, hence for
+    // asynchronous streams it measures the submission time only.
+    const bool is_traced = tracing::is_enabled();
+    const uint64_t trace_start_ns
+            = is_traced ? tracing::get_timestamp_ns() : 0;
+
+    // Parallel regions are measured for CPU engines only, where the
+    // primitive is executed by the calling thread.
+    parallel_stats_t parallel_stats;
+    const bool collect_parallel_stats = (get_verbose() || is_traced)
+            && is_parallel_stats_enabled()
+            && stream->engine()->kind() == engine_kind::cpu;
+    if (collect_parallel_stats) set_parallel_stats(&parallel_stats);
+
     if (get_verbose()) {
         stream->wait();
         double start_ms = get_msec();
@@ -130,11 +154,24 @@ status_t primitive_execute(
 
         printf("dnnl_verbose%s,exec,%s,%g\n", stamp.c_str(),
                 primitive_iface->pd()->info(), duration_ms);
+        if (parallel_stats.n_regions > 0)
+            printf("dnnl_verbose%s,exec_parallel_stats,regions:%d,max_nthr:%d,"
+                   "busy_max:%g,busy_avg:%g,imbalance:%g,items_max:%g,"
+                   "items_avg:%g\n",
+                    stamp.c_str(), parallel_stats.n_regions,
+                    parallel_stats.max_nthr, parallel_stats.max_busy_ms,
+                    parallel_stats.avg_busy_ms, parallel_stats.imbalance(),
+                    parallel_stats.max_items, parallel_stats.avg_items);
         fflush(stdout);
     } else {
         status = stream->enqueue_primitive(primitive_iface, ctx);
     }
 
+    if (collect_parallel_stats) set_parallel_stats(nullptr);
+    if (is_traced)
+        tracing::record_exec(primitive_iface->pd(), trace_start_ns,
+                collect_parallel_stats ? &parallel_stats : nullptr);
+
 #if defined(DNNL_ENABLE_ITT_TASKS)
     if (enable_itt) itt::primitive_task_end();
 #endif
@@ -243,7 +280,11 @@ status_t dnnl_primitive::init() {
     const size_t scratchpad_size
             = primitive_->pd()->scratchpad_size(scratchpad_mode::library);
 
-    if (scratchpad_size) {
+    if (scratchpad_size && !scratchpad_debug::is_protect_scratchpad()
+            && use_scratchpad_pool(pd_->engine())) {
+        use_scratchpad_pool_ = true;
+        scratchpad_size_ = scratchpad_size;
+    } else if (scratchpad_size) {
         const memory_tracking::registry_t &registry
                 = primitive_->pd()->scratchpad_registry();
         bool use_global_scratchpad = scratchpad_debug::is_protect_scratchpad()
@@ -277,12 +318,20 @@ const primitive_desc_iface_t *dnnl_primitive::pd() const {
 
 status_t dnnl_primitive::execute(exec_ctx_t &ctx) const {
     const memory_storage_t *mem_storage = nullptr;
+    // Holds the buffer taken from the scratchpad pool until the end of the
+    // execution.
+    std::unique_ptr<scratchpad_t> pooled_scratchpad;
     if (primitive_->pd()->attr()->scratchpad_mode_ == scratchpad_mode::user) {
         memory_t *scratchpad_memory = ctx.output(DNNL_ARG_SCRATCHPAD);
         mem_storage = scratchpad_memory ? scratchpad_memory->memory_storage()
                                         : nullptr;
     } else if (scratchpad_) {
         mem_storage = scratchpad_->get_memory_storage();
+    } else if (use_scratchpad_pool_) {
+        pooled_scratchpad.reset(create_pooled_scratchpad(scratchpad_size_));
+        if (!pooled_scratchpad || !pooled_scratchpad->get_memory_storage())
+            return out_of_memory;
+        mem_storage = pooled_scratchpad->get_memory_storage();
     }
 
     auto scratchpad_grantor
@@ -290,8 +339,18 @@ status_t dnnl_primitive::execute(exec_ctx_t &ctx) const {
     ctx.set_scratchpad_grantor(&scratchpad_grantor);
     ctx.set_resource_mapper(&resource_mapper_);
 
+    // The primitive may be executed by a thread with a wider thread limit
+    // than the one it was created under: narrow the limit to the creation
+    // width so that per-thread scratchpad buffers are not overrun.
+    const int impl_nthr = primitive_->pd()->impl_nthr();
+    const int prev_limit = get_max_threads_limit();
+    const bool narrow = ctx.stream()->engine()->kind() == engine_kind::cpu
+            && dnnl_get_max_threads() > impl_nthr;
+    if (narrow) set_max_threads_limit(impl_nthr);
+
     auto status = primitive_->execute(ctx);
     ctx.set_scratchpad_grantor(nullptr);
+    if (narrow) set_max_threads_limit(prev_limit);
     return status;
 }
 
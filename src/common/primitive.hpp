@@ -30,6 +30,7 @@
 #include "rw_mutex.hpp"
 #include "scratchpad.hpp"
 
+#include <chrono>
 #include <future>
 #include <type_traits>
 
@@ -102,18 +103,25 @@ protected:
 
         auto status = status::success;
         std::shared_ptr<primitive_t> p;
+        auto &stats = primitive_cache_stats();
 
         if (is_from_cache) {
             // The requested primitive is present in the cache or is being
             // created by another thread.
+            const bool is_in_flight = p_future.wait_for(std::chrono::seconds(0))
+                    != std::future_status::ready;
+            stats.record_hit(pd->kind(), is_in_flight);
             p = p_future.get().primitive;
             if (!p) return p_future.get().status;
         } else {
             // The requested primitive is NOT present in the cache therefore
             // we have to create it and notify the waiting threads
             // once the creation is done.
+            const double start_ms = get_msec();
             p = std::make_shared<impl_type>(pd);
+            primitive_footprint_tracker_t footprint_tracker;
             status = p->init(engine, use_global_scratchpad);
+            stats.record_miss(pd->kind(), get_msec() - start_ms);
             if (status != status::success) {
                 // Communicate an error.
                 p_promise.set_value({nullptr, status});
@@ -136,7 +144,13 @@ protected:
                 // in the primitive_t.
                 // Therefore the pointers in the key, which has already been put
                 // into the cache, must be updated.
-                global_primitive_cache.update_entry(key, p->pd().get());
+                // The footprint is estimated as the size of the primitive
+                // objects plus memory allocated during the initialization,
+                // e.g. generated code.
+                const size_t footprint = sizeof(impl_type) + sizeof(pd_t)
+                        + footprint_tracker.get();
+                global_primitive_cache.update_entry(
+                        key, p->pd().get(), footprint);
             }
         }
         primitive = std::make_pair(p, is_from_cache);
@@ -227,6 +241,8 @@ private:
     std::unordered_map<key_t *, mapped_t> primitive_to_resource_;
 };
 
+status_t primitive_create(primitive_iface_t **primitive_iface,
+        const primitive_desc_iface_t *primitive_desc_iface);
 status_t primitive_execute(
         const primitive_iface_t *primitive_iface, exec_ctx_t &ctx);
 
@@ -290,6 +306,9 @@ private:
     std::atomic<int> counter_;
     std::shared_ptr<dnnl::impl::primitive_t> primitive_;
     std::unique_ptr<dnnl::impl::scratchpad_t> scratchpad_;
+    // The scratchpad is taken from the scratchpad pool for each execution.
+    bool use_scratchpad_pool_ = false;
+    size_t scratchpad_size_ = 0;
     std::unique_ptr<primitive_desc_iface_t> pd_;
     dnnl::impl::resource_mapper_t resource_mapper_;
 
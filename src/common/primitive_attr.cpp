@@ -142,6 +142,8 @@ bool primitive_attr_t::has_default_values(dnnl_primitive_attr::skip_mask_t mask,
             rnn_weights_projection_qparams_);
     CHECK_ARG(IMPLICATION((bool)(~mask & smask_t::sum_dt),
             post_ops_.sum_with_default_dt(dst_dt)));
+    CHECK_ARG(IMPLICATION((bool)(~mask & smask_t::src_dyn_quant),
+            src_dyn_quant_dt_ == data_type::undef));
     CHECK_ARG(this->defined(defined_mask));
     return ok;
 #undef CHECK_MASK
@@ -359,6 +361,12 @@ status_t primitive_attr_t::set_fpmath_mode(fpmath_mode_t fpmath_mode) {
     return st;
 }
 
+status_t primitive_attr_t::set_src_dyn_quant(data_type_t dt) {
+    if (!one_of(dt, data_type::undef, data_type::s8)) return invalid_arguments;
+    src_dyn_quant_dt_ = dt;
+    return success;
+}
+
 status_t primitive_attr_t::set_scratchpad_mode(
         scratchpad_mode_t scratchpad_mode) {
     using namespace dnnl::impl::scratchpad_mode;
@@ -415,6 +423,19 @@ status_t dnnl_primitive_attr_set_fpmath_mode(
     return attr->set_fpmath_mode(mode);
 }
 
+status_t dnnl_primitive_attr_get_src_dynamic_quantization(
+        const primitive_attr_t *attr, data_type_t *data_type) {
+    if (any_null(attr, data_type)) return invalid_arguments;
+    *data_type = attr->src_dyn_quant_dt_;
+    return success;
+}
+
+status_t dnnl_primitive_attr_set_src_dynamic_quantization(
+        primitive_attr_t *attr, data_type_t data_type) {
+    if (any_null(attr)) return invalid_arguments;
+    return attr->set_src_dyn_quant(data_type);
+}
+
 status_t dnnl_primitive_attr_get_scratchpad_mode(
         const primitive_attr_t *attr, scratchpad_mode_t *scratchpad_mode) {
     if (any_null(attr, scratchpad_mode)) return invalid_arguments;
@@ -596,7 +596,8 @@ struct dnnl_post_ops : public dnnl::impl::c_compatible {
 struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     dnnl_primitive_attr()
         : scratchpad_mode_(dnnl::impl::scratchpad_mode::library)
-        , fpmath_mode_(dnnl::impl::get_fpmath_mode()) {}
+        , fpmath_mode_(dnnl::impl::get_fpmath_mode())
+        , src_dyn_quant_dt_(dnnl::impl::data_type::undef) {}
 
     dnnl_primitive_attr *clone() const {
         return new dnnl_primitive_attr(*this);
@@ -615,6 +616,7 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
         zero_points_ = other.zero_points_;
         scratchpad_mode_ = other.scratchpad_mode_;
         fpmath_mode_ = other.fpmath_mode_;
+        src_dyn_quant_dt_ = other.src_dyn_quant_dt_;
         CHECK(post_ops_.copy_from(other.post_ops_));
         rnn_data_qparams_ = other.rnn_data_qparams_;
         CHECK(rnn_weights_qparams_.copy_from(other.rnn_weights_qparams_));
@@ -640,7 +642,8 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
         rnn_weights_qparams = 1u << 8,
         rnn_tparams = 1u << 9,
         sum_dt = 1u << 10,
-        rnn_weights_projection_qparams = 1u << 11
+        rnn_weights_projection_qparams = 1u << 11,
+        src_dyn_quant = 1u << 12
     };
 
     /** Returns true if the attributes have default values.
@@ -655,6 +658,7 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     bool operator==(const dnnl_primitive_attr &rhs) const {
         bool ret = scratchpad_mode_ == rhs.scratchpad_mode_
                 && fpmath_mode_ == rhs.fpmath_mode_
+                && src_dyn_quant_dt_ == rhs.src_dyn_quant_dt_
                 && output_scales_ == rhs.output_scales_
                 && scales_ == rhs.scales_ && zero_points_ == rhs.zero_points_
                 && post_ops_ == rhs.post_ops_
@@ -667,6 +671,7 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     }
 
     dnnl::impl::status_t set_fpmath_mode(dnnl::impl::fpmath_mode_t fpmath_mode);
+    dnnl::impl::status_t set_src_dyn_quant(dnnl::impl::data_type_t dt);
     dnnl::impl::status_t set_scratchpad_mode(
             dnnl::impl::scratchpad_mode_t scratchpad_mode);
     dnnl::impl::status_t set_post_ops(const dnnl::impl::post_ops_t &post_ops);
@@ -699,6 +704,9 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     dnnl::impl::zero_points_t zero_points_;
     dnnl::impl::scratchpad_mode_t scratchpad_mode_;
     dnnl::impl::fpmath_mode_t fpmath_mode_;
+    // data type the source is quantized to per row at execution, undef if
+    // the source is used as is
+    dnnl::impl::data_type_t src_dyn_quant_dt_;
     dnnl::impl::post_ops_t post_ops_;
     dnnl::impl::rnn_data_qparams_t rnn_data_qparams_;
     dnnl::impl::scales_t rnn_weights_qparams_;
@@ -16,18 +16,26 @@
 
 #include "primitive_cache.hpp"
 #include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
+#include "engine.hpp"
 #include "primitive.hpp"
 #include "primitive_desc.hpp"
+#include "primitive_iterator.hpp"
 #include "rw_mutex.hpp"
+#include "serialization.hpp"
 #include "z_magic.hpp"
 
+#include "oneapi/dnnl/dnnl_version.h"
+
 #if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
 #include "cpu/platform.hpp"
-#else
-#include <chrono>
 #endif
 
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
 #include <unordered_map>
 
 #ifdef _WIN32
@@ -39,6 +47,11 @@ namespace impl {
 
 namespace {
 
+size_t &thread_primitive_footprint() {
+    static thread_local size_t footprint = 0;
+    return footprint;
+}
+
 size_t get_timestamp() {
 #if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
     return cpu::platform::get_timestamp();
@@ -47,16 +60,153 @@ size_t get_timestamp() {
 #endif
 }
 
+// Destroys content of a cache mapper when the cache itself is destroyed.
+template <typename mapper_t>
+void destroy_cache_mapper(std::unique_ptr<mapper_t> &cache_mapper) {
+    if (cache_mapper->empty()) return;
+
+// The library unloading issue affects only Windows and
+// DPCPP and OpenCL runtimes when DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE is ON.
+#ifndef DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE
+    return;
+#else
+
+#if defined(_WIN32) \
+        && (defined(DNNL_WITH_SYCL) || DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL)
+    // The ntdll.dll library is located in system32 therefore setting additional
+    // environment is not required.
+    HMODULE handle = LoadLibraryA("ntdll.dll");
+    if (!handle) {
+        cache_mapper.release();
+        return;
+    }
+
+    // RtlDllShutdownInProgress returns TRUE if the whole process terminates and
+    // FALSE if DLL is being unloaded dynamically or if it’s called from an
+    // executable.
+    auto f = reinterpret_cast<BOOLEAN (*)(void)>(
+            GetProcAddress(handle, "RtlDllShutdownInProgress"));
+    if (!f) {
+        auto ret = FreeLibrary(handle);
+        assert(ret);
+        MAYBE_UNUSED(ret);
+        cache_mapper.release();
+        return;
+    }
+
+    bool is_process_termination_in_progress = f();
+
+    auto ret = FreeLibrary(handle);
+    assert(ret);
+    MAYBE_UNUSED(ret);
+
+    if (is_process_termination_in_progress) {
+        // The whole process is being terminated hence destroying content of
+        // the primitive cache cannot be done safely. However we can check
+        // all entries and remove those that are not affected e.g. native CPU.
+        for (auto it = cache_mapper->begin(); it != cache_mapper->end();) {
+            const auto &engine_id = it->first.engine_id_;
+            if (engine_id.kind() == engine_kind::cpu
+                    && is_native_runtime(engine_id.runtime_kind())) {
+                it = cache_mapper->erase(it);
+            } else {
+                ++it;
+            }
+        }
+        cache_mapper.release();
+    } else {
+        // Three scenarios possible:
+        // 1. oneDNN is being dynamically unloaded
+        // 2. Another dynamic library that contains statically linked oneDNN is
+        //    dynamically unloaded
+        // 3. oneDNN is statically linked in an executable which is done and now
+        //    the process terminates
+        // In all these scenarios content of the primitive cache can be safely
+        // destroyed.
+        cache_mapper.reset();
+    }
+#else
+    // Always destroy the content of the primitive cache for non-Windows OSes,
+    // and non-sycl and non-ocl runtimes because there is no a problem with
+    // library unloading order in such cases.
+    cache_mapper.reset();
+#endif
+
+#endif /* DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE */
+}
+
 } // namespace
 
+void add_primitive_footprint(size_t size) {
+    thread_primitive_footprint() += size;
+}
+
+primitive_footprint_tracker_t::primitive_footprint_tracker_t()
+    : start_(thread_primitive_footprint()) {}
+
+primitive_footprint_tracker_t::~primitive_footprint_tracker_t() {
+    thread_primitive_footprint() = start_;
+}
+
+size_t primitive_footprint_tracker_t::get() const {
+    return thread_primitive_footprint() - start_;
+}
+
+void primitive_cache_stats_t::get(
+        primitive_kind_t kind, dnnl_primitive_cache_stats_t *stats) const {
+    *stats = dnnl_primitive_cache_stats_t();
+    uint64_t creation_time_ns = 0;
+    for (int i = 0; i < nslots; i++) {
+        const bool is_selected = kind == primitive_kind::undefined
+                || &counters(kind) == &counters_[i];
+        if (!is_selected) continue;
+        const auto &c = counters_[i];
+        stats->hits += c.hits;
+        stats->misses += c.misses;
+        stats->evictions += c.evictions;
+        stats->in_flight_waits += c.in_flight_waits;
+        creation_time_ns += c.creation_time_ns;
+    }
+    stats->creation_time_ms = creation_time_ns * 1e-6;
+}
+
+void primitive_cache_stats_t::reset() {
+    for (auto &c : counters_) {
+        c.hits = 0;
+        c.misses = 0;
+        c.evictions = 0;
+        c.in_flight_waits = 0;
+        c.creation_time_ns = 0;
+    }
+}
+
+primitive_cache_stats_t &primitive_cache_stats() {
+    // The counters are trivially destructible hence the statistics stay
+    // available to the handlers called at the program exit.
+    static primitive_cache_stats_t stats;
+    return stats;
+}
+
 primitive_cache_t &primitive_cache() {
 #ifndef DNNL_DISABLE_PRIMITIVE_CACHE
     static const int capacity
             = getenv_int("DNNL_PRIMITIVE_CACHE_CAPACITY", 1024);
+    static const int capacity_mb
+            = getenv_int("DNNL_PRIMITIVE_CACHE_CAPACITY_MB", 0);
+    static const size_t capacity_bytes = (size_t)nstl::max(0, capacity_mb)
+            << 20;
+    static const int nshards = getenv_int("DNNL_PRIMITIVE_CACHE_SHARDS", 1);
 #else
     static const int capacity = 0;
+    static const size_t capacity_bytes = 0;
+    static const int nshards = 1;
 #endif
-    static lru_primitive_cache_t cache(capacity);
+    if (nshards > 1) {
+        static sharded_primitive_cache_t sharded_cache(
+                capacity, nshards, capacity_bytes);
+        return sharded_cache;
+    }
+    static lru_primitive_cache_t cache(capacity, capacity_bytes);
     return cache;
 }
 
@@ -81,6 +231,193 @@ bool is_primitive_in_cache(const primitive_iface_t *p_iface) {
     return is_pd_in_cache(p_iface->pd());
 }
 
+namespace {
+
+const char persistent_cache_magic[8] = {'D', 'N', 'N', 'L', 'P', 'C', '0', '2'};
+
+// Implementations available to a primitive depend on the library version and
+// on the ISA it dispatches to, hence an exported cache can only be imported
+// by the same library running on the same ISA.
+std::string get_persistent_cache_fingerprint() {
+    const auto *ver = dnnl_version();
+    std::string fp = std::to_string(ver->major) + "."
+            + std::to_string(ver->minor) + "." + std::to_string(ver->patch)
+            + ":" + ver->hash;
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+    fp += ":isa="
+            + std::to_string((int)cpu::platform::get_effective_cpu_isa());
+    fp += ":hints=" + std::to_string((int)cpu::platform::get_cpu_isa_hints());
+#endif
+    return fp;
+}
+
+void write_string(serialization_stream_t &sstream, const std::string &str) {
+    sstream.write(str.size());
+    sstream.write(str.data(), str.size());
+}
+
+bool read_string(deserializer_t &d, std::string &str) {
+    size_t size = 0;
+    if (!d.read(size)) return false;
+    const auto *ptr = reinterpret_cast<const char *>(d.skip(size));
+    if (!ptr) return false;
+    str.assign(ptr, size);
+    return true;
+}
+
+bool serialize_entry(serialization_stream_t &sstream, engine_kind_t engine_kind,
+        const primitive_desc_t *pd) {
+    // Primitive descriptors that depend on a forward hint cannot be
+    // re-created without it.
+    if (!pd->hint_mds(false /* is_hint */).empty()) return false;
+    if (pd->impl_list_idx() < 0) return false;
+
+    sstream.write(engine_kind);
+    sstream.write(pd->pd_iterator_offset());
+    sstream.write(pd->impl_list_idx());
+    write_string(sstream, pd->name());
+    return serialization::serialize_op_desc(sstream, *pd->op_desc())
+            && serialization::serialize_attr(sstream, *pd->attr());
+}
+
+// Re-creates a primitive from the entry and puts it into the cache. Returns
+// status::unimplemented if the entry is not applicable to the engine.
+status_t import_entry(deserializer_t &d, engine_t *engine) {
+    engine_kind_t engine_kind;
+    int pd_iterator_offset = -1;
+    int impl_list_idx = -1;
+    std::string name;
+    if (!d.read(engine_kind) || !d.read(pd_iterator_offset)
+            || !d.read(impl_list_idx) || !read_string(d, name))
+        return status::invalid_arguments;
+    if (engine_kind != engine->kind() || pd_iterator_offset < 0
+            || impl_list_idx < 0)
+        return status::unimplemented;
+
+    std::aligned_storage<sizeof(op_desc_t), alignof(op_desc_t)>::type storage;
+    auto *op_desc = reinterpret_cast<op_desc_t *>(&storage);
+    CHECK(serialization::deserialize_op_desc(d, op_desc));
+
+    primitive_attr_t attr;
+    CHECK(serialization::deserialize_attr(d, attr));
+
+    primitive_desc_iterator_t it(engine, op_desc, &attr, nullptr);
+    if (!it.is_initialized()) return status::out_of_memory;
+    // The stored implementation is created directly. The name check guards
+    // against a library built with another set of implementations.
+    auto pd = *it.seek(impl_list_idx, pd_iterator_offset);
+    if (!pd || name != pd->name()) return status::unimplemented;
+
+    std::pair<std::shared_ptr<primitive_t>, bool> p;
+    CHECK(pd->create_primitive(p, engine));
+
+    primitive_hashing::key_t key(pd.get(), engine);
+    return primitive_cache().set_persistent(key) ? status::success
+                                                 : status::unimplemented;
+}
+
+} // namespace
+
+status_t export_primitive_cache(const char *path) {
+    if (path == nullptr) return status::invalid_arguments;
+
+    serialization_stream_t sstream;
+    sstream.write(persistent_cache_magic, sizeof(persistent_cache_magic));
+    write_string(sstream, get_persistent_cache_fingerprint());
+
+    std::vector<serialization_stream_t> entries;
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    for (const auto &e : primitive_cache().get_primitives()) {
+        serialization_stream_t entry;
+        if (serialize_entry(entry, e.first, e.second->pd().get()))
+            entries.push_back(std::move(entry));
+    }
+#endif
+
+    sstream.write(entries.size());
+    for (const auto &entry : entries) {
+        const auto &data = entry.get_data();
+        sstream.write(data.size());
+        sstream.write(data.data(), data.size());
+    }
+
+    FILE *fp = fopen(path, "wb");
+    if (!fp) return status::invalid_arguments;
+    const auto &data = sstream.get_data();
+    const size_t written = fwrite(data.data(), 1, data.size(), fp);
+    const bool ok = fclose(fp) == 0 && written == data.size();
+    return ok ? status::success : status::runtime_error;
+}
+
+status_t import_primitive_cache(
+        engine_t *engine, const char *path, int *n_imported) {
+    if (utils::any_null(engine, path)) return status::invalid_arguments;
+    if (n_imported) *n_imported = 0;
+
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return status::invalid_arguments;
+    std::vector<uint8_t> data;
+    uint8_t buf[4096];
+    size_t nread = 0;
+    while ((nread = fread(buf, 1, sizeof(buf), fp)) > 0)
+        data.insert(data.end(), buf, buf + nread);
+    fclose(fp);
+
+    deserializer_t d(data.data(), data.size());
+    char magic[sizeof(persistent_cache_magic)];
+    std::string fingerprint;
+    size_t n_entries = 0;
+    if (!d.read(magic, sizeof(magic)) || !read_string(d, fingerprint)
+            || !d.read(n_entries))
+        return status::invalid_arguments;
+    if (std::memcmp(magic, persistent_cache_magic, sizeof(magic))
+            || fingerprint != get_persistent_cache_fingerprint())
+        return status::invalid_arguments;
+
+    std::vector<std::pair<const uint8_t *, size_t>> entries;
+    entries.reserve(n_entries);
+    for (size_t i = 0; i < n_entries; ++i) {
+        size_t size = 0;
+        const uint8_t *ptr = d.read(size) ? d.skip(size) : nullptr;
+        if (!ptr) return status::invalid_arguments;
+        entries.emplace_back(ptr, size);
+    }
+
+    // Most of the import time is spent on generating code hence primitives
+    // are re-created in parallel. The threads use the number of threads of
+    // the calling thread, including its thread limit, as it is a part of the
+    // primitive cache key.
+    const int nthr_caller = dnnl_get_max_threads();
+    const size_t nthr = nstl::min(entries.size(),
+            (size_t)nstl::max(1u, std::thread::hardware_concurrency()));
+    std::atomic<size_t> next_entry {0};
+    std::atomic<int> n {0};
+    auto worker = [&]() {
+        for (size_t i = next_entry++; i < entries.size(); i = next_entry++) {
+            // Entries that cannot be re-created, e.g. because another engine
+            // kind was used, are skipped.
+            deserializer_t entry(entries[i].first, entries[i].second);
+            if (import_entry(entry, engine) == status::success) n++;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t ithr = 1; ithr < nthr; ++ithr)
+        threads.emplace_back([&]() {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+            omp_set_num_threads(nthr_caller);
+#endif
+            set_max_threads_limit(nthr_caller);
+            worker();
+        });
+    worker();
+    for (auto &t : threads)
+        t.join();
+
+    if (n_imported) *n_imported = n;
+    return status::success;
+}
+
 status_t lru_primitive_cache_t::set_capacity(int capacity) {
     utils::lock_write_t lock_w(rw_mutex());
     capacity_ = (size_t)capacity;
@@ -98,6 +435,23 @@ int lru_primitive_cache_t::get_capacity() const {
     return (int)capacity_;
 }
 
+status_t lru_primitive_cache_t::set_capacity_bytes(size_t capacity) {
+    utils::lock_write_t lock_w(rw_mutex());
+    capacity_bytes_ = capacity;
+    evict_bytes();
+    return status::success;
+}
+
+size_t lru_primitive_cache_t::get_capacity_bytes() const {
+    utils::lock_read_t lock_r(rw_mutex());
+    return capacity_bytes_;
+}
+
+size_t lru_primitive_cache_t::get_size_bytes() const {
+    utils::lock_read_t lock_r(rw_mutex());
+    return size_bytes_;
+}
+
 // For undocumented API
 int lru_primitive_cache_t::get_size() const {
     utils::lock_read_t lock_r(rw_mutex());
@@ -114,7 +468,7 @@ lru_primitive_cache_t::value_t lru_primitive_cache_t::get_or_add(
         return value_t();
     }
     // Check if the requested entry is present in the cache (likely cache_hit)
-    auto e = get(key);
+    auto e = get(key, true);
     if (e.valid()) {
         unlock_read();
         return e;
@@ -136,7 +490,7 @@ lru_primitive_cache_t::value_t lru_primitive_cache_t::get_or_add(
 
     // Double check if the requested entry is present in the cache (unlikely
     // cache_hit).
-    e = get(key);
+    e = get(key, true);
     if (!e.valid()) {
         // If the entry is missing in the cache then add it (cache_miss)
         add(key, value);
@@ -162,12 +516,18 @@ void lru_primitive_cache_t::add(const key_t &key, const value_t &value) {
     assert(res.second);
 }
 
-lru_primitive_cache_t::value_t lru_primitive_cache_t::get(const key_t &key) {
+lru_primitive_cache_t::value_t lru_primitive_cache_t::get(
+        const key_t &key, bool is_request) {
     auto it = cache_mapper().find(key);
     if (it == cache_mapper().end()) return value_t();
 
     size_t timestamp = get_timestamp();
     it->second.timestamp_.store(timestamp);
+    // Only the first request served by an imported entry is counted because
+    // it is the one that would otherwise have generated the code.
+    if (is_request && it->second.is_persistent_.load(std::memory_order_relaxed)
+            && it->second.is_persistent_.exchange(false))
+        n_persistent_hits_++;
     // Return the entry
     return it->second.value_;
 }
@@ -182,6 +542,45 @@ std::shared_ptr<primitive_desc_t> lru_primitive_cache_t::get_pd(
     return nullptr;
 }
 
+std::vector<std::pair<engine_kind_t, std::shared_ptr<primitive_t>>>
+lru_primitive_cache_t::get_primitives() {
+    utils::lock_read_t lock_r(rw_mutex());
+    std::vector<std::pair<engine_kind_t, std::shared_ptr<primitive_t>>>
+            primitives;
+    primitives.reserve(cache_mapper().size());
+    for (const auto &e : cache_mapper()) {
+        const auto &value = e.second.value_;
+        // Skip entries that are still being created to avoid waiting on them
+        // under the lock.
+        if (value.wait_for(std::chrono::seconds(0))
+                != std::future_status::ready)
+            continue;
+        if (!value.get().primitive) continue;
+#ifdef DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE
+        // Non-sycl CPU engines do not have an engine id.
+        const engine_kind_t engine_kind = e.first.engine_id_
+                ? e.first.engine_id_.kind()
+                : engine_kind::cpu;
+#else
+        const engine_kind_t engine_kind = e.first.engine_kind_;
+#endif
+        primitives.emplace_back(engine_kind, value.get().primitive);
+    }
+    return primitives;
+}
+
+bool lru_primitive_cache_t::set_persistent(const key_t &key) {
+    utils::lock_read_t lock_r(rw_mutex());
+    auto it = cache_mapper().find(key);
+    if (it == cache_mapper().end()) return false;
+    it->second.is_persistent_.store(true);
+    return true;
+}
+
+size_t lru_primitive_cache_t::get_persistent_hits() const {
+    return n_persistent_hits_.load();
+}
+
 void lru_primitive_cache_t::remove_if_invalidated(const key_t &key) {
     lock_write();
     auto it = cache_mapper().find(key);
@@ -199,12 +598,12 @@ void lru_primitive_cache_t::remove_if_invalidated(const key_t &key) {
     }
 
     // Remove the invalidated entry
-    cache_mapper().erase(it);
+    erase(it);
     unlock_write();
 }
 
 void lru_primitive_cache_t::update_entry(
-        const key_t &key, const primitive_desc_t *pd) {
+        const key_t &key, const primitive_desc_t *pd, size_t footprint) {
     utils::lock_write_t lock_w(rw_mutex());
     auto it = cache_mapper().find(key);
 
@@ -222,6 +621,16 @@ void lru_primitive_cache_t::update_entry(
     // Update key in cache_mapper()
     it->first.op_desc_ = op_desc;
     it->first.attr_ = attr;
+
+    // The footprint is known only once the primitive is created.
+    it->second.footprint_ = footprint;
+    size_bytes_ += footprint;
+    evict_bytes();
+}
+
+void lru_primitive_cache_t::erase(cache_mapper_t::iterator it) {
+    size_bytes_ -= it->second.footprint_;
+    cache_mapper().erase(it);
 }
 
 // Evicts n the least recently used entries
@@ -229,7 +638,10 @@ void lru_primitive_cache_t::evict(size_t n) {
     using v_t = std::unordered_map<key_t, timed_entry_t>::value_type;
 
     if (n == capacity_) {
+        for (const auto &e : cache_mapper())
+            primitive_cache_stats().record_eviction(e.first.primitive_kind_);
         cache_mapper().clear();
+        size_bytes_ = 0;
         return;
     }
 
@@ -253,83 +665,283 @@ void lru_primitive_cache_t::evict(size_t n) {
                             < right.second.timestamp_.load(
                                     std::memory_order_relaxed);
                 });
-        auto res = cache_mapper().erase(it->first);
-        MAYBE_UNUSED(res);
-        assert(res);
+        primitive_cache_stats().record_eviction(it->first.primitive_kind_);
+        erase(it);
+    }
+}
+
+// Evicts entries until the total footprint fits the capacity in bytes. Unlike
+// evict(), the policy is size-aware: an entry with the largest product of its
+// age and footprint is evicted first so that a few large primitives that are
+// not used are evicted before many small ones.
+void lru_primitive_cache_t::evict_bytes() {
+    using v_t = std::unordered_map<key_t, timed_entry_t>::value_type;
+
+    if (capacity_bytes_ == 0) return;
+
+    const size_t now = get_timestamp();
+    auto cost = [&](const v_t &e) {
+        const size_t timestamp
+                = e.second.timestamp_.load(std::memory_order_relaxed);
+        const size_t age = now > timestamp ? now - timestamp : 0;
+        return ((double)age + 1) * (double)e.second.footprint_;
+    };
+
+    while (size_bytes_ > capacity_bytes_ && !cache_mapper().empty()) {
+        auto it = std::max_element(cache_mapper().begin(), cache_mapper().end(),
+                [&](const v_t &left, const v_t &right) {
+                    return cost(left) < cost(right);
+                });
+        primitive_cache_stats().record_eviction(it->first.primitive_kind_);
+        erase(it);
     }
 }
 
 lru_primitive_cache_t::~lru_primitive_cache_t() {
-    if (cache_mapper().empty()) return;
+    destroy_cache_mapper(cache_mapper_);
+}
 
-// The library unloading issue affects only Windows and
-// DPCPP and OpenCL runtimes when DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE is ON.
-#ifndef DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE
-    return;
-#else
+sharded_primitive_cache_t::sharded_primitive_cache_t(
+        int capacity, int nshards, size_t capacity_bytes)
+    : capacity_(capacity), capacity_bytes_(capacity_bytes) {
+    shards_.reserve(nshards);
+    for (int i = 0; i < nshards; i++)
+        shards_.emplace_back(utils::make_unique<shard_t>());
+}
 
-#if defined(_WIN32) \
-        && (defined(DNNL_WITH_SYCL) || DNNL_GPU_RUNTIME == DNNL_RUNTIME_OCL)
-    // The ntdll.dll library is located in system32 therefore setting additional
-    // environment is not required.
-    HMODULE handle = LoadLibraryA("ntdll.dll");
-    if (!handle) {
-        cache_mapper_.release();
-        return;
+status_t sharded_primitive_cache_t::set_capacity(int capacity) {
+    capacity_ = (size_t)capacity;
+    if (capacity_ == 0) {
+        for (auto &shard : shards_) {
+            utils::lock_write_t lock_w(shard->rw_mutex_);
+            for (const auto &e : *shard->cache_mapper_) {
+                primitive_cache_stats().record_eviction(
+                        e.first.primitive_kind_);
+                size_bytes_ -= e.second.footprint_;
+            }
+            size_ -= shard->cache_mapper_->size();
+            shard->cache_mapper_->clear();
+            shard->clock_.clear();
+            shard->hand_ = shard->clock_.end();
+        }
+        return status::success;
     }
+    evict_excess();
+    return status::success;
+}
 
-    // RtlDllShutdownInProgress returns TRUE if the whole process terminates and
-    // FALSE if DLL is being unloaded dynamically or if it’s called from an
-    // executable.
-    auto f = reinterpret_cast<BOOLEAN (*)(void)>(
-            GetProcAddress(handle, "RtlDllShutdownInProgress"));
-    if (!f) {
-        auto ret = FreeLibrary(handle);
-        assert(ret);
-        MAYBE_UNUSED(ret);
-        cache_mapper_.release();
-        return;
+int sharded_primitive_cache_t::get_capacity() const {
+    return (int)capacity_.load();
+}
+
+status_t sharded_primitive_cache_t::set_capacity_bytes(size_t capacity) {
+    capacity_bytes_ = capacity;
+    evict_excess();
+    return status::success;
+}
+
+size_t sharded_primitive_cache_t::get_capacity_bytes() const {
+    return capacity_bytes_.load();
+}
+
+int sharded_primitive_cache_t::get_size() const {
+    return (int)size_.load();
+}
+
+size_t sharded_primitive_cache_t::get_size_bytes() const {
+    return size_bytes_.load();
+}
+
+sharded_primitive_cache_t::value_t sharded_primitive_cache_t::get_or_add(
+        const key_t &key, const value_t &value) {
+    // Check if the cache is enabled.
+    if (capacity_ == 0) return value_t();
+
+    auto &shard = get_shard(key);
+
+    // 1. Section with shared access to the shard (likely cache_hit).
+    shard.rw_mutex_.lock_read();
+    auto e = get(shard, key, true);
+    shard.rw_mutex_.unlock_read();
+    if (e.valid()) return e;
+
+    // 2. Section with exclusive access to the shard. The entry may have been
+    // added by another thread in between, hence the double check.
+    shard.rw_mutex_.lock_write();
+    if (capacity_ == 0) {
+        shard.rw_mutex_.unlock_write();
+        return value_t();
     }
+    e = get(shard, key, true);
+    if (!e.valid()) add(shard, key, value);
+    shard.rw_mutex_.unlock_write();
 
-    bool is_process_termination_in_progress = f();
+    // The shard the entry was added to might have been empty, in this case
+    // the excess entry is evicted from other shards.
+    if (!e.valid()) evict_excess();
+    return e;
+}
 
-    auto ret = FreeLibrary(handle);
-    assert(ret);
-    MAYBE_UNUSED(ret);
+sharded_primitive_cache_t::value_t sharded_primitive_cache_t::get(
+        shard_t &shard, const key_t &key, bool is_request) {
+    auto it = shard.cache_mapper_->find(key);
+    if (it == shard.cache_mapper_->end()) return value_t();
 
-    if (is_process_termination_in_progress) {
-        // The whole process is being terminated hence destroying content of
-        // the primitive cache cannot be done safely. However we can check
-        // all entries and remove those that are not affected e.g. native CPU.
-        for (auto it = cache_mapper().begin(); it != cache_mapper().end();) {
-            const auto &engine_id = it->first.engine_id_;
-            if (engine_id.kind() == engine_kind::cpu
-                    && is_native_runtime(engine_id.runtime_kind())) {
-                it = cache_mapper().erase(it);
-            } else {
-                ++it;
-            }
+    // Avoid writing to the cache line shared between threads when the bit is
+    // already set.
+    auto &entry = it->second;
+    if (!entry.is_referenced_.load(std::memory_order_relaxed))
+        entry.is_referenced_.store(true, std::memory_order_relaxed);
+    if (is_request && entry.is_persistent_.load(std::memory_order_relaxed)
+            && entry.is_persistent_.exchange(false))
+        n_persistent_hits_++;
+    return entry.value_;
+}
+
+void sharded_primitive_cache_t::add(
+        shard_t &shard, const key_t &key, const value_t &value) {
+    if (size_ >= capacity_ && !shard.cache_mapper_->empty()) evict_one(shard);
+
+    auto res = shard.cache_mapper_->emplace(std::piecewise_construct,
+            std::forward_as_tuple(key), std::forward_as_tuple(value));
+    assert(res.second);
+    // A new entry is put right behind the hand so that it is the last one to
+    // be visited.
+    res.first->second.clock_it_
+            = shard.clock_.insert(shard.hand_, &res.first->first);
+    size_++;
+}
+
+void sharded_primitive_cache_t::erase(
+        shard_t &shard, cache_mapper_t::iterator it) {
+    auto clock_it = it->second.clock_it_;
+    if (shard.hand_ == clock_it) ++shard.hand_;
+    shard.clock_.erase(clock_it);
+    size_bytes_ -= it->second.footprint_;
+    shard.cache_mapper_->erase(it);
+    size_--;
+}
+
+void sharded_primitive_cache_t::evict_one(shard_t &shard) {
+    assert(!shard.clock_.empty());
+    // Referenced entries get a second chance: the bit is cleared and the hand
+    // moves on. The loop ends after at most one full revolution.
+    while (true) {
+        if (shard.hand_ == shard.clock_.end()) shard.hand_ = shard.clock_.begin();
+        auto it = shard.cache_mapper_->find(**shard.hand_);
+        assert(it != shard.cache_mapper_->end());
+        if (it->second.is_referenced_.load(std::memory_order_relaxed)) {
+            it->second.is_referenced_.store(false, std::memory_order_relaxed);
+            ++shard.hand_;
+            continue;
         }
-        cache_mapper_.release();
-    } else {
-        // Three scenarios possible:
-        // 1. oneDNN is being dynamically unloaded
-        // 2. Another dynamic library that contains statically linked oneDNN is
-        //    dynamically unloaded
-        // 3. oneDNN is statically linked in an executable which is done and now
-        //    the process terminates
-        // In all these scenarios content of the primitive cache can be safely
-        // destroyed.
-        cache_mapper_.reset();
+        primitive_cache_stats().record_eviction(it->first.primitive_kind_);
+        erase(shard, it);
+        return;
+    }
+}
+
+void sharded_primitive_cache_t::evict_excess() {
+    while (is_over_capacity()) {
+        bool is_evicted = false;
+        for (auto &shard : shards_) {
+            utils::lock_write_t lock_w(shard->rw_mutex_);
+            if (!is_over_capacity()) return;
+            if (shard->cache_mapper_->empty()) continue;
+            evict_one(*shard);
+            is_evicted = true;
+        }
+        if (!is_evicted) return;
     }
+}
+
+std::shared_ptr<primitive_desc_t> sharded_primitive_cache_t::get_pd(
+        const key_t &key) {
+    auto &shard = get_shard(key);
+    shard.rw_mutex_.lock_read();
+    auto e = get(shard, key);
+    shard.rw_mutex_.unlock_read();
+
+    if (e.valid()) return e.get().primitive->pd();
+    return nullptr;
+}
+
+std::vector<std::pair<engine_kind_t, std::shared_ptr<primitive_t>>>
+sharded_primitive_cache_t::get_primitives() {
+    std::vector<std::pair<engine_kind_t, std::shared_ptr<primitive_t>>>
+            primitives;
+    for (auto &shard : shards_) {
+        utils::lock_read_t lock_r(shard->rw_mutex_);
+        for (const auto &e : *shard->cache_mapper_) {
+            const auto &value = e.second.value_;
+            if (value.wait_for(std::chrono::seconds(0))
+                    != std::future_status::ready)
+                continue;
+            if (!value.get().primitive) continue;
+#ifdef DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE
+            // Non-sycl CPU engines do not have an engine id.
+            const engine_kind_t engine_kind = e.first.engine_id_
+                    ? e.first.engine_id_.kind()
+                    : engine_kind::cpu;
 #else
-    // Always destroy the content of the primitive cache for non-Windows OSes,
-    // and non-sycl and non-ocl runtimes because there is no a problem with
-    // library unloading order in such cases.
-    cache_mapper_.reset();
+            const engine_kind_t engine_kind = e.first.engine_kind_;
 #endif
+            primitives.emplace_back(engine_kind, value.get().primitive);
+        }
+    }
+    return primitives;
+}
 
-#endif /* DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE */
+bool sharded_primitive_cache_t::set_persistent(const key_t &key) {
+    auto &shard = get_shard(key);
+    utils::lock_read_t lock_r(shard.rw_mutex_);
+    auto it = shard.cache_mapper_->find(key);
+    if (it == shard.cache_mapper_->end()) return false;
+    it->second.is_persistent_.store(true);
+    return true;
+}
+
+size_t sharded_primitive_cache_t::get_persistent_hits() const {
+    return n_persistent_hits_.load();
+}
+
+void sharded_primitive_cache_t::remove_if_invalidated(const key_t &key) {
+    auto &shard = get_shard(key);
+    utils::lock_write_t lock_w(shard.rw_mutex_);
+    auto it = shard.cache_mapper_->find(key);
+    // The entry has been already evicted at this point
+    if (it == shard.cache_mapper_->end()) return;
+    // The entry is not invalidated
+    if (it->second.value_.get().primitive) return;
+
+    erase(shard, it);
+}
+
+void sharded_primitive_cache_t::update_entry(
+        const key_t &key, const primitive_desc_t *pd, size_t footprint) {
+    auto &shard = get_shard(key);
+    shard.rw_mutex_.lock_write();
+    auto it = shard.cache_mapper_->find(key);
+
+    // See lru_primitive_cache_t::update_entry() for details.
+    if (it == shard.cache_mapper_->end()
+            || it->first.thread_id() != key.thread_id()) {
+        shard.rw_mutex_.unlock_write();
+        return;
+    }
+
+    it->first.op_desc_ = pd->op_desc();
+    it->first.attr_ = pd->attr();
+    it->second.footprint_ = footprint;
+    size_bytes_ += footprint;
+    shard.rw_mutex_.unlock_write();
+
+    evict_excess();
+}
+
+sharded_primitive_cache_t::~sharded_primitive_cache_t() {
+    for (auto &shard : shards_)
+        destroy_cache_mapper(shard->cache_mapper_);
 }
 
 } // namespace impl
@@ -352,3 +964,64 @@ dnnl::impl::status_t dnnl_set_primitive_cache_capacity(int capacity) {
 #endif
     return dnnl::impl::status::success;
 }
+
+dnnl::impl::status_t dnnl_get_primitive_cache_capacity_bytes(
+        size_t *capacity) {
+    if (capacity == nullptr) return dnnl::impl::status::invalid_arguments;
+    *capacity = 0;
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    *capacity = dnnl::impl::primitive_cache().get_capacity_bytes();
+#endif
+    return dnnl::impl::status::success;
+}
+
+dnnl::impl::status_t dnnl_set_primitive_cache_capacity_bytes(size_t capacity) {
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    return dnnl::impl::primitive_cache().set_capacity_bytes(capacity);
+#endif
+    return dnnl::impl::status::success;
+}
+
+dnnl::impl::status_t dnnl_get_primitive_cache_usage(
+        int *n_entries, size_t *n_bytes) {
+    if (n_entries == nullptr && n_bytes == nullptr)
+        return dnnl::impl::status::invalid_arguments;
+    if (n_entries) *n_entries = 0;
+    if (n_bytes) *n_bytes = 0;
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    if (n_entries) *n_entries = dnnl::impl::primitive_cache().get_size();
+    if (n_bytes) *n_bytes = dnnl::impl::primitive_cache().get_size_bytes();
+#endif
+    return dnnl::impl::status::success;
+}
+
+dnnl::impl::status_t dnnl_export_primitive_cache(const char *path) {
+    return dnnl::impl::export_primitive_cache(path);
+}
+
+dnnl::impl::status_t dnnl_import_primitive_cache(
+        dnnl::impl::engine_t *engine, const char *path, int *n_imported) {
+    return dnnl::impl::import_primitive_cache(engine, path, n_imported);
+}
+
+dnnl::impl::status_t dnnl_primitive_cache_get_stats(
+        dnnl::impl::primitive_kind_t kind,
+        dnnl_primitive_cache_stats_t *stats) {
+    if (stats == nullptr) return dnnl::impl::status::invalid_arguments;
+    dnnl::impl::primitive_cache_stats().get(kind, stats);
+    return dnnl::impl::status::success;
+}
+
+dnnl::impl::status_t dnnl_primitive_cache_reset_stats() {
+    dnnl::impl::primitive_cache_stats().reset();
+    return dnnl::impl::status::success;
+}
+
+dnnl::impl::status_t dnnl_get_primitive_cache_persistent_hits(size_t *hits) {
+    if (hits == nullptr) return dnnl::impl::status::invalid_arguments;
+    *hits = 0;
+#ifndef DNNL_DISABLE_PRIMITIVE_CACHE
+    *hits = dnnl::impl::primitive_cache().get_persistent_hits();
+#endif
+    return dnnl::impl::status::success;
+}
@@ -17,10 +17,13 @@
 #ifndef COMMON_PRIMITIVE_CACHE_HPP
 #define COMMON_PRIMITIVE_CACHE_HPP
 
+#include <atomic>
 #include <future>
+#include <list>
 #include <memory>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "c_types_map.hpp"
 #include "oneapi/dnnl/dnnl.h"
@@ -45,14 +48,32 @@ struct primitive_cache_t : public c_compatible {
     virtual status_t set_capacity(int capacity) = 0;
     virtual int get_capacity() const = 0;
 
+    // Limits the total footprint of the cached primitives in bytes, the
+    // value of 0 means no limit.
+    virtual status_t set_capacity_bytes(size_t capacity) = 0;
+    virtual size_t get_capacity_bytes() const = 0;
+
     virtual value_t get_or_add(const key_t &key, const value_t &value) = 0;
     virtual void remove_if_invalidated(const key_t &key) = 0;
-    virtual void update_entry(const key_t &key, const primitive_desc_t *pd) = 0;
+    virtual void update_entry(const key_t &key, const primitive_desc_t *pd,
+            size_t footprint)
+            = 0;
 
     virtual int get_size() const = 0;
+    virtual size_t get_size_bytes() const = 0;
 
     virtual std::shared_ptr<primitive_desc_t> get_pd(const key_t &key) = 0;
 
+    // Returns primitives of all entries that have been successfully created
+    // along with the kind of the engine they were created for.
+    virtual std::vector<std::pair<engine_kind_t, std::shared_ptr<primitive_t>>>
+    get_primitives() = 0;
+    // Marks an entry as imported from a persistent store. Returns false if
+    // the entry is not in the cache.
+    virtual bool set_persistent(const key_t &key) = 0;
+    // Returns a number of requests served by imported entries.
+    virtual size_t get_persistent_hits() const = 0;
+
 protected:
     static utils::rw_mutex_t &rw_mutex() {
         static utils::rw_mutex_t mutex;
@@ -67,7 +88,8 @@ protected:
 
 // The cache uses LRU replacement policy
 struct lru_primitive_cache_t : public primitive_cache_t {
-    lru_primitive_cache_t(int capacity) : capacity_(capacity) {
+    lru_primitive_cache_t(int capacity, size_t capacity_bytes = 0)
+        : capacity_(capacity), capacity_bytes_(capacity_bytes) {
         cache_mapper_ = utils::make_unique<
                 std::unordered_map<key_t, timed_entry_t>>();
     }
@@ -77,26 +99,53 @@ struct lru_primitive_cache_t : public primitive_cache_t {
     status_t set_capacity(int capacity) override;
     int get_capacity() const override;
 
+    status_t set_capacity_bytes(size_t capacity) override;
+    size_t get_capacity_bytes() const override;
+
     value_t get_or_add(const key_t &key, const value_t &value) override;
     void remove_if_invalidated(const key_t &key) override;
-    void update_entry(const key_t &key, const primitive_desc_t *pd) override;
+    void update_entry(const key_t &key, const primitive_desc_t *pd,
+            size_t footprint) override;
 
     int get_size() const override;
+    size_t get_size_bytes() const override;
 
     std::shared_ptr<primitive_desc_t> get_pd(const key_t &key) override;
 
-private:
-    void evict(size_t n);
-    void add(const key_t &key, const value_t &value);
-    value_t get(const key_t &key);
+    std::vector<std::pair<engine_kind_t, std::shared_ptr<primitive_t>>>
+    get_primitives() override;
+    bool set_persistent(const key_t &key) override;
+    size_t get_persistent_hits() const override;
 
-    size_t capacity_;
+private:
     struct timed_entry_t {
         value_t value_;
         std::atomic<size_t> timestamp_;
+        // Set for entries imported from a persistent store until the first
+        // primitive creation request is served by the entry.
+        std::atomic<bool> is_persistent_;
+        // Estimated memory kept alive by the primitive, set once the
+        // primitive is created.
+        size_t footprint_;
         timed_entry_t(const value_t &value, size_t timestamp)
-            : value_(value), timestamp_(timestamp) {}
+            : value_(value)
+            , timestamp_(timestamp)
+            , is_persistent_(false)
+            , footprint_(0) {}
     };
+    using cache_mapper_t = std::unordered_map<key_t, timed_entry_t>;
+
+    void evict(size_t n);
+    // Evicts entries until the total footprint fits the capacity in bytes.
+    void evict_bytes();
+    void erase(cache_mapper_t::iterator it);
+    void add(const key_t &key, const value_t &value);
+    value_t get(const key_t &key, bool is_request = false);
+
+    size_t capacity_;
+    size_t capacity_bytes_;
+    size_t size_bytes_ = 0;
+    std::atomic<size_t> n_persistent_hits_ {0};
 
     std::unordered_map<key_t, timed_entry_t> &cache_mapper() {
         return *cache_mapper_;
@@ -113,8 +162,160 @@ private:
     std::unique_ptr<std::unordered_map<key_t, timed_entry_t>> cache_mapper_;
 };
 
+// The cache is split into a number of shards selected by the key hash. Each
+// shard has its own lock hence threads looking up different keys do not
+// contend on a single lock. A cache hit only takes the shared lock of a shard
+// and sets a reference bit of the entry, no timestamps are updated.
+// Replacement policy is CLOCK (second chance) within a shard, which is not a
+// global LRU. The footprint limit is enforced in the same order, without
+// taking the footprint of the entries into account.
+struct sharded_primitive_cache_t : public primitive_cache_t {
+    sharded_primitive_cache_t(
+            int capacity, int nshards, size_t capacity_bytes = 0);
+
+    ~sharded_primitive_cache_t() override;
+
+    status_t set_capacity(int capacity) override;
+    int get_capacity() const override;
+
+    status_t set_capacity_bytes(size_t capacity) override;
+    size_t get_capacity_bytes() const override;
+
+    value_t get_or_add(const key_t &key, const value_t &value) override;
+    void remove_if_invalidated(const key_t &key) override;
+    void update_entry(const key_t &key, const primitive_desc_t *pd,
+            size_t footprint) override;
+
+    int get_size() const override;
+    size_t get_size_bytes() const override;
+
+    std::shared_ptr<primitive_desc_t> get_pd(const key_t &key) override;
+
+    std::vector<std::pair<engine_kind_t, std::shared_ptr<primitive_t>>>
+    get_primitives() override;
+    bool set_persistent(const key_t &key) override;
+    size_t get_persistent_hits() const override;
+
+private:
+    struct clock_entry_t {
+        value_t value_;
+        std::atomic<bool> is_referenced_;
+        std::atomic<bool> is_persistent_;
+        size_t footprint_;
+        // Position of the entry in the clock of the shard.
+        std::list<const key_t *>::iterator clock_it_;
+        clock_entry_t(const value_t &value)
+            : value_(value)
+            , is_referenced_(false)
+            , is_persistent_(false)
+            , footprint_(0) {}
+    };
+    using cache_mapper_t = std::unordered_map<key_t, clock_entry_t>;
+
+    struct shard_t {
+        shard_t() : cache_mapper_(utils::make_unique<cache_mapper_t>()) {}
+        utils::rw_mutex_t rw_mutex_;
+        std::unique_ptr<cache_mapper_t> cache_mapper_;
+        // Keys of the entries in the order of insertion. Keys of an
+        // unordered_map are not moved by rehashing hence pointers to them
+        // stay valid until the entry is erased.
+        std::list<const key_t *> clock_;
+        std::list<const key_t *>::iterator hand_ = clock_.end();
+    };
+
+    shard_t &get_shard(const key_t &key) const {
+        return *shards_[std::hash<key_t>()(key) % shards_.size()];
+    }
+
+    value_t get(shard_t &shard, const key_t &key, bool is_request = false);
+    void add(shard_t &shard, const key_t &key, const value_t &value);
+    void erase(shard_t &shard, cache_mapper_t::iterator it);
+    // Evicts one entry from a shard, the shard must not be empty.
+    void evict_one(shard_t &shard);
+    // Evicts entries from all shards until the size fits the capacity.
+    void evict_excess();
+    bool is_over_capacity() const {
+        return size_ > capacity_
+                || (capacity_bytes_ > 0 && size_bytes_ > capacity_bytes_);
+    }
+
+    std::atomic<size_t> capacity_;
+    std::atomic<size_t> capacity_bytes_;
+    std::atomic<size_t> size_ {0};
+    std::atomic<size_t> size_bytes_ {0};
+    std::atomic<size_t> n_persistent_hits_ {0};
+    std::vector<std::unique_ptr<shard_t>> shards_;
+};
+
+// Counters of the primitive cache activity kept per primitive kind. All
+// internal primitive kinds share a single set of counters.
+struct primitive_cache_stats_t {
+    void record_hit(primitive_kind_t kind, bool is_in_flight) {
+        auto &c = counters(kind);
+        c.hits++;
+        if (is_in_flight) c.in_flight_waits++;
+    }
+    void record_miss(primitive_kind_t kind, double creation_time_ms) {
+        auto &c = counters(kind);
+        c.misses++;
+        c.creation_time_ns += (uint64_t)(creation_time_ms * 1e6);
+    }
+    void record_eviction(primitive_kind_t kind) { counters(kind).evictions++; }
+
+    // Returns the statistics for a primitive kind or the sum over all kinds
+    // if the kind is undefined.
+    void get(primitive_kind_t kind, dnnl_primitive_cache_stats_t *stats) const;
+    void reset();
+
+private:
+    struct counters_t {
+        std::atomic<size_t> hits {0};
+        std::atomic<size_t> misses {0};
+        std::atomic<size_t> evictions {0};
+        std::atomic<size_t> in_flight_waits {0};
+        std::atomic<uint64_t> creation_time_ns {0};
+    };
+
+    // Public primitive kinds are small numbers, the last slot is shared by
+    // the internal ones.
+    static constexpr int nslots = 32;
+    counters_t &counters(primitive_kind_t kind) {
+        return counters_[nstl::min((int)kind, nslots - 1)];
+    }
+    const counters_t &counters(primitive_kind_t kind) const {
+        return counters_[nstl::min((int)kind, nslots - 1)];
+    }
+
+    counters_t counters_[nslots];
+};
+
+primitive_cache_stats_t &primitive_cache_stats();
+
 primitive_cache_t &primitive_cache();
 
+// Accounts memory that stays alive with a primitive being created on the
+// current thread, e.g. generated code.
+void add_primitive_footprint(size_t size);
+
+// Measures the memory accounted with add_primitive_footprint() during the
+// lifetime of the object. The memory accounted by nested trackers is not
+// included into the outer ones since nested primitives are cached separately.
+struct primitive_footprint_tracker_t {
+    primitive_footprint_tracker_t();
+    ~primitive_footprint_tracker_t();
+    size_t get() const;
+
+private:
+    size_t start_;
+    DNNL_DISALLOW_COPY_AND_ASSIGN(primitive_footprint_tracker_t);
+};
+
+// Writes descriptors of the cached primitives to a file so that the
+// primitives can be re-created with import_primitive_cache() later.
+status_t export_primitive_cache(const char *path);
+status_t import_primitive_cache(
+        engine_t *engine, const char *path, int *n_imported);
+
 // Undocumented API for testing.
 status_t DNNL_API get_primitive_cache_size(int *size);
 bool DNNL_API is_primitive_in_cache(const primitive_iface_t *p_iface);
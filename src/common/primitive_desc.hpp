@@ -22,6 +22,7 @@
 #include "oneapi/dnnl/dnnl.h"
 
 #include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
 #include "memory_tracking.hpp"
 #include "nstl.hpp"
 #include "primitive_attr.hpp"
@@ -37,11 +38,18 @@ struct primitive_t;
 // Primitive descriptor implementation
 struct primitive_desc_t : public c_compatible {
     primitive_desc_t(const primitive_attr_t *attr, primitive_kind_t kind)
-        : attr_(*attr), kind_(kind), pd_iterator_offset_(0) {
+        : attr_(*attr)
+        , kind_(kind)
+        , pd_iterator_offset_(0)
+        , impl_list_idx_(-1)
+        , impl_nthr_(dnnl_get_max_threads()) {
         is_initialized_ = is_initialized_ && attr_.is_initialized();
     }
 
-    primitive_desc_t(primitive_kind_t kind) : kind_(kind) {}
+    primitive_desc_t(primitive_kind_t kind)
+        : kind_(kind)
+        , impl_list_idx_(-1)
+        , impl_nthr_(dnnl_get_max_threads()) {}
 
     bool is_initialized() const { return is_initialized_; }
 
@@ -257,11 +265,20 @@ struct primitive_desc_t : public c_compatible {
     virtual const char *name() const = 0;
 
     int pd_iterator_offset() const { return pd_iterator_offset_; }
+    // Index of the implementation in the engine's implementation list, or -1
+    // if the primitive descriptor was not created by the iterator.
+    int impl_list_idx() const { return impl_list_idx_; }
+    // Number of threads the implementation was created for. Per-thread
+    // buffers in the scratchpad are sized for this many threads, so the
+    // execution must not use more.
+    int impl_nthr() const { return impl_nthr_; }
 
 protected:
     primitive_attr_t attr_;
     primitive_kind_t kind_;
     int pd_iterator_offset_;
+    int impl_list_idx_;
+    int impl_nthr_;
 
     memory_desc_t scratchpad_md_;
 
@@ -271,6 +288,7 @@ protected:
 
 protected:
     void init_pd_iterator_offset(int offset) { pd_iterator_offset_ = offset; }
+    void init_impl_list_idx(int idx) { impl_list_idx_ = idx; }
 
     /** compares ws between fwd_pd and this (make sense to use for bwd_pd)
      * Expectation: this already set workspace, and this workspace should
@@ -297,8 +315,11 @@ protected:
                 && adesc->kind == primitive_kind::logsoftmax;
         bool valid_pooling = pd_t::base_pkind == primitive_kind::pooling_v2
                 && adesc->kind == primitive_kind::pooling;
+        // Grouped matmul descriptors extend the matmul ones.
+        bool valid_matmul = pd_t::base_pkind == primitive_kind::matmul
+                && adesc->kind == primitive_kind::matmul_grouped;
         if (adesc->kind != pd_t::base_pkind && !valid_logsoftmax
-                && !valid_pooling)
+                && !valid_pooling && !valid_matmul)
             return invalid_arguments;
         assert(hint_fwd ? hint_fwd->kind() == pd_t::base_pkind : true);
         auto hint
@@ -0,0 +1,189 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
+#include "primitive.hpp"
+#include "primitive_desc.hpp"
+#include "primitive_future.hpp"
+#include "utils.hpp"
+
+using namespace dnnl::impl;
+using namespace dnnl::impl::status;
+
+namespace dnnl {
+namespace impl {
+
+namespace {
+
+struct creation_task_t {
+    // A clone of the user's primitive descriptor, so that the user can
+    // destroy the original one before the creation is complete.
+    std::unique_ptr<primitive_desc_iface_t> pd_iface;
+    // Number of threads available to the requesting thread.
+    int nthr;
+    std::promise<primitive_future_t::result_t> promise;
+};
+
+// Library-owned worker threads creating primitives in the background. The
+// threads are started with the first request and are joined when the library
+// is unloaded. The tasks left in the queue at that point are failed.
+struct creation_pool_t {
+    creation_pool_t(int nthr) {
+        threads_.reserve(nthr);
+        for (int i = 0; i < nthr; i++)
+            threads_.emplace_back(&creation_pool_t::worker, this);
+    }
+
+    ~creation_pool_t() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            is_stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto &t : threads_)
+            t.join();
+    }
+
+    void submit(creation_task_t &&task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+private:
+    void worker() {
+        while (true) {
+            creation_task_t task;
+            bool is_stopping = false;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [&] { return is_stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) return;
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+                is_stopping = is_stopping_;
+            }
+            if (is_stopping) {
+                task.promise.set_value({runtime_error, nullptr});
+                continue;
+            }
+            run(task);
+        }
+    }
+
+    static void run(creation_task_t &task) {
+        // The number of threads is a part of the primitive cache key, hence
+        // the primitive is created for the number of threads of the
+        // requesting thread so that it is found in the cache later. A worker
+        // thread has at least as many threads available as any application
+        // thread, so limiting it is enough for all the threading runtimes.
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+        omp_set_num_threads(task.nthr);
+#endif
+        set_max_threads_limit(task.nthr);
+        primitive_iface_t *primitive_iface = nullptr;
+        status_t status
+                = primitive_create(&primitive_iface, task.pd_iface.get());
+        task.pd_iface.reset();
+        task.promise.set_value({status, primitive_iface});
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<creation_task_t> tasks_;
+    std::vector<std::thread> threads_;
+    bool is_stopping_ = false;
+};
+
+creation_pool_t &creation_pool() {
+    static creation_pool_t pool(
+            nstl::max(1, getenv_int("DNNL_PRIMITIVE_CREATION_THREADS", 1)));
+    return pool;
+}
+
+} // namespace
+
+status_t primitive_create_async(primitive_future_t **future,
+        const primitive_desc_iface_t *primitive_desc_iface) {
+    creation_task_t task;
+    task.pd_iface.reset(new primitive_desc_iface_t(
+            primitive_desc_iface->impl(), primitive_desc_iface->engine()));
+    task.nthr = dnnl_get_max_threads();
+
+    auto f = utils::make_unique<primitive_future_t>(
+            task.promise.get_future().share());
+    creation_pool().submit(std::move(task));
+    *future = f.release();
+    return success;
+}
+
+} // namespace impl
+} // namespace dnnl
+
+dnnl_primitive_future::~dnnl_primitive_future() {
+    if (!future_.valid()) return;
+    auto *primitive_iface = future_.get().primitive_iface;
+    if (primitive_iface) primitive_iface->release();
+}
+
+bool dnnl_primitive_future::is_ready() const {
+    return future_.wait_for(std::chrono::seconds(0))
+            == std::future_status::ready;
+}
+
+status_t dnnl_primitive_future::get(
+        primitive_iface_t **primitive_iface) const {
+    const auto &result = future_.get();
+    if (result.status != success) return result.status;
+    result.primitive_iface->retain();
+    *primitive_iface = result.primitive_iface;
+    return success;
+}
+
+status_t dnnl_primitive_create_async(primitive_future_t **future,
+        const primitive_desc_iface_t *primitive_desc_iface) {
+    if (utils::any_null(future, primitive_desc_iface)) return invalid_arguments;
+    return primitive_create_async(future, primitive_desc_iface);
+}
+
+status_t dnnl_primitive_future_is_ready(
+        const primitive_future_t *future, int *is_ready) {
+    if (utils::any_null(future, is_ready)) return invalid_arguments;
+    *is_ready = future->is_ready();
+    return success;
+}
+
+status_t dnnl_primitive_future_get(
+        const primitive_future_t *future, primitive_iface_t **primitive_iface) {
+    if (utils::any_null(future, primitive_iface)) return invalid_arguments;
+    return future->get(primitive_iface);
+}
+
+status_t dnnl_primitive_future_destroy(primitive_future_t *future) {
+    delete future;
+    return success;
+}
@@ -0,0 +1,59 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_PRIMITIVE_FUTURE_HPP
+#define COMMON_PRIMITIVE_FUTURE_HPP
+
+#include <future>
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "c_types_map.hpp"
+#include "utils.hpp"
+
+// A primitive being created in the background. The future owns a reference
+// to the created primitive.
+struct dnnl_primitive_future : public dnnl::impl::c_compatible {
+    struct result_t {
+        dnnl::impl::status_t status;
+        primitive_iface_t *primitive_iface;
+    };
+
+    dnnl_primitive_future(const std::shared_future<result_t> &future)
+        : future_(future) {}
+    ~dnnl_primitive_future();
+
+    bool is_ready() const;
+    // Waits for the creation to complete and returns a new reference to the
+    // created primitive.
+    dnnl::impl::status_t get(primitive_iface_t **primitive_iface) const;
+
+private:
+    std::shared_future<result_t> future_;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(dnnl_primitive_future);
+};
+
+namespace dnnl {
+namespace impl {
+
+status_t primitive_create_async(primitive_future_t **future,
+        const primitive_desc_iface_t *primitive_desc_iface);
+
+} // namespace impl
+} // namespace dnnl
+
+#endif
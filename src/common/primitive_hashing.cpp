@@ -95,6 +95,7 @@ bool key_t::operator==(const key_t &rhs) const {
             CASE(layer_normalization)
             CASE(lrn)
             CASE(matmul)
+            CASE(matmul_grouped)
             CASE(pooling)
             CASE(pooling_v2)
             CASE(prelu)
@@ -205,6 +206,8 @@ size_t get_attr_hash(const primitive_attr_t &attr) {
     size_t seed = 0;
     // scratchpad_mode
     seed = hash_combine(seed, static_cast<size_t>(attr.scratchpad_mode_));
+    // src dynamic quantization
+    seed = hash_combine(seed, static_cast<size_t>(attr.src_dyn_quant_dt_));
 
     if (!attr.output_scales_.has_default_values()) {
         // output_scales: mask
@@ -478,6 +481,23 @@ size_t get_desc_hash(const matmul_desc_t &desc) {
     return seed;
 }
 
+size_t get_desc_hash(const matmul_grouped_desc_t &desc) {
+    size_t seed = 0;
+    // Kinds
+    seed = hash_combine(seed, static_cast<size_t>(desc.primitive_kind));
+    // Memory descriptors
+    seed = hash_combine(seed, get_md_hash(desc.src_desc));
+    seed = hash_combine(seed, get_md_hash(desc.weights_desc));
+    seed = hash_combine(seed, get_md_hash(desc.bias_desc));
+    seed = hash_combine(seed, get_md_hash(desc.dst_desc));
+    // Accumulator type
+    seed = hash_combine(seed, static_cast<size_t>(desc.accum_data_type));
+    // Group offsets
+    seed = hash_combine(seed, get_md_hash(desc.group_offsets_desc));
+    // Combined hash for grouped matmul op desc
+    return seed;
+}
+
 size_t get_desc_hash(const pooling_desc_t &desc) {
     size_t seed = 0;
     // Kinds
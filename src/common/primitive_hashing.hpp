@@ -87,6 +87,7 @@ size_t get_desc_hash(const inner_product_desc_t &desc);
 size_t get_desc_hash(const layer_normalization_desc_t &desc);
 size_t get_desc_hash(const lrn_desc_t &desc);
 size_t get_desc_hash(const matmul_desc_t &desc);
+size_t get_desc_hash(const matmul_grouped_desc_t &desc);
 size_t get_desc_hash(const pooling_desc_t &desc);
 size_t get_desc_hash(const pooling_v2_desc_t &desc);
 size_t get_desc_hash(const prelu_desc_t &desc);
@@ -176,6 +177,7 @@ struct hash<dnnl::impl::primitive_hashing::key_t> {
             CASE(layer_normalization)
             CASE(lrn)
             CASE(matmul)
+            CASE(matmul_grouped)
             CASE(pooling)
             CASE(pooling_v2)
             CASE(prelu)
@@ -80,7 +80,7 @@ struct dnnl_primitive_desc_iterator : public dnnl::impl::c_compatible {
             if (idx_ == skip_idx_) continue;
             dnnl::impl::primitive_desc_t *candidate_pd = nullptr;
             auto s = impl_list_[idx_](&candidate_pd, op_desc_, &attr_, engine_,
-                    hint_fwd_pd_, offset_);
+                    hint_fwd_pd_, offset_, idx_);
             if (s == dnnl::impl::status::success) {
                 pd_.reset(candidate_pd);
                 break;
@@ -89,6 +89,27 @@ struct dnnl_primitive_desc_iterator : public dnnl::impl::c_compatible {
         return *this;
     }
 
+    // Moves the iterator directly to the implementation at `impl_list_idx`
+    // without trying the preceding ones. `offset` is the position the
+    // implementation had when it was reached by regular iteration. If the
+    // implementation is not applicable, the dereferenced iterator is null.
+    dnnl::impl::primitive_desc_iterator_t &seek(
+            int impl_list_idx, int offset) {
+        pd_.reset();
+        if (impl_list_idx < 0 || impl_list_idx >= last_idx_) {
+            idx_ = last_idx_;
+            return *this;
+        }
+
+        idx_ = impl_list_idx;
+        offset_ = offset;
+        dnnl::impl::primitive_desc_t *candidate_pd = nullptr;
+        auto s = impl_list_[idx_](&candidate_pd, op_desc_, &attr_, engine_,
+                hint_fwd_pd_, offset_, idx_);
+        if (s == dnnl::impl::status::success) pd_.reset(candidate_pd);
+        return *this;
+    }
+
     std::shared_ptr<dnnl::impl::primitive_desc_t> operator*() const {
         if (*this == end() || pd_ == nullptr) return nullptr;
         return pd_;
@@ -14,13 +14,18 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
+#include "dnnl_thread.hpp"
 #include "engine.hpp"
 #include "utils.hpp"
 
 #if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
 #include "cpu/cpu_engine.hpp"
+#include "cpu/platform.hpp"
 #endif
 
 #include "scratchpad.hpp"
@@ -46,6 +51,19 @@ engine_t *get_cpu_engine() {
 }
 #endif
 
+// Scratchpads of an engine with a user allocator or a NUMA node are allocated
+// through the engine and are not shared with other engines.
+bool has_private_scratchpad(engine_t *engine) {
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+    if (engine->kind() == engine_kind::cpu
+            && is_native_runtime(engine->runtime_kind()))
+        return utils::downcast<cpu::cpu_engine_t *>(engine)
+                ->has_private_scratchpad();
+#endif
+    MAYBE_UNUSED(engine);
+    return false;
+}
+
 memory_storage_t *create_scratchpad_memory_storage(
         engine_t *engine, size_t size) {
     // XXX: if engine is a non-native CPU engine (read: SYCL) then create
@@ -69,7 +87,8 @@ memory_storage_t *create_scratchpad_memory_storage(
 #endif
 
     memory_storage_t *mem_storage = nullptr;
-    auto status = mem_engine->create_memory_storage(&mem_storage, size);
+    auto status = mem_engine->create_memory_storage(&mem_storage,
+            memory_flags_t::alloc | memory_flags_t::scratchpad, size, nullptr);
     MAYBE_UNUSED(status);
     return mem_storage;
 }
@@ -154,6 +173,204 @@ thread_local memory_storage_t *global_scratchpad_t::mem_storage_ = nullptr;
 thread_local size_t global_scratchpad_t::size_ = 0;
 thread_local unsigned int global_scratchpad_t::reference_count_ = 0;
 
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+namespace {
+
+// Four size classes per power of two limit the unused part of a buffer to
+// 25% of its size.
+size_t get_size_class(size_t size) {
+    const size_t min_size_class = 4096;
+    if (size <= min_size_class) return min_size_class;
+    size_t pow2 = min_size_class;
+    while (2 * pow2 < size)
+        pow2 *= 2;
+    return utils::rnd_up(size, pow2 / 4);
+}
+
+/*
+  Pool of scratchpad buffers shared by all primitives executed on native CPU
+  engines. A buffer is taken from the pool for the time of an execution only,
+  hence the memory held by the pool is bounded by the number of concurrent
+  executions rather than by the number of primitives.
+
+  Free buffers are kept per NUMA node of the thread that released them. A new
+  buffer is first touched in parallel by the threads of the threading runtime
+  so that its pages are placed on the nodes of the threads that will use them.
+*/
+struct scratchpad_pool_t {
+    scratchpad_pool_t()
+        : capacity_((size_t)nstl::max(0,
+                            getenv_int("DNNL_SCRATCHPAD_POOL_CAPACITY_MB", 0))
+                << 20) {
+        // The engine must outlive the buffers of the pool.
+        get_cpu_engine();
+    }
+
+    ~scratchpad_pool_t() {
+        for (auto &e : free_)
+            for (auto *mem_storage : e.second)
+                delete mem_storage;
+    }
+
+    memory_storage_t *acquire(size_t size, size_t &size_class, int &node) {
+        size_class = get_size_class(size);
+        node = cpu::platform::get_current_numa_node();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // A free buffer of up to twice the requested size is reused.
+            auto it = free_.lower_bound({node, size_class});
+            if (it != free_.end() && it->first.first == node
+                    && it->first.second < 2 * size_class) {
+                auto *mem_storage = it->second.back();
+                size_class = it->first.second;
+                it->second.pop_back();
+                if (it->second.empty()) free_.erase(it);
+                cached_ -= size_class;
+                in_use_ += size_class;
+                peak_in_use_ = nstl::max(peak_in_use_, in_use_);
+                n_reuses_++;
+                return mem_storage;
+            }
+        }
+
+        auto *mem_storage = create_scratchpad_memory_storage(
+                get_cpu_engine(), size_class);
+        if (mem_storage == nullptr) return nullptr;
+        first_touch(mem_storage, size_class);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        in_use_ += size_class;
+        peak_in_use_ = nstl::max(peak_in_use_, in_use_);
+        peak_total_ = nstl::max(peak_total_, in_use_ + cached_);
+        n_allocations_++;
+        return mem_storage;
+    }
+
+    void release(memory_storage_t *mem_storage, size_t size_class, int node) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            in_use_ -= size_class;
+            if (capacity_ == 0 || cached_ + size_class <= capacity_) {
+                free_[{node, size_class}].push_back(mem_storage);
+                cached_ += size_class;
+                return;
+            }
+        }
+        delete mem_storage;
+    }
+
+    void get_stats(dnnl_scratchpad_pool_stats_t *stats) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats->in_use = in_use_;
+        stats->peak_in_use = peak_in_use_;
+        stats->cached = cached_;
+        stats->peak_total = peak_total_;
+        stats->n_allocations = n_allocations_;
+        stats->n_reuses = n_reuses_;
+    }
+
+private:
+    static void first_touch(memory_storage_t *mem_storage, size_t size) {
+        char *ptr = nullptr;
+        mem_storage->get_data_handle((void **)&ptr);
+        if (ptr == nullptr) return;
+
+        const size_t page_size = 4096;
+        const size_t npages = utils::div_up(size, page_size);
+        parallel(0, [&](int ithr, int nthr) {
+            size_t start = 0, end = 0;
+            balance211(npages, nthr, ithr, start, end);
+            for (size_t p = start; p < end; p++)
+                ptr[p * page_size] = 0;
+        });
+    }
+
+    std::mutex mutex_;
+    // Free buffers ordered by the NUMA node and the size class.
+    std::map<std::pair<int, size_t>, std::vector<memory_storage_t *>> free_;
+    // Size of the free buffers the pool keeps, 0 means no limit.
+    const size_t capacity_;
+    size_t in_use_ = 0;
+    size_t peak_in_use_ = 0;
+    size_t cached_ = 0;
+    size_t peak_total_ = 0;
+    size_t n_allocations_ = 0;
+    size_t n_reuses_ = 0;
+};
+
+scratchpad_pool_t &scratchpad_pool() {
+    static scratchpad_pool_t pool;
+    return pool;
+}
+
+bool is_scratchpad_pool_enabled() {
+    static const bool enabled = getenv_int("DNNL_SCRATCHPAD_POOL", 0) != 0;
+    return enabled;
+}
+
+} // namespace
+
+/*
+  Implementation of the scratchpad_t interface that holds a buffer from the
+  scratchpad pool
+*/
+struct pooled_scratchpad_t : public scratchpad_t {
+    pooled_scratchpad_t(size_t size) {
+        mem_storage_ = scratchpad_pool().acquire(size, size_class_, node_);
+        size_ = mem_storage_ ? size : 0;
+    }
+
+    ~pooled_scratchpad_t() override {
+        if (mem_storage_)
+            scratchpad_pool().release(mem_storage_, size_class_, node_);
+    }
+
+    const memory_storage_t *get_memory_storage() const override {
+        return mem_storage_;
+    }
+
+    size_t size() const override { return size_; }
+
+private:
+    memory_storage_t *mem_storage_;
+    size_t size_;
+    size_t size_class_ = 0;
+    int node_ = 0;
+
+    DNNL_DISALLOW_COPY_AND_ASSIGN(pooled_scratchpad_t);
+};
+#endif
+
+bool use_scratchpad_pool(engine_t *engine) {
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE \
+        && DNNL_CPU_THREADING_RUNTIME != DNNL_RUNTIME_THREADPOOL
+    // Execution must be synchronous to return the buffer to the pool once
+    // the execution call returns.
+    return is_scratchpad_pool_enabled() && engine->kind() == engine_kind::cpu
+            && is_native_runtime(engine->runtime_kind())
+            && !has_private_scratchpad(engine);
+#else
+    UNUSED(engine);
+    return false;
+#endif
+}
+
+scratchpad_t *create_pooled_scratchpad(size_t size) {
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+    return new pooled_scratchpad_t(size);
+#else
+    UNUSED(size);
+    return nullptr;
+#endif
+}
+
+void get_scratchpad_pool_stats(dnnl_scratchpad_pool_stats_t *stats) {
+    *stats = dnnl_scratchpad_pool_stats_t();
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+    if (is_scratchpad_pool_enabled()) scratchpad_pool().get_stats(stats);
+#endif
+}
+
 /*
    Scratchpad creation routine
 */
@@ -165,7 +382,8 @@ scratchpad_t *create_scratchpad(
      * from different engines.
      * lock global scratchpad to work with CPU engine only.
      */
-    if (use_global_scratchpad && engine->kind() == engine_kind_t::dnnl_cpu)
+    if (use_global_scratchpad && engine->kind() == engine_kind_t::dnnl_cpu
+            && !has_private_scratchpad(engine))
         return new global_scratchpad_t(engine, size);
     else
         return new concurrent_scratchpad_t(engine, size);
@@ -177,3 +395,10 @@ scratchpad_t *create_scratchpad(
 
 } // namespace impl
 } // namespace dnnl
+
+dnnl::impl::status_t dnnl_get_scratchpad_pool_stats(
+        dnnl_scratchpad_pool_stats_t *stats) {
+    if (stats == nullptr) return dnnl::impl::status::invalid_arguments;
+    dnnl::impl::get_scratchpad_pool_stats(stats);
+    return dnnl::impl::status::success;
+}
@@ -33,6 +33,15 @@ struct scratchpad_t {
 scratchpad_t *create_scratchpad(
         engine_t *engine, size_t size, bool use_global_scratchpad);
 
+// Returns true if the scratchpad of a primitive created for the engine is
+// taken from the scratchpad pool for the time of each execution instead of
+// being owned by the primitive.
+bool use_scratchpad_pool(engine_t *engine);
+// Creates a scratchpad holding a buffer from the pool. The buffer returns to
+// the pool when the scratchpad is destroyed.
+scratchpad_t *create_pooled_scratchpad(size_t size);
+void get_scratchpad_pool_stats(dnnl_scratchpad_pool_stats_t *stats);
+
 } // namespace impl
 } // namespace dnnl
 #endif
@@ -0,0 +1,238 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "serialization.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace serialization {
+
+size_t op_desc_size(primitive_kind_t kind) {
+    using namespace primitive_kind;
+    switch ((int)kind) {
+        case batch_normalization: return sizeof(batch_normalization_desc_t);
+        case binary: return sizeof(binary_desc_t);
+        case convolution:
+        case deconvolution: return sizeof(convolution_desc_t);
+        case eltwise: return sizeof(eltwise_desc_t);
+        case inner_product: return sizeof(inner_product_desc_t);
+        case layer_normalization: return sizeof(layer_normalization_desc_t);
+        case lrn: return sizeof(lrn_desc_t);
+        case logsoftmax:
+        case softmax: return sizeof(softmax_desc_t);
+        case matmul: return sizeof(matmul_desc_t);
+        case matmul_grouped: return sizeof(matmul_grouped_desc_t);
+        // pooling primitive descriptors always keep the v2 version of the
+        // descriptor.
+        case pooling:
+        case pooling_v2: return sizeof(pooling_v2_desc_t);
+        case prelu: return sizeof(prelu_desc_t);
+        case reduction: return sizeof(reduction_desc_t);
+        case resampling: return sizeof(resampling_desc_t);
+        case rnn: return sizeof(rnn_desc_t);
+        case shuffle: return sizeof(shuffle_desc_t);
+        // Descriptors of reorder, concat, sum and internal primitives hold
+        // pointers and cannot be serialized.
+        default: return 0;
+    }
+}
+
+bool serialize_op_desc(serialization_stream_t &sstream, const op_desc_t &desc) {
+    const size_t size = op_desc_size(desc.kind);
+    if (size == 0) return false;
+
+    sstream.write(desc.kind);
+    sstream.write(reinterpret_cast<const uint8_t *>(&desc), size);
+    return true;
+}
+
+status_t deserialize_op_desc(deserializer_t &d, op_desc_t *desc) {
+    primitive_kind_t kind = primitive_kind::undefined;
+    if (!d.read(kind)) return status::invalid_arguments;
+
+    const size_t size = op_desc_size(kind);
+    if (size == 0) return status::invalid_arguments;
+
+    std::memset(reinterpret_cast<void *>(desc), 0, sizeof(op_desc_t));
+    if (!d.read(reinterpret_cast<uint8_t *>(desc), size))
+        return status::invalid_arguments;
+    if (desc->kind != kind) return status::invalid_arguments;
+    return status::success;
+}
+
+namespace {
+
+void serialize_scales(serialization_stream_t &sstream, const scales_t &s) {
+    sstream.write(s.count_);
+    sstream.write(s.mask_);
+    // A run-time scale is stored as a single value.
+    sstream.write(s.scales_, s.defined() ? s.count_ : 1);
+}
+
+status_t deserialize_scales(deserializer_t &d, dim_t &count, int &mask,
+        std::vector<float> &scales) {
+    if (!d.read(count) || !d.read(mask) || count <= 0)
+        return status::invalid_arguments;
+
+    float first = 0.f;
+    if (!d.read(first)) return status::invalid_arguments;
+    scales.assign(is_runtime_value(first) ? 1 : count, first);
+    if (scales.size() > 1 && !d.read(scales.data() + 1, scales.size() - 1))
+        return status::invalid_arguments;
+    return status::success;
+}
+
+} // namespace
+
+bool serialize_attr(
+        serialization_stream_t &sstream, const primitive_attr_t &attr) {
+    using smask_t = primitive_attr_t::skip_mask_t;
+
+    // RNN-specific attributes are not supported.
+    const auto skip_mask = smask_t::oscale_runtime | smask_t::scales_runtime
+            | smask_t::zero_points_runtime | smask_t::post_ops
+            | smask_t::sum_dt;
+    if (!attr.has_default_values(skip_mask)
+            || !attr.rnn_tparams_.has_default_values())
+        return false;
+
+    const auto &po = attr.post_ops_;
+    for (int idx = 0; idx < po.len(); ++idx)
+        if (po.entry_[idx].is_convolution()) return false;
+
+    serialization_stream_t s;
+    s.write(attr.scratchpad_mode_);
+    s.write(attr.fpmath_mode_);
+
+    serialize_scales(s, attr.output_scales_);
+
+    s.write(attr.scales_.scales_.size());
+    for (const auto &e : attr.scales_.scales_) {
+        s.write(e.first);
+        serialize_scales(s, e.second);
+    }
+
+    for (int arg : {DNNL_ARG_SRC, DNNL_ARG_WEIGHTS, DNNL_ARG_DST}) {
+        int mask = 0;
+        const int *zp = nullptr;
+        attr.zero_points_.get(arg, nullptr, &mask, &zp);
+        s.write(mask);
+        s.write(*zp);
+    }
+
+    s.write(po.len());
+    for (int idx = 0; idx < po.len(); ++idx) {
+        const auto &e = po.entry_[idx];
+        s.write(e.kind);
+        switch (e.kind) {
+            case primitive_kind::sum:
+                s.write(e.sum.scale);
+                s.write(e.sum.zero_point);
+                s.write(e.sum.dt);
+                break;
+            case primitive_kind::eltwise: s.write(e.eltwise); break;
+            case primitive_kind::binary:
+                s.write(e.binary.alg);
+                s.write(e.binary.user_src1_desc);
+                break;
+            case primitive_kind::prelu: s.write(e.prelu.mask); break;
+            default: return false;
+        }
+    }
+
+    const auto &data = s.get_data();
+    sstream.write(data.data(), data.size());
+    return true;
+}
+
+status_t deserialize_attr(deserializer_t &d, primitive_attr_t &attr) {
+    scratchpad_mode_t scratchpad_mode;
+    fpmath_mode_t fpmath_mode;
+    if (!d.read(scratchpad_mode) || !d.read(fpmath_mode))
+        return status::invalid_arguments;
+    CHECK(attr.set_scratchpad_mode(scratchpad_mode));
+    CHECK(attr.set_fpmath_mode(fpmath_mode));
+
+    dim_t count = 0;
+    int mask = 0;
+    std::vector<float> scales;
+    CHECK(deserialize_scales(d, count, mask, scales));
+    CHECK(attr.output_scales_.set(count, mask, scales.data()));
+
+    size_t n_arg_scales = 0;
+    if (!d.read(n_arg_scales)) return status::invalid_arguments;
+    for (size_t i = 0; i < n_arg_scales; ++i) {
+        int arg = 0;
+        if (!d.read(arg)) return status::invalid_arguments;
+        CHECK(deserialize_scales(d, count, mask, scales));
+        CHECK(attr.scales_.set(arg, count, mask, scales.data()));
+    }
+
+    for (int arg : {DNNL_ARG_SRC, DNNL_ARG_WEIGHTS, DNNL_ARG_DST}) {
+        int zp = 0;
+        if (!d.read(mask) || !d.read(zp)) return status::invalid_arguments;
+        CHECK(attr.zero_points_.set(arg, 1, mask, &zp));
+    }
+
+    int po_len = 0;
+    if (!d.read(po_len) || po_len < 0 || po_len > post_ops_t::post_ops_limit)
+        return status::invalid_arguments;
+
+    post_ops_t po;
+    for (int idx = 0; idx < po_len; ++idx) {
+        primitive_kind_t kind = primitive_kind::undefined;
+        if (!d.read(kind)) return status::invalid_arguments;
+        switch (kind) {
+            case primitive_kind::sum: {
+                float scale = 0.f;
+                int32_t zero_point = 0;
+                data_type_t dt = data_type::undef;
+                if (!d.read(scale) || !d.read(zero_point) || !d.read(dt))
+                    return status::invalid_arguments;
+                CHECK(po.append_sum(scale, zero_point, dt));
+                break;
+            }
+            case primitive_kind::eltwise: {
+                post_ops_t::entry_t::eltwise_t e;
+                if (!d.read(e)) return status::invalid_arguments;
+                CHECK(po.append_eltwise(e.scale, e.alg, e.alpha, e.beta));
+                break;
+            }
+            case primitive_kind::binary: {
+                alg_kind_t alg = alg_kind::undef;
+                memory_desc_t src1_desc;
+                if (!d.read(alg) || !d.read(src1_desc))
+                    return status::invalid_arguments;
+                CHECK(po.append_binary(alg, &src1_desc));
+                break;
+            }
+            case primitive_kind::prelu:
+                if (!d.read(mask)) return status::invalid_arguments;
+                CHECK(po.append_prelu(mask));
+                break;
+            default: return status::invalid_arguments;
+        }
+    }
+    CHECK(attr.set_post_ops(po));
+
+    return status::success;
+}
+
+} // namespace serialization
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,49 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_SERIALIZATION_HPP
+#define COMMON_SERIALIZATION_HPP
+
+#include "c_types_map.hpp"
+#include "primitive_attr.hpp"
+#include "serialization_stream.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace serialization {
+
+// Returns the size of the operation descriptor for a given primitive kind or
+// 0 if the descriptor cannot be serialized (e.g. it holds pointers).
+size_t op_desc_size(primitive_kind_t kind);
+
+// The serialize_*() functions return false if an object contains data that
+// cannot be represented in a stream, e.g. depthwise post-op or RNN
+// quantization parameters. Nothing is written to the stream in this case.
+bool serialize_op_desc(serialization_stream_t &sstream, const op_desc_t &desc);
+bool serialize_attr(
+        serialization_stream_t &sstream, const primitive_attr_t &attr);
+
+// The deserialize_*() functions expect the data written by the corresponding
+// serialize_*() functions. The `desc` storage must be at least
+// sizeof(op_desc_t) bytes.
+status_t deserialize_op_desc(deserializer_t &d, op_desc_t *desc);
+status_t deserialize_attr(deserializer_t &d, primitive_attr_t &attr);
+
+} // namespace serialization
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -0,0 +1,103 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_SERIALIZATION_STREAM_HPP
+#define COMMON_SERIALIZATION_STREAM_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace dnnl {
+namespace impl {
+
+// Growable byte buffer used to serialize trivially copyable objects.
+struct serialization_stream_t {
+    serialization_stream_t() = default;
+
+    template <typename T>
+    void write(const T *ptr, size_t nelems = 1) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                "only trivially copyable types can be serialized");
+        const auto *p = reinterpret_cast<const uint8_t *>(ptr);
+        data_.insert(data_.end(), p, p + sizeof(T) * nelems);
+    }
+
+    template <typename T>
+    void write(const T &value) {
+        write(&value, 1);
+    }
+
+    bool empty() const { return data_.empty(); }
+    const std::vector<uint8_t> &get_data() const { return data_; }
+
+private:
+    std::vector<uint8_t> data_;
+};
+
+// Reads trivially copyable objects back from a byte buffer. All reads are
+// bounds-checked: once a read runs past the end of the buffer the
+// deserializer is marked as failed and all subsequent reads are no-ops.
+struct deserializer_t {
+    deserializer_t(const uint8_t *data, size_t size)
+        : data_(data), size_(size), pos_(0), ok_(true) {}
+
+    template <typename T>
+    bool read(T *ptr, size_t nelems = 1) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                "only trivially copyable types can be deserialized");
+        const size_t nbytes = sizeof(T) * nelems;
+        if (!ok_ || nbytes > size_ - pos_) {
+            ok_ = false;
+            return false;
+        }
+        std::memcpy(ptr, data_ + pos_, nbytes);
+        pos_ += nbytes;
+        return true;
+    }
+
+    template <typename T>
+    bool read(T &value) {
+        return read(&value, 1);
+    }
+
+    // Returns a pointer to the next `nbytes` bytes and skips them, or nullptr
+    // if there is not enough data left.
+    const uint8_t *skip(size_t nbytes) {
+        if (!ok_ || nbytes > size_ - pos_) {
+            ok_ = false;
+            return nullptr;
+        }
+        const uint8_t *ptr = data_ + pos_;
+        pos_ += nbytes;
+        return ptr;
+    }
+
+    bool ok() const { return ok_; }
+    bool is_end() const { return pos_ == size_; }
+
+private:
+    const uint8_t *data_;
+    size_t size_;
+    size_t pos_;
+    bool ok_;
+};
+
+} // namespace impl
+} // namespace dnnl
+
+#endif
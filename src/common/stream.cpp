@@ -43,6 +43,24 @@ status_t dnnl_stream_create(
     return engine->create_stream(stream, flags);
 }
 
+status_t dnnl_stream_create_with_max_threads(
+        stream_t **stream, engine_t *engine, unsigned flags, int max_threads) {
+    bool args_ok = !utils::any_null(stream, engine) && max_threads >= 0;
+    if (!args_ok) return invalid_arguments;
+    if (engine->kind() != engine_kind::cpu) return unimplemented;
+
+    CHECK(engine->create_stream(stream, flags));
+    (*stream)->set_max_threads(max_threads);
+    return success;
+}
+
+status_t dnnl_stream_get_max_threads(
+        const stream_t *stream, int *max_threads) {
+    if (any_null(stream, max_threads)) return invalid_arguments;
+    *max_threads = stream->max_threads();
+    return success;
+}
+
 status_t dnnl_stream_get_engine(const stream_t *stream, engine_t **engine) {
     if (any_null(stream, engine)) return invalid_arguments;
     *engine = stream->engine();
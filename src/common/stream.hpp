@@ -40,6 +40,10 @@ struct dnnl_stream : public dnnl::impl::c_compatible {
     /** returns stream's kind */
     unsigned flags() const { return flags_; }
 
+    /** returns the maximum number of threads or 0 if there is no limit */
+    int max_threads() const { return max_threads_; }
+    void set_max_threads(int max_threads) { max_threads_ = max_threads; }
+
     virtual dnnl::impl::status_t enqueue_primitive(
             const primitive_iface_t *primitive_iface,
             dnnl::impl::exec_ctx_t &ctx);
@@ -74,6 +78,7 @@ struct dnnl_stream : public dnnl::impl::c_compatible {
 protected:
     dnnl::impl::engine_t *engine_;
     unsigned flags_;
+    int max_threads_ = 0;
 #if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
     dnnl::threadpool_interop::threadpool_iface *threadpool_ = nullptr;
 #endif
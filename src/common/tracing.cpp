@@ -0,0 +1,266 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "c_types_map.hpp"
+#include "primitive_desc.hpp"
+#include "tracing.hpp"
+#include "utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace tracing {
+
+namespace {
+
+enum class event_kind_t { create_cache_hit, create_cache_miss, exec };
+
+struct event_t {
+    event_kind_t kind;
+    uint64_t start_ns;
+    uint64_t end_ns;
+    // The verbose information string is constant for a primitive
+    // descriptor, hence only a pointer to it is recorded. The primitive
+    // descriptor is kept alive until the slot is reused.
+    std::shared_ptr<primitive_desc_t> pd;
+    const char *info;
+    // Valid for execution events if n_regions is not zero.
+    parallel_stats_t stats;
+};
+
+// Ring buffer of the latest events of a thread. The mutex is taken by the
+// owning thread only, except for the time of flushing.
+struct thread_buffer_t {
+    thread_buffer_t(int tid, size_t capacity) : tid(tid), events(capacity) {}
+
+    std::mutex mutex;
+    const int tid;
+    std::vector<event_t> events;
+    // The number of events recorded since the last flush.
+    size_t n_recorded = 0;
+};
+
+int get_pid() {
+#ifdef _WIN32
+    return _getpid();
+#else
+    return (int)getpid();
+#endif
+}
+
+void write_escaped(FILE *f, const char *s, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        const char c = s[i];
+        if (c == '"' || c == '\\')
+            fprintf(f, "\\%c", c);
+        else if ((unsigned char)c < 0x20)
+            fprintf(f, "\\u%04x", c);
+        else
+            fputc(c, f);
+    }
+}
+
+// Writes an event in the Chrome trace event format. The primitive kind and
+// the implementation name are taken from the verbose information string:
+// engine,primitive,implementation,...
+void write_event(FILE *f, int pid, int tid, const event_t &e) {
+    const std::string info(e.info);
+    const size_t kind_pos = std::min(info.find(',') + 1, info.size());
+    const size_t impl_pos
+            = std::min(info.find(',', kind_pos) + 1, info.size());
+    const size_t impl_end = std::min(info.find(',', impl_pos), info.size());
+
+    fprintf(f, "{\"name\":\"");
+    write_escaped(f, info.c_str() + kind_pos,
+            impl_pos - kind_pos - (impl_pos > kind_pos ? 1 : 0));
+    fprintf(f, "\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,",
+            e.kind == event_kind_t::exec ? "exec" : "create",
+            e.start_ns * 1e-3, (e.end_ns - e.start_ns) * 1e-3);
+    fprintf(f, "\"pid\":%d,\"tid\":%d,\"args\":{\"impl\":\"", pid, tid);
+    write_escaped(f, info.c_str() + impl_pos, impl_end - impl_pos);
+    if (e.kind != event_kind_t::exec)
+        fprintf(f, "\",\"cache\":\"%s",
+                e.kind == event_kind_t::create_cache_hit ? "hit" : "miss");
+    fprintf(f, "\",\"info\":\"");
+    write_escaped(f, info.c_str(), info.size());
+    fprintf(f, "\"");
+    if (e.kind == event_kind_t::exec && e.stats.n_regions > 0)
+        fprintf(f,
+                ",\"parallel_regions\":%d,\"max_nthr\":%d,"
+                "\"busy_max_ms\":%g,\"busy_avg_ms\":%g,\"imbalance\":%g",
+                e.stats.n_regions, e.stats.max_nthr, e.stats.max_busy_ms,
+                e.stats.avg_busy_ms, e.stats.imbalance());
+    fprintf(f, "}},\n");
+}
+
+struct tracer_t {
+    tracer_t() {
+        const int len = 4096;
+        char path[len] = {0};
+        if (getenv("DNNL_TRACE_FILE", path, len) > 0)
+            set_file(path);
+    }
+
+    ~tracer_t() { flush(); }
+
+    void set_file(const char *path) {
+        flush();
+        std::lock_guard<std::mutex> lock(mutex_);
+        path_ = path ? path : "";
+        is_file_started_ = false;
+        enabled_.store(!path_.empty(), std::memory_order_relaxed);
+    }
+
+    bool is_enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void record(event_kind_t kind, const primitive_desc_iface_t *pd,
+            uint64_t start_ns, const parallel_stats_t *stats = nullptr) {
+        const uint64_t end_ns = get_timestamp_ns();
+        thread_buffer_t &buf = get_thread_buffer();
+        std::lock_guard<std::mutex> lock(buf.mutex);
+        event_t &e = buf.events[buf.n_recorded % buf.events.size()];
+        e.kind = kind;
+        e.start_ns = start_ns;
+        e.end_ns = end_ns;
+        e.info = pd->info();
+        e.pd = pd->impl();
+        e.stats = stats ? *stats : parallel_stats_t();
+        buf.n_recorded++;
+    }
+
+    status_t flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (path_.empty()) return status::success;
+
+        // The JSON array format of the Chrome trace allows omitting the
+        // closing bracket, so events of the subsequent flushes are appended
+        // to the same file.
+        FILE *f = fopen(path_.c_str(), is_file_started_ ? "a" : "w");
+        if (!f) return status::runtime_error;
+        if (!is_file_started_) fprintf(f, "[\n");
+        is_file_started_ = true;
+
+        const int pid = get_pid();
+        for (auto &buf : buffers_) {
+            std::lock_guard<std::mutex> buf_lock(buf->mutex);
+            const size_t capacity = buf->events.size();
+            const size_t n = std::min(buf->n_recorded, capacity);
+            for (size_t i = buf->n_recorded - n; i < buf->n_recorded; i++)
+                write_event(f, pid, buf->tid, buf->events[i % capacity]);
+            if (buf->n_recorded > capacity)
+                fprintf(f,
+                        "{\"name\":\"dropped %zu events\",\"ph\":\"i\","
+                        "\"s\":\"t\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d},\n",
+                        buf->n_recorded - capacity,
+                        buf->events[buf->n_recorded % capacity].start_ns
+                                * 1e-3,
+                        pid, buf->tid);
+            buf->n_recorded = 0;
+        }
+        fclose(f);
+        return status::success;
+    }
+
+private:
+    thread_buffer_t &get_thread_buffer() {
+        // The buffer is shared with the tracer to keep the events of a thread
+        // until they are flushed, even if the thread exits earlier.
+        thread_local std::shared_ptr<thread_buffer_t> buf;
+        if (!buf) {
+            const int capacity = getenv_int("DNNL_TRACE_BUFFER_SIZE", 65536);
+            std::lock_guard<std::mutex> lock(mutex_);
+            buf = std::make_shared<thread_buffer_t>(
+                    (int)buffers_.size(), (size_t)nstl::max(1, capacity));
+            buffers_.push_back(buf);
+        }
+        return *buf;
+    }
+
+    std::mutex mutex_;
+    std::atomic<bool> enabled_ {false};
+    std::string path_;
+    bool is_file_started_ = false;
+    std::vector<std::shared_ptr<thread_buffer_t>> buffers_;
+};
+
+tracer_t &tracer() {
+    static tracer_t t;
+    return t;
+}
+
+} // namespace
+
+bool is_enabled() {
+#if defined(DISABLE_VERBOSE)
+    return false;
+#else
+    return tracer().is_enabled();
+#endif
+}
+
+uint64_t get_timestamp_ns() {
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<nanoseconds>(
+            steady_clock::now().time_since_epoch())
+            .count();
+}
+
+void record_create(const primitive_desc_iface_t *pd, bool is_cache_hit,
+        uint64_t start_ns) {
+    tracer().record(is_cache_hit ? event_kind_t::create_cache_hit
+                                 : event_kind_t::create_cache_miss,
+            pd, start_ns);
+}
+
+void record_exec(const primitive_desc_iface_t *pd, uint64_t start_ns,
+        const parallel_stats_t *stats) {
+    tracer().record(event_kind_t::exec, pd, start_ns, stats);
+}
+
+} // namespace tracing
+} // namespace impl
+} // namespace dnnl
+
+dnnl::impl::status_t dnnl_set_trace_file(const char *path) {
+#if defined(DISABLE_VERBOSE)
+    return dnnl::impl::status::unimplemented;
+#else
+    dnnl::impl::tracing::tracer().set_file(path);
+    return dnnl::impl::status::success;
+#endif
+}
+
+dnnl::impl::status_t dnnl_flush_trace() {
+#if defined(DISABLE_VERBOSE)
+    return dnnl::impl::status::unimplemented;
+#else
+    return dnnl::impl::tracing::tracer().flush();
+#endif
+}
@@ -0,0 +1,46 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_TRACING_HPP
+#define COMMON_TRACING_HPP
+
+#include <cstdint>
+
+#include "c_types_map.hpp"
+#include "dnnl_thread.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace tracing {
+
+// Tracing records primitive creation and execution events into per-thread
+// ring buffers and writes them to a file in the Chrome trace event format
+// (which Perfetto UI loads as well) at exit or on dnnl_flush_trace().
+bool is_enabled();
+uint64_t get_timestamp_ns();
+
+void record_create(const primitive_desc_iface_t *pd, bool is_cache_hit,
+        uint64_t start_ns);
+// The statistics of parallel regions, if any, are added to the event
+// arguments.
+void record_exec(const primitive_desc_iface_t *pd, uint64_t start_ns,
+        const parallel_stats_t *stats = nullptr);
+
+} // namespace tracing
+} // namespace impl
+} // namespace dnnl
+
+#endif
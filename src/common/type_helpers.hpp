@@ -439,6 +439,18 @@ inline bool operator==(const matmul_desc_t &lhs, const matmul_desc_t &rhs) {
     return ret;
 }
 
+inline bool operator==(
+        const matmul_grouped_desc_t &lhs, const matmul_grouped_desc_t &rhs) {
+    bool ret = COMPARE_DESC_MEMBERS(primitive_kind)
+            && COMPARE_DESC_MEMBERS(src_desc)
+            && COMPARE_DESC_MEMBERS(weights_desc)
+            && COMPARE_DESC_MEMBERS(bias_desc)
+            && COMPARE_DESC_MEMBERS(dst_desc)
+            && COMPARE_DESC_MEMBERS(accum_data_type)
+            && COMPARE_DESC_MEMBERS(group_offsets_desc);
+    return ret;
+}
+
 inline bool operator==(const pooling_desc_t &lhs, const pooling_desc_t &rhs) {
     bool ret = COMPARE_DESC_MEMBERS(primitive_kind)
             && COMPARE_DESC_MEMBERS(prop_kind)
@@ -37,6 +37,7 @@
 
 #include "oneapi/dnnl/dnnl.h"
 
+#include "dnnl_thread.hpp"
 #include "memory_debug.hpp"
 #include "utils.hpp"
 
@@ -262,6 +263,32 @@ dnnl_cpu_isa_hints_t dnnl_get_cpu_isa_hints() {
     return isa_hint;
 }
 
+dnnl_status_t dnnl_set_cpu_hugepages_mode(dnnl_cpu_hugepages_mode_t mode) {
+    auto status = dnnl::impl::status::unimplemented;
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+    status = dnnl::impl::cpu::platform::set_hugepages_mode(mode);
+#endif
+    return status;
+}
+
+dnnl_cpu_hugepages_mode_t dnnl_get_cpu_hugepages_mode() {
+    auto mode = dnnl_cpu_hugepages_none;
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+    mode = dnnl::impl::cpu::platform::get_hugepages_mode();
+#endif
+    return mode;
+}
+
+dnnl_status_t dnnl_set_max_threads_limit(int max_threads) {
+    if (max_threads < 0) return dnnl::impl::status::invalid_arguments;
+    dnnl::impl::set_max_threads_limit(max_threads);
+    return dnnl::impl::status::success;
+}
+
+int dnnl_get_max_threads_limit() {
+    return dnnl::impl::get_max_threads_limit();
+}
+
 #if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
 #include "oneapi/dnnl/dnnl_threadpool_iface.hpp"
 namespace dnnl {
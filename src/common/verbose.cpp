@@ -31,6 +31,7 @@
 #include "oneapi/dnnl/dnnl_version.h"
 
 #include "c_types_map.hpp"
+#include "primitive_cache.hpp"
 #include "verbose.hpp"
 
 #include "batch_normalization_pd.hpp"
@@ -121,6 +122,38 @@ bool get_verbose_timestamp() {
 #endif
 }
 
+#if !defined(DISABLE_VERBOSE)
+namespace {
+// Prints the primitive cache statistics at the program exit when
+// DNNL_VERBOSE_CACHE_STATS is set.
+struct cache_stats_printer_t {
+    ~cache_stats_printer_t() {
+        if (!getenv_int("DNNL_VERBOSE_CACHE_STATS", 0)) return;
+
+        auto print = [](const char *name, primitive_kind_t kind) {
+            dnnl_primitive_cache_stats_t s;
+            primitive_cache_stats().get(kind, &s);
+            if (s.hits == 0 && s.misses == 0 && s.evictions == 0) return;
+            printf("dnnl_verbose,info,primitive_cache,stats,%s,hits:%zu,"
+                   "misses:%zu,evictions:%zu,in_flight_waits:%zu,creation_"
+                   "time:%g\n",
+                    name, s.hits, s.misses, s.evictions, s.in_flight_waits,
+                    s.creation_time_ms);
+        };
+
+        for (int k = dnnl_reorder; k <= dnnl_prelu; k++) {
+            const auto kind = (primitive_kind_t)k;
+            print(dnnl_prim_kind2str(kind), kind);
+        }
+        print("internal", primitive_kind::internal_only_start);
+        print("total", primitive_kind::undefined);
+        fflush(stdout);
+    }
+};
+cache_stats_printer_t cache_stats_printer;
+} // namespace
+#endif
+
 double get_msec() {
 #ifdef _WIN32
     static LARGE_INTEGER frequency;
@@ -396,6 +429,10 @@ std::ostream &operator<<(std::ostream &ss, const primitive_attr_t *attr) {
         ss << " ";
     }
 
+    if (attr->src_dyn_quant_dt_ != data_type::undef)
+        ss << "attr-src-dyn-quant:" << dnnl_dt2str(attr->src_dyn_quant_dt_)
+           << " ";
+
     const post_ops_t &po = attr->post_ops_;
     if (!po.has_default_values()) {
         std::string delim = empty_delim;
@@ -688,12 +725,15 @@ static std::string init_info_matmul(const engine_t *e, const pd_t *pd) {
 
     ss << "src_" << src_md << " wei_" << wei_md;
     if (pd->with_bias()) ss << " bia_" << bia_md << "_mask" << get_bia_mask();
-    ss << " dst_" << dst_md << ",";
+    ss << " dst_" << dst_md;
+    if (pd->is_grouped()) ss << " grp_" << pd->group_offsets_md();
+    ss << ",";
 
     ss << pd->attr() << ",,";
 
     ss << md2dim_str(src_md) << ":" << md2dim_str(wei_md) << ":"
        << md2dim_str(dst_md);
+    if (pd->is_grouped()) ss << ":g" << pd->G();
 
     return ss.str();
 }
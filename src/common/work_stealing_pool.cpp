@@ -0,0 +1,225 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "oneapi/dnnl/dnnl_config.h"
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_WORK_STEALING
+#include <chrono>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#include "cpu/platform.hpp"
+
+#include "dnnl_thread.hpp"
+#include "utils.hpp"
+#include "work_stealing_pool.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace work_stealing {
+
+namespace {
+// The index of the calling thread in the pool or -1 for threads outside of
+// the pool.
+thread_local int current_worker_id = -1;
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(_M_X64)
+    _mm_pause();
+#endif
+}
+
+inline bool spin_time_expired(
+        const std::chrono::steady_clock::time_point &start, int spin_time_us) {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now() - start).count()
+            >= spin_time_us;
+}
+} // namespace
+
+void task_deque_t::push(const task_t &task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(task);
+    size_.store(tasks_.size(), std::memory_order_release);
+}
+
+bool task_deque_t::pop(task_t &task) {
+    if (empty()) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.empty()) return false;
+    task = tasks_.back();
+    tasks_.pop_back();
+    size_.store(tasks_.size(), std::memory_order_release);
+    return true;
+}
+
+bool task_deque_t::steal(task_t &task) {
+    if (empty()) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.empty()) return false;
+    task = tasks_.front();
+    tasks_.pop_front();
+    size_.store(tasks_.size(), std::memory_order_release);
+    return true;
+}
+
+pool_t::pool_t(int nthr, int spin_time_us)
+    : nthr_(nstl::max(1, nthr)), spin_time_us_(nstl::max(0, spin_time_us)) {
+    const int nworkers = nthr_ - 1;
+    for (int id = 0; id < nworkers; id++)
+        deques_.emplace_back(new task_deque_t());
+    for (int id = 0; id < nworkers; id++)
+        workers_.emplace_back(&pool_t::worker_loop, this, id);
+}
+
+pool_t::~pool_t() {
+    {
+        std::lock_guard<std::mutex> lock(park_mutex_);
+        stop_.store(true);
+    }
+    park_cv_.notify_all();
+    for (auto &w : workers_)
+        w.join();
+}
+
+int get_num_threads() {
+    static const int nthr = getenv_int("DNNL_WORK_STEALING_NUM_THREADS",
+            (int)cpu::platform::get_max_threads_to_use());
+    return nstl::max(1, nthr);
+}
+
+pool_t &pool_t::get() {
+    static pool_t pool(get_num_threads(),
+            getenv_int("DNNL_WORK_STEALING_SPIN_TIME", 1000));
+    return pool;
+}
+
+void pool_t::notify() {
+    epoch_.fetch_add(1);
+    if (n_parked_.load() == 0) return;
+    {
+        // Taking the lock guarantees that a worker that has checked the epoch
+        // is already waiting on the condition variable.
+        std::lock_guard<std::mutex> lock(park_mutex_);
+    }
+    park_cv_.notify_all();
+}
+
+bool pool_t::find_task(int id, task_t &task) {
+    const int nworkers = (int)deques_.size();
+    if (nworkers == 0) return false;
+    if (id >= 0 && deques_[id]->pop(task)) return true;
+
+    // Victims are scanned starting from the next worker so that thieves do
+    // not all contend for the same deque.
+    thread_local int next_victim = 0;
+    const int start = id >= 0 ? id + 1 : next_victim++;
+    for (int i = 0; i < nworkers; i++) {
+        const int victim = (start + i) % nworkers;
+        if (victim != id && deques_[victim]->steal(task)) return true;
+    }
+    return false;
+}
+
+void pool_t::run(const task_t &task) {
+    region_t *region = task.region;
+    region->f(task.ithr, region->nthr);
+    // The region may be destroyed right after the last task is done, so this
+    // is the last access to it.
+    region->n_left.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void pool_t::worker_loop(int id) {
+    current_worker_id = id;
+    task_t task;
+    while (!stop_.load(std::memory_order_relaxed)) {
+        if (find_task(id, task)) {
+            run(task);
+            continue;
+        }
+
+        const size_t seen_epoch = epoch_.load();
+        bool found = false;
+        const auto start = std::chrono::steady_clock::now();
+        for (int spin = 0; !found; spin++) {
+            found = find_task(id, task);
+            if (found || stop_.load(std::memory_order_relaxed)) break;
+            cpu_relax();
+            if (spin % 64 == 63 && spin_time_expired(start, spin_time_us_))
+                break;
+        }
+        if (found) {
+            run(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(park_mutex_);
+        n_parked_.fetch_add(1);
+        park_cv_.wait(lock,
+                [&] { return stop_.load() || epoch_.load() != seen_epoch; });
+        n_parked_.fetch_sub(1);
+    }
+}
+
+void pool_t::parallel(int nthr, const std::function<void(int, int)> &f) {
+    const int nworkers = (int)deques_.size();
+    if (nthr == 1 || nworkers == 0) {
+        for (int ithr = 0; ithr < nthr; ithr++)
+            f(ithr, nthr);
+        return;
+    }
+
+    region_t region(f, nthr);
+    const int id = current_worker_id;
+    if (id >= 0) {
+        // Nested region: the tasks are pushed in the reverse order, so the
+        // owner pops them in the order of ithr and thieves take the last
+        // ones.
+        for (int ithr = nthr - 1; ithr > 0; ithr--)
+            deques_[id]->push({&region, ithr});
+    } else {
+        for (int ithr = 1; ithr < nthr; ithr++)
+            deques_[(ithr - 1) % nworkers]->push({&region, ithr});
+    }
+    notify();
+
+    run({&region, 0});
+
+    // Help with the tasks of this and other regions until all the tasks of
+    // this region are done. The remaining tasks may still be running on
+    // other threads, in which case the thread spins and then yields.
+    task_t task;
+    const auto start = std::chrono::steady_clock::now();
+    for (int spin = 0; region.n_left.load(std::memory_order_acquire) > 0;
+            spin++) {
+        if (find_task(id, task)) {
+            run(task);
+            continue;
+        }
+        if (spin % 64 == 63 && spin_time_expired(start, spin_time_us_))
+            std::this_thread::yield();
+        else
+            cpu_relax();
+    }
+}
+
+} // namespace work_stealing
+} // namespace impl
+} // namespace dnnl
+
+#endif
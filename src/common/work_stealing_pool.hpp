@@ -0,0 +1,116 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_WORK_STEALING_POOL_HPP
+#define COMMON_WORK_STEALING_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "c_types_map.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace work_stealing {
+
+// A parallel region: `nthr` tasks, task `ithr` calls f(ithr, nthr). The
+// region is owned by the thread that started it, which waits until all the
+// tasks are done.
+struct region_t {
+    region_t(const std::function<void(int, int)> &f, int nthr)
+        : f(f), nthr(nthr), n_left(nthr) {}
+
+    const std::function<void(int, int)> &f;
+    const int nthr;
+    std::atomic<int> n_left;
+};
+
+struct task_t {
+    region_t *region;
+    int ithr;
+};
+
+// A double-ended queue of tasks. The owner thread pushes and pops tasks at
+// the back, other threads steal them from the front. The size is tracked
+// separately so that idle threads can scan the queues without locking.
+struct task_deque_t {
+    void push(const task_t &task);
+    bool pop(task_t &task);
+    bool steal(task_t &task);
+    bool empty() const { return size_.load(std::memory_order_acquire) == 0; }
+
+private:
+    std::mutex mutex_;
+    std::deque<task_t> tasks_;
+    std::atomic<size_t> size_ {0};
+};
+
+// A pool of worker threads with a deque of tasks per worker. The thread that
+// starts a region runs its first task and helps to run the others, so a pool
+// of `nthr` threads has `nthr - 1` workers.
+//
+// Tasks of a region started outside of the pool are dealt round-robin to the
+// worker deques, so back-to-back regions of the same size map the same tasks
+// to the same workers. A worker starting a nested region pushes its tasks to
+// its own deque for the idle workers to steal.
+//
+// An idle worker spins for `spin_time_us` microseconds looking for tasks
+// before it parks on a condition variable.
+struct pool_t {
+    pool_t(int nthr, int spin_time_us);
+    ~pool_t();
+
+    int nthr() const { return nthr_; }
+    void parallel(int nthr, const std::function<void(int, int)> &f);
+
+    // Returns the pool shared by the library. The number of threads is set
+    // by the DNNL_WORK_STEALING_NUM_THREADS environment variable, the spin
+    // time by DNNL_WORK_STEALING_SPIN_TIME.
+    static pool_t &get();
+
+private:
+    void worker_loop(int id);
+    bool find_task(int id, task_t &task);
+    void run(const task_t &task);
+    void notify();
+
+    const int nthr_;
+    const int spin_time_us_;
+    std::vector<std::unique_ptr<task_deque_t>> deques_;
+    std::vector<std::thread> workers_;
+
+    // Incremented each time new tasks are pushed.
+    std::atomic<size_t> epoch_ {0};
+    std::atomic<int> n_parked_ {0};
+    std::atomic<bool> stop_ {false};
+    std::mutex park_mutex_;
+    std::condition_variable park_cv_;
+
+    pool_t(const pool_t &) = delete;
+    pool_t &operator=(const pool_t &) = delete;
+};
+
+} // namespace work_stealing
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -70,7 +70,7 @@ struct acl_matmul_t : public primitive_t {
 
         status_t init(engine_t *engine) {
             using smask_t = primitive_attr_t::skip_mask_t;
-            bool ok = src_md()->data_type == data_type::f32
+            bool ok = !is_grouped() && src_md()->data_type == data_type::f32
                     && weights_md()->data_type == data_type::f32
                     && desc()->accum_data_type == data_type::f32
                     && dst_md()->data_type == data_type::f32
@@ -29,7 +29,11 @@ namespace cpu {
 
 status_t cpu_engine_t::create_memory_storage(
         memory_storage_t **storage, unsigned flags, size_t size, void *handle) {
-    auto _storage = new cpu_memory_storage_t(this);
+    const auto usage = (flags & memory_flags_t::scratchpad)
+            ? dnnl_allocation_usage_scratchpad
+            : dnnl_allocation_usage_memory;
+    auto _storage = new cpu_memory_storage_t(
+            this, allocator_, usage, affinity_.numa_node());
     if (_storage == nullptr) return status::out_of_memory;
     status_t status = _storage->init(flags, size, handle);
     if (status != status::success) {
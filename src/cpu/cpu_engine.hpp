@@ -23,11 +23,13 @@
 #include "oneapi/dnnl/dnnl.h"
 
 #include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
 #include "common/engine.hpp"
 #include "common/engine_id.hpp"
 #include "common/impl_list_item.hpp"
 #include "common/impl_registration.hpp"
 
+#include "cpu/cpu_memory_storage.hpp"
 #include "cpu/platform.hpp"
 
 #define CPU_INSTANCE(...) \
@@ -94,6 +96,7 @@ public:
             CASE(layer_normalization);
             CASE(lrn);
             CASE(logsoftmax);
+            case primitive_kind::matmul_grouped:
             CASE(matmul);
             case primitive_kind::pooling:
             CASE(pooling_v2);
@@ -112,7 +115,11 @@ public:
 
 class cpu_engine_t : public engine_t {
 public:
-    cpu_engine_t() : engine_t(engine_kind::cpu, get_cpu_native_runtime(), 0) {}
+    cpu_engine_t(const cpu_allocator_t &allocator = cpu_allocator_t(),
+            const cpu_affinity_t &affinity = cpu_affinity_t())
+        : engine_t(engine_kind::cpu, get_cpu_native_runtime(), 0)
+        , allocator_(allocator)
+        , affinity_(affinity) {}
 
     /* implementation part */
 
@@ -146,6 +153,15 @@ public:
 
     device_id_t device_id() const override { return std::make_tuple(0, 0, 0); }
 
+    const cpu_allocator_t &allocator() const { return allocator_; }
+    const cpu_affinity_t &affinity() const { return affinity_; }
+
+    // Scratchpads allocated through a user allocator or placed on a NUMA
+    // node cannot be shared with other engines.
+    bool has_private_scratchpad() const {
+        return allocator_.is_user_defined() || affinity_.numa_node() >= 0;
+    }
+
 #ifdef DNNL_USE_RT_OBJECTS_IN_PRIMITIVE_CACHE
     engine_id_t engine_id() const override {
         // Non-sycl CPU engine doesn't have device and context.
@@ -155,6 +171,10 @@ public:
 protected:
     ~cpu_engine_t() override = default;
 #endif
+
+private:
+    cpu_allocator_t allocator_;
+    cpu_affinity_t affinity_;
 };
 
 class cpu_engine_factory_t : public engine_factory_t {
@@ -44,6 +44,7 @@ using namespace dnnl::impl::prop_kind;
 const std::map<pk_dt_impl_key_t, std::vector<impl_list_item_t>> impl_list_map REG_IP_P({
     {{forward, f32, f32, f32}, {
         CPU_INSTANCE_AVX512(brgemm_inner_product_fwd_t<avx512_core>)
+        CPU_INSTANCE_AVX2(brgemm_inner_product_fwd_t<avx2>)
         CPU_INSTANCE_AARCH64_ACL(acl_inner_product_fwd_t)
         CPU_INSTANCE(gemm_inner_product_fwd_t<f32>)
         CPU_INSTANCE(ref_inner_product_fwd_t)
@@ -106,6 +107,7 @@ const std::map<pk_dt_impl_key_t, std::vector<impl_list_item_t>> impl_list_map RE
     {{forward, s8, s8, f32}, {
         CPU_INSTANCE_AMX(brgemm_inner_product_fwd_t<avx512_core_bf16_amx_int8>)
         CPU_INSTANCE_AVX512(brgemm_inner_product_fwd_t<avx512_core_vnni>)
+        CPU_INSTANCE_AVX2(brgemm_inner_product_fwd_t<avx2_vnni>)
         CPU_INSTANCE(gemm_x8s8s32x_inner_product_fwd_t)
         CPU_INSTANCE(ref_inner_product_int8_fwd_t)
         nullptr,
@@ -113,6 +115,7 @@ const std::map<pk_dt_impl_key_t, std::vector<impl_list_item_t>> impl_list_map RE
     {{forward, s8, s8, s32}, {
         CPU_INSTANCE_AMX(brgemm_inner_product_fwd_t<avx512_core_bf16_amx_int8>)
         CPU_INSTANCE_AVX512(brgemm_inner_product_fwd_t<avx512_core_vnni>)
+        CPU_INSTANCE_AVX2(brgemm_inner_product_fwd_t<avx2_vnni>)
         CPU_INSTANCE(gemm_x8s8s32x_inner_product_fwd_t)
         CPU_INSTANCE(ref_inner_product_int8_fwd_t)
         nullptr,
@@ -120,6 +123,7 @@ const std::map<pk_dt_impl_key_t, std::vector<impl_list_item_t>> impl_list_map RE
     {{forward, s8, s8, s8}, {
         CPU_INSTANCE_AMX(brgemm_inner_product_fwd_t<avx512_core_bf16_amx_int8>)
         CPU_INSTANCE_AVX512(brgemm_inner_product_fwd_t<avx512_core_vnni>)
+        CPU_INSTANCE_AVX2(brgemm_inner_product_fwd_t<avx2_vnni>)
         CPU_INSTANCE(gemm_x8s8s32x_inner_product_fwd_t)
         CPU_INSTANCE(ref_inner_product_int8_fwd_t)
         nullptr,
@@ -127,6 +131,7 @@ const std::map<pk_dt_impl_key_t, std::vector<impl_list_item_t>> impl_list_map RE
     {{forward, s8, s8, u8}, {
         CPU_INSTANCE_AMX(brgemm_inner_product_fwd_t<avx512_core_bf16_amx_int8>)
         CPU_INSTANCE_AVX512(brgemm_inner_product_fwd_t<avx512_core_vnni>)
+        CPU_INSTANCE_AVX2(brgemm_inner_product_fwd_t<avx2_vnni>)
         CPU_INSTANCE(gemm_x8s8s32x_inner_product_fwd_t)
         CPU_INSTANCE(ref_inner_product_int8_fwd_t)
         nullptr,
@@ -134,6 +139,7 @@ const std::map<pk_dt_impl_key_t, std::vector<impl_list_item_t>> impl_list_map RE
     {{forward, u8, s8, f32}, {
         CPU_INSTANCE_AMX(brgemm_inner_product_fwd_t<avx512_core_bf16_amx_int8>)
         CPU_INSTANCE_AVX512(brgemm_inner_product_fwd_t<avx512_core_vnni>)
+        CPU_INSTANCE_AVX2(brgemm_inner_product_fwd_t<avx2_vnni>)
         CPU_INSTANCE(gemm_x8s8s32x_inner_product_fwd_t)
         CPU_INSTANCE(ref_inner_product_int8_fwd_t)
         nullptr,
@@ -141,6 +147,7 @@ const std::map<pk_dt_impl_key_t, std::vector<impl_list_item_t>> impl_list_map RE
     {{forward, u8, s8, s32}, {
         CPU_INSTANCE_AMX(brgemm_inner_product_fwd_t<avx512_core_bf16_amx_int8>)
         CPU_INSTANCE_AVX512(brgemm_inner_product_fwd_t<avx512_core_vnni>)
+        CPU_INSTANCE_AVX2(brgemm_inner_product_fwd_t<avx2_vnni>)
         CPU_INSTANCE(gemm_x8s8s32x_inner_product_fwd_t)
         CPU_INSTANCE(ref_inner_product_int8_fwd_t)
         nullptr,
@@ -148,6 +155,7 @@ const std::map<pk_dt_impl_key_t, std::vector<impl_list_item_t>> impl_list_map RE
     {{forward, u8, s8, s8}, {
         CPU_INSTANCE_AMX(brgemm_inner_product_fwd_t<avx512_core_bf16_amx_int8>)
         CPU_INSTANCE_AVX512(brgemm_inner_product_fwd_t<avx512_core_vnni>)
+        CPU_INSTANCE_AVX2(brgemm_inner_product_fwd_t<avx2_vnni>)
         CPU_INSTANCE(gemm_x8s8s32x_inner_product_fwd_t)
         CPU_INSTANCE(ref_inner_product_int8_fwd_t)
         nullptr,
@@ -155,6 +163,7 @@ const std::map<pk_dt_impl_key_t, std::vector<impl_list_item_t>> impl_list_map RE
     {{forward, u8, s8, u8}, {
         CPU_INSTANCE_AMX(brgemm_inner_product_fwd_t<avx512_core_bf16_amx_int8>)
         CPU_INSTANCE_AVX512(brgemm_inner_product_fwd_t<avx512_core_vnni>)
+        CPU_INSTANCE_AVX2(brgemm_inner_product_fwd_t<avx2_vnni>)
         CPU_INSTANCE(gemm_x8s8s32x_inner_product_fwd_t)
         CPU_INSTANCE(ref_inner_product_int8_fwd_t)
         nullptr,
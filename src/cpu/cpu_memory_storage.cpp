@@ -0,0 +1,67 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "cpu/cpu_memory_storage.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+status_t cpu_memory_storage_t::init_file_mapping(
+        const char *path, size_t offset, size_t size) {
+#if defined(__linux__)
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) return status::invalid_arguments;
+
+    struct stat st;
+    const bool fits = fstat(fd, &st) == 0 && offset <= (size_t)st.st_size
+            && size <= (size_t)st.st_size - offset;
+    if (!fits) {
+        close(fd);
+        return status::invalid_arguments;
+    }
+
+    // The mapping offset must be a multiple of the page size.
+    const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t map_offset = utils::rnd_dn(offset, page_size);
+    const size_t map_size = size + (offset - map_offset);
+    void *map_ptr = mmap(nullptr, map_size, PROT_READ, MAP_SHARED, fd,
+            (off_t)map_offset);
+    // The mapping holds a reference to the file.
+    close(fd);
+    if (map_ptr == MAP_FAILED) return status::out_of_memory;
+
+    void *ptr = reinterpret_cast<uint8_t *>(map_ptr) + (offset - map_offset);
+    data_ = decltype(data_)(ptr, [=](void *) { munmap(map_ptr, map_size); });
+    return status::success;
+#else
+    UNUSED(path);
+    UNUSED(offset);
+    UNUSED(size);
+    return status::unimplemented;
+#endif
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
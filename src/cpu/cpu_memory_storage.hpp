@@ -17,10 +17,12 @@
 #ifndef CPU_CPU_MEMORY_STORAGE_HPP
 #define CPU_CPU_MEMORY_STORAGE_HPP
 
+#include <functional>
 #include <memory>
 
 #include "common/c_types_map.hpp"
 #include "common/memory.hpp"
+#include "common/memory_debug.hpp"
 #include "common/memory_storage.hpp"
 #include "common/stream.hpp"
 #include "common/utils.hpp"
@@ -31,10 +33,27 @@ namespace dnnl {
 namespace impl {
 namespace cpu {
 
+// User-provided functions to allocate memory of a CPU engine. The library
+// allocator is used if the functions are not set.
+struct cpu_allocator_t {
+    dnnl_allocator_alloc_f alloc = nullptr;
+    dnnl_allocator_free_f free = nullptr;
+    void *context = nullptr;
+
+    bool is_user_defined() const { return alloc != nullptr; }
+};
+
 class cpu_memory_storage_t : public memory_storage_t {
 public:
-    cpu_memory_storage_t(engine_t *engine)
-        : memory_storage_t(engine), data_(nullptr, release) {}
+    cpu_memory_storage_t(engine_t *engine,
+            const cpu_allocator_t &allocator = cpu_allocator_t(),
+            dnnl_allocation_usage_t usage = dnnl_allocation_usage_memory,
+            int numa_node = -1)
+        : memory_storage_t(engine)
+        , data_(nullptr, release)
+        , allocator_(allocator)
+        , usage_(usage)
+        , numa_node_(numa_node) {}
 
     status_t get_data_handle(void **handle) const override {
         *handle = data_.get();
@@ -77,6 +96,10 @@ public:
         return std::unique_ptr<memory_storage_t>(sub_storage);
     }
 
+    // Maps `size` bytes of a file starting at `offset` read-only and shared
+    // between processes. The mapping is released with the storage.
+    status_t init_file_mapping(const char *path, size_t offset, size_t size);
+
     std::unique_ptr<memory_storage_t> clone() const override {
         auto storage = new cpu_memory_storage_t(engine());
         if (storage)
@@ -86,14 +109,42 @@ public:
 
 protected:
     status_t init_allocate(size_t size) override {
-        void *ptr = malloc(size, platform::get_cache_line_size());
+        const int alignment = platform::get_cache_line_size();
+        // Memory debug relies on the buffer layout of the library allocator.
+        if (allocator_.is_user_defined() && !memory_debug::is_mem_debug()) {
+            void *ptr = allocator_.alloc(
+                    size, alignment, usage_, allocator_.context);
+            if (!ptr) return status::out_of_memory;
+            const auto allocator = allocator_;
+            const auto usage = usage_;
+            data_ = decltype(data_)(ptr, [=](void *p) {
+                allocator.free(p, usage, allocator.context);
+            });
+            return status::success;
+        }
+
+        bool is_mapped = false;
+        if (void *ptr = platform::malloc_hugepages(size, is_mapped)) {
+            platform::bind_to_numa_node(ptr, size, numa_node_);
+            data_ = decltype(data_)(ptr, [=](void *p) {
+                platform::free_hugepages(p, size, is_mapped);
+            });
+            return status::success;
+        }
+
+        void *ptr = malloc(size, alignment);
         if (!ptr) return status::out_of_memory;
+        platform::bind_to_numa_node(ptr, size, numa_node_);
         data_ = decltype(data_)(ptr, destroy);
         return status::success;
     }
 
 private:
-    std::unique_ptr<void, void (*)(void *)> data_;
+    std::unique_ptr<void, std::function<void(void *)>> data_;
+    cpu_allocator_t allocator_;
+    dnnl_allocation_usage_t usage_;
+    // The NUMA node buffers allocated by the library are placed on, or -1.
+    int numa_node_;
 
     DNNL_DISALLOW_COPY_AND_ASSIGN(cpu_memory_storage_t);
 
@@ -27,6 +27,8 @@
 #include "common/dnnl_thread.hpp"
 #include "common/stream.hpp"
 
+#include "cpu/cpu_engine.hpp"
+
 namespace dnnl {
 namespace impl {
 namespace cpu {
@@ -44,17 +46,39 @@ struct cpu_stream_t : public stream_t {
     cpu_stream_t(engine_t *engine,
             dnnl::threadpool_interop::threadpool_iface *threadpool)
         : stream_t(engine, threadpool) {}
+#endif
 
     void before_exec_hook() override {
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
         dnnl::threadpool_interop::threadpool_iface *tp;
         auto rc = this->get_threadpool(&tp);
         if (rc == status::success) threadpool_utils::activate_threadpool(tp);
+#endif
+        const auto &affinity = engine<cpu_engine_t>()->affinity();
+        if (affinity.is_set()) set_cpu_affinity(&affinity);
+        // The stream limit and the number of cores of a bound engine narrow
+        // the limit of the calling thread, so that the threads of a region
+        // do not share cores.
+        prev_max_threads_limit_ = get_max_threads_limit();
+        int limit = prev_max_threads_limit_;
+        const auto narrow = [&](int nthr) {
+            if (nthr > 0) limit = limit > 0 ? nstl::min(limit, nthr) : nthr;
+        };
+        narrow(max_threads_);
+        narrow((int)affinity.cores().size());
+        if (limit != prev_max_threads_limit_) set_max_threads_limit(limit);
     }
 
     void after_exec_hook() override {
+        set_max_threads_limit(prev_max_threads_limit_);
+        set_cpu_affinity(nullptr);
+#if DNNL_CPU_RUNTIME == DNNL_RUNTIME_THREADPOOL
         threadpool_utils::deactivate_threadpool();
-    }
 #endif
+    }
+
+private:
+    int prev_max_threads_limit_ = 0;
 };
 
 } // namespace cpu
@@ -46,7 +46,7 @@ status_t gemm_f32_matmul_t::pd_t::init(engine_t *engine) {
                 || (weights_md(1)->data_type == f32 && is_bias_1xN());
     };
 
-    bool ok = src_md()->data_type == src_type
+    bool ok = !is_grouped() && src_md()->data_type == src_type
             && weights_md()->data_type == weights_type
             && desc()->accum_data_type == acc_type
             && dst_md()->data_type == dst_type && check_bias()
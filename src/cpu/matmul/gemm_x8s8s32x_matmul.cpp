@@ -87,7 +87,7 @@ status_t gemm_x8s8s32x_matmul_t::pd_t::init(engine_t *engine) {
                                 *this));
     };
 
-    bool ok = one_of(src_md()->data_type, s8, u8)
+    bool ok = !is_grouped() && one_of(src_md()->data_type, s8, u8)
             && weights_md()->data_type == s8 && desc()->accum_data_type == s32
             && one_of(dst_md()->data_type, f32, s32, s8, u8)
             && IMPLICATION(with_bias(),
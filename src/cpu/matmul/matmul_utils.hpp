@@ -17,6 +17,8 @@
 #ifndef CPU_MATMUL_UTILS_HPP
 #define CPU_MATMUL_UTILS_HPP
 
+#include <algorithm>
+
 #include "common/memory_desc_wrapper.hpp"
 #include "common/utils.hpp"
 
@@ -136,6 +138,20 @@ private:
     mdw_t dst_md_;
 };
 
+// Grouped matmul: checks that the offsets are non-decreasing and split all
+// the M rows into G groups.
+inline bool group_offsets_ok(const int32_t *offsets, dim_t G, dim_t M) {
+    if (offsets[0] != 0 || offsets[G] != M) return false;
+    for (dim_t g = 0; g < G; ++g)
+        if (offsets[g] > offsets[g + 1]) return false;
+    return true;
+}
+
+// Grouped matmul: returns the index of the group the row `m` belongs to.
+inline dim_t get_group_idx(const int32_t *offsets, dim_t G, dim_t m) {
+    return std::upper_bound(offsets, offsets + G + 1, m) - offsets - 1;
+}
+
 } // namespace matmul
 } // namespace cpu
 } // namespace impl
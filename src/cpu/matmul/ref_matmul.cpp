@@ -25,6 +25,7 @@
 
 #include "cpu/cpu_primitive.hpp"
 #include "cpu/ref_io_helper.hpp"
+#include "cpu/simple_q10n.hpp"
 
 #include "cpu/matmul/matmul_utils.hpp"
 #include "cpu/matmul/ref_matmul.hpp"
@@ -43,6 +44,7 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
     CHECK(status);
 
     DEFINE_SCALES_BUFFER(scales);
+    DEFINE_ZERO_POINT_VALUE(weights_zero_point, DNNL_ARG_WEIGHTS);
 
     const auto src_d = ctx.memory_mdw(DNNL_ARG_SRC, pd()->src_md());
     const auto weights_d = ctx.memory_mdw(DNNL_ARG_WEIGHTS, pd()->weights_md());
@@ -59,6 +61,15 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
     const dim_t K = helper.K();
     const dim_t batch = helper.batch();
 
+    const bool is_grouped = pd()->is_grouped();
+    const dim_t G = pd()->G();
+    const auto group_offsets = is_grouped
+            ? CTX_IN_MEM(const int32_t *, DNNL_ARG_GROUP_OFFSETS)
+            : nullptr;
+    if (is_grouped && !group_offsets_ok(group_offsets, G, M))
+        return status::invalid_arguments;
+    const int wei_ndims = weights_d.ndims();
+
     const int src_mask
             = utils::get_dims_mask(dst_d.dims(), src_d.dims(), ndims);
     const int wei_mask
@@ -66,35 +77,62 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
     const int bia_mask
             = utils::get_dims_mask(dst_d.dims(), bia_d.dims(), ndims);
 
+    // src rows are quantized to s8 with a scale of 127 / absmax of the row
+    const bool with_src_dyn_quant
+            = pd()->attr()->src_dyn_quant_dt_ != data_type::undef;
+
     // mm kernel
-    auto ker = [&](const dims_t dst_dims_idx, dim_t m, dim_t n) {
+    auto ker = [&](const dims_t dst_dims_idx, dim_t m, dim_t n, dim_t g) {
         float acc = 0;
         dims_t src_dims_idx, weights_dims_idx;
         utils::copy_dims_with_mask(src_dims_idx, dst_dims_idx, ndims, src_mask);
         utils::copy_dims_with_mask(
                 weights_dims_idx, dst_dims_idx, ndims, wei_mask);
+        if (is_grouped) weights_dims_idx[0] = g;
         src_dims_idx[ndims - 2] = m;
-        weights_dims_idx[ndims - 1] = n;
+        weights_dims_idx[wei_ndims - 1] = n;
         auto &src_k_dim = src_dims_idx[ndims - 1];
-        auto &wei_k_dim = weights_dims_idx[ndims - 2];
+        auto &wei_k_dim = weights_dims_idx[wei_ndims - 2];
+        float src_qscale = 1.f, row_scale = 1.f;
+        if (with_src_dyn_quant) {
+            float amax = 0.f;
+            for (dim_t k = 0; k < K; ++k) {
+                src_k_dim = k;
+                const auto src_off = src_d.off_v(src_dims_idx);
+                amax = nstl::max(amax,
+                        nstl::abs(io::load_float_value(
+                                src_d.data_type(), src, src_off)));
+            }
+            src_qscale = amax > 0.f ? 127.f / amax : 0.f;
+            row_scale = amax / 127.f;
+        }
         for (dim_t k = 0; k < K; ++k) {
             src_k_dim = k;
             wei_k_dim = k;
             const auto src_off = src_d.off_v(src_dims_idx);
             const auto weights_off = weights_d.off_v(weights_dims_idx);
-            const float s
-                    = io::load_float_value(src_d.data_type(), src, src_off);
+            float s = io::load_float_value(src_d.data_type(), src, src_off);
+            if (with_src_dyn_quant)
+                s = (float)saturate_and_round<int8_t>(s * src_qscale);
             const float w = io::load_float_value(
-                    weights_d.data_type(), weights, weights_off);
+                                    weights_d.data_type(), weights, weights_off)
+                    - weights_zero_point;
             acc += s * w;
         }
-        return acc;
+        return acc * row_scale;
     };
 
     // bias section
-    auto ker_bias = [&](const dims_t &dst_dims_idx) -> float {
+    auto ker_bias = [&](const dims_t &dst_dims_idx, dim_t g) -> float {
         dims_t bia_dims_idx;
-        utils::copy_dims_with_mask(bia_dims_idx, dst_dims_idx, ndims, bia_mask);
+        if (is_grouped) {
+            const auto &bia_dims = bia_d.dims();
+            bia_dims_idx[0] = bia_dims[0] == 1 ? 0 : g;
+            bia_dims_idx[1] = 0;
+            bia_dims_idx[2] = bia_dims[2] == 1 ? 0 : dst_dims_idx[1];
+        } else
+            utils::copy_dims_with_mask(
+                    bia_dims_idx, dst_dims_idx, ndims, bia_mask);
         const auto bias_off = bia_d.off_v(bia_dims_idx);
         return io::load_float_value(bia_d.data_type(), bias, bias_off);
     };
@@ -110,8 +148,9 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
         // account for M, N dims for index calculations
         const size_t l_offset = mb * M * N + m * N + n;
         utils::l_dims_by_l_offset(dst_dims_idx, l_offset, dst_d.dims(), ndims);
-        float d = ker(dst_dims_idx, m, n);
-        if (bias) d += ker_bias(dst_dims_idx);
+        const dim_t g = is_grouped ? get_group_idx(group_offsets, G, m) : 0;
+        float d = ker(dst_dims_idx, m, n, g);
+        if (bias) d += ker_bias(dst_dims_idx, g);
 
         const auto dst_off = dst_d.off_v(dst_dims_idx);
         if (non_default_attrs) {
@@ -49,10 +49,27 @@ struct ref_matmul_t : public primitive_t {
             const auto bia_type = weights_md(1)->data_type;
             const auto dst_type = dst_md(0)->data_type;
 
+            // src rows are quantized to s8 to be multiplied by s8 weights
+            const bool with_src_dyn_quant
+                    = attr()->src_dyn_quant_dt_ != data_type::undef;
+            // s8 weights with a zero point are dequantized on the fly
+            const bool is_wei_decompression
+                    = !with_src_dyn_quant && wei_type == s8;
+            const auto zp_skip_mask = is_wei_decompression
+                    ? smask_t::zero_points_runtime
+                    : smask_t::none;
+            const auto dyn_quant_skip_mask = with_src_dyn_quant
+                    ? smask_t::src_dyn_quant
+                    : smask_t::none;
+
             bool ok = utils::one_of(src_type, f32, bf16)
-                    && utils::one_of(wei_type, f32, bf16)
+                    && utils::one_of(wei_type, f32, bf16, s8)
                     && utils::one_of(dst_type, f32, bf16)
-                    && src_type == wei_type
+                    && (src_type == wei_type || is_wei_decompression
+                            || with_src_dyn_quant)
+                    && IMPLICATION(with_src_dyn_quant,
+                            wei_type == s8
+                                    && attr()->src_dyn_quant_dt_ == s8)
                     && IMPLICATION(src_type == f32, dst_type == f32)
                     && IMPLICATION(with_bias(),
                             utils::one_of(bia_type, f32, bf16)
@@ -60,10 +77,12 @@ struct ref_matmul_t : public primitive_t {
                                             src_type == f32, bia_type == f32))
                     && platform::has_data_type_support(src_type)
                     && attr()->has_default_values(smask_t::oscale_runtime
-                                    | smask_t::post_ops | smask_t::sum_dt,
+                                    | smask_t::post_ops | smask_t::sum_dt
+                                    | zp_skip_mask | dyn_quant_skip_mask,
                             dst_type)
                     && attr_.post_ops_.check_sum_consistent_dt(dst_type)
-                    && attr_oscale_ok() && set_default_formats()
+                    && attr_oscale_ok() && attr_zero_points_ok()
+                    && set_default_formats()
                     && attr_.set_default_formats(dst_md(0)) == status::success;
             return ok ? status::success : status::unimplemented;
         }
@@ -74,6 +93,14 @@ struct ref_matmul_t : public primitive_t {
             const auto &oscale = attr()->output_scales_;
             return oscale.mask_ == 0 || oscale.mask_ == (1 << (batched() + 1));
         }
+
+        // only a common zero point of weights is supported
+        bool attr_zero_points_ok() const {
+            const auto &zp = attr()->zero_points_;
+            return zp.has_default_values(DNNL_ARG_SRC)
+                    && zp.has_default_values(DNNL_ARG_DST)
+                    && zp.common(DNNL_ARG_WEIGHTS);
+        }
     };
 
     ref_matmul_t(const pd_t *apd) : primitive_t(apd) {}
@@ -63,6 +63,15 @@ status_t ref_matmul_int8_t::execute_ref(const exec_ctx_t &ctx) const {
     const dim_t K = helper.K();
     const dim_t batch = helper.batch();
 
+    const bool is_grouped = pd()->is_grouped();
+    const dim_t G = pd()->G();
+    const auto group_offsets = is_grouped
+            ? CTX_IN_MEM(const int32_t *, DNNL_ARG_GROUP_OFFSETS)
+            : nullptr;
+    if (is_grouped && !group_offsets_ok(group_offsets, G, M))
+        return status::invalid_arguments;
+    const int wei_ndims = weights_d.ndims();
+
     const int src_mask
             = utils::get_dims_mask(dst_d.dims(), src_d.dims(), ndims);
     const int wei_mask
@@ -77,16 +86,17 @@ status_t ref_matmul_int8_t::execute_ref(const exec_ctx_t &ctx) const {
             = !pd()->attr()->zero_points_.common(DNNL_ARG_DST);
 
     // mm kernel
-    auto ker = [&](const dims_t dst_dims_idx, dim_t m, dim_t n) {
+    auto ker = [&](const dims_t dst_dims_idx, dim_t m, dim_t n, dim_t g) {
         int acc = 0;
         dims_t src_dims_idx, weights_dims_idx;
         utils::copy_dims_with_mask(src_dims_idx, dst_dims_idx, ndims, src_mask);
         utils::copy_dims_with_mask(
                 weights_dims_idx, dst_dims_idx, ndims, wei_mask);
+        if (is_grouped) weights_dims_idx[0] = g;
         src_dims_idx[ndims - 2] = m;
-        weights_dims_idx[ndims - 1] = n;
+        weights_dims_idx[wei_ndims - 1] = n;
         auto &src_k_dim = src_dims_idx[ndims - 1];
-        auto &wei_k_dim = weights_dims_idx[ndims - 2];
+        auto &wei_k_dim = weights_dims_idx[wei_ndims - 2];
         for (dim_t k = 0; k < K; ++k) {
             src_k_dim = k;
             wei_k_dim = k;
@@ -107,9 +117,16 @@ status_t ref_matmul_int8_t::execute_ref(const exec_ctx_t &ctx) const {
     };
 
     // bias section
-    auto ker_bias = [&](const dims_t &dst_dims_idx) -> float {
+    auto ker_bias = [&](const dims_t &dst_dims_idx, dim_t g) -> float {
         dims_t bia_dims_idx;
-        utils::copy_dims_with_mask(bia_dims_idx, dst_dims_idx, ndims, bia_mask);
+        if (is_grouped) {
+            const auto &bia_dims = bia_d.dims();
+            bia_dims_idx[0] = bia_dims[0] == 1 ? 0 : g;
+            bia_dims_idx[1] = 0;
+            bia_dims_idx[2] = bia_dims[2] == 1 ? 0 : dst_dims_idx[1];
+        } else
+            utils::copy_dims_with_mask(
+                    bia_dims_idx, dst_dims_idx, ndims, bia_mask);
         const auto bias_off = bia_d.off_v(bia_dims_idx);
         return io::load_float_value(bia_d.data_type(), bias, bias_off);
     };
@@ -125,9 +142,10 @@ status_t ref_matmul_int8_t::execute_ref(const exec_ctx_t &ctx) const {
         // account for M, N dims for index calculations
         const size_t l_offset = mb * M * N + m * N + n;
         utils::l_dims_by_l_offset(dst_dims_idx, l_offset, dst_d.dims(), ndims);
-        int acc = ker(dst_dims_idx, m, n);
+        const dim_t g = is_grouped ? get_group_idx(group_offsets, G, m) : 0;
+        int acc = ker(dst_dims_idx, m, n, g);
         float d = static_cast<int>(acc);
-        if (bias) d += ker_bias(dst_dims_idx);
+        if (bias) d += ker_bias(dst_dims_idx, g);
 
         const auto dst_off = dst_d.off_v(dst_dims_idx);
         if (non_default_attrs) {
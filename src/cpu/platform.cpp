@@ -15,8 +15,10 @@
 * limitations under the License.
 *******************************************************************************/
 
-#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_WORK_STEALING
 #include <algorithm>
+#include <thread>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -25,6 +27,22 @@
 #endif
 #endif
 
+#if defined(__linux__)
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#endif
+
+#include "common/memory_debug.hpp"
+#include "common/utils.hpp"
+
 #include "cpu/platform.hpp"
 
 #if DNNL_X64
@@ -88,6 +106,190 @@ dnnl_cpu_isa_hints_t get_cpu_isa_hints() {
 #endif
 }
 
+namespace {
+setting_t<int> hugepages_mode {dnnl_cpu_hugepages_none};
+
+bool is_valid_hugepages_mode(int mode) {
+    return utils::one_of(mode, dnnl_cpu_hugepages_none, dnnl_cpu_hugepages_thp,
+            dnnl_cpu_hugepages_hugetlb);
+}
+
+// The default huge page size on x86-64 and on AArch64 with 4K base pages.
+constexpr size_t hugepage_size = 2 * 1024 * 1024;
+} // namespace
+
+status_t set_hugepages_mode(dnnl_cpu_hugepages_mode_t mode) {
+    if (!is_valid_hugepages_mode(mode)) return status::invalid_arguments;
+#if !defined(__linux__)
+    if (mode != dnnl_cpu_hugepages_none) return status::unimplemented;
+#endif
+    hugepages_mode.set(mode);
+    return status::success;
+}
+
+dnnl_cpu_hugepages_mode_t get_hugepages_mode() {
+#if defined(__linux__)
+    const int env_mode = getenv_int("DNNL_CPU_HUGEPAGES", hugepages_mode.get());
+    if (is_valid_hugepages_mode(env_mode)) hugepages_mode.set(env_mode, true);
+    return static_cast<dnnl_cpu_hugepages_mode_t>(hugepages_mode.get());
+#else
+    return dnnl_cpu_hugepages_none;
+#endif
+}
+
+void *malloc_hugepages(size_t size, bool &is_mapped) {
+    is_mapped = false;
+#if defined(__linux__)
+    // Memory debug relies on the buffer layout of the library allocator.
+    if (size < hugepage_size || memory_debug::is_mem_debug()) return nullptr;
+
+    const auto mode = get_hugepages_mode();
+    if (mode == dnnl_cpu_hugepages_none) return nullptr;
+
+    const size_t alloc_size = utils::rnd_up(size, hugepage_size);
+#ifdef MAP_HUGETLB
+    if (mode == dnnl_cpu_hugepages_hugetlb) {
+        void *ptr = mmap(nullptr, alloc_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr != MAP_FAILED) {
+            is_mapped = true;
+            return ptr;
+        }
+    }
+#endif
+
+    void *ptr = nullptr;
+    if (::posix_memalign(&ptr, hugepage_size, alloc_size) != 0) return nullptr;
+#ifdef MADV_HUGEPAGE
+    // The advice is ignored if transparent huge pages are disabled, in
+    // which case the buffer is still valid.
+    madvise(ptr, alloc_size, MADV_HUGEPAGE);
+#endif
+    return ptr;
+#else
+    UNUSED(size);
+    return nullptr;
+#endif
+}
+
+void free_hugepages(void *ptr, size_t size, bool is_mapped) {
+#if defined(__linux__)
+    if (is_mapped)
+        munmap(ptr, utils::rnd_up(size, hugepage_size));
+    else
+        ::free(ptr);
+#else
+    UNUSED(ptr);
+    UNUSED(size);
+    UNUSED(is_mapped);
+#endif
+}
+
+namespace {
+#if defined(__linux__)
+// Reads a list of CPUs or NUMA nodes in the sysfs format, e.g. "0-3,8,10-11".
+std::vector<int> read_sysfs_list(const std::string &path) {
+    std::vector<int> list;
+    std::ifstream ifs(path);
+    std::string str;
+    if (!std::getline(ifs, str)) return list;
+
+    std::istringstream iss(str);
+    std::string range;
+    while (std::getline(iss, range, ',')) {
+        int first = -1, last = -1;
+        const int n = sscanf(range.c_str(), "%d-%d", &first, &last);
+        if (n < 1 || first < 0) return {};
+        if (n == 1) last = first;
+        for (int i = first; i <= last; i++)
+            list.push_back(i);
+    }
+    return list;
+}
+#endif
+
+// Nodes beyond the mask used with mbind() are not supported.
+constexpr int max_numa_nodes = 1024;
+} // namespace
+
+std::vector<int> get_numa_node_cores(int numa_node) {
+#if defined(__linux__)
+    if (numa_node < 0 || numa_node >= max_numa_nodes) return {};
+    return read_sysfs_list("/sys/devices/system/node/node"
+            + std::to_string(numa_node) + "/cpulist");
+#else
+    UNUSED(numa_node);
+    return {};
+#endif
+}
+
+int get_numa_node(const std::vector<int> &cores) {
+#if defined(__linux__)
+    if (cores.empty()) return -1;
+    for (int node : read_sysfs_list("/sys/devices/system/node/online")) {
+        const auto node_cores = get_numa_node_cores(node);
+        const bool has_all = std::all_of(
+                cores.begin(), cores.end(), [&](int core) {
+                    return std::find(node_cores.begin(), node_cores.end(),
+                                   core)
+                            != node_cores.end();
+                });
+        if (has_all) return node;
+    }
+#else
+    UNUSED(cores);
+#endif
+    return -1;
+}
+
+int get_current_numa_node() {
+#if defined(__linux__)
+    // The topology is read once. Unlike the getcpu system call,
+    // sched_getcpu() is served by the vDSO and does not enter the kernel.
+    static const std::vector<int> core_to_node = []() {
+        std::vector<int> map;
+        for (int node : read_sysfs_list("/sys/devices/system/node/online"))
+            for (int core : get_numa_node_cores(node)) {
+                if ((size_t)core >= map.size()) map.resize(core + 1, 0);
+                map[core] = node;
+            }
+        return map;
+    }();
+    const int core = sched_getcpu();
+    if (core >= 0 && (size_t)core < core_to_node.size())
+        return core_to_node[core];
+#endif
+    return 0;
+}
+
+void bind_to_numa_node(void *ptr, size_t size, int numa_node) {
+#if defined(__linux__) && defined(SYS_mbind)
+    if (numa_node < 0 || numa_node >= max_numa_nodes) return;
+
+    // Only whole pages of the buffer can have a memory policy.
+    const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    const uintptr_t start = utils::rnd_up((uintptr_t)ptr, page_size);
+    const uintptr_t end = utils::rnd_dn((uintptr_t)ptr + size, page_size);
+    if (start >= end) return;
+
+    constexpr int bits = 8 * sizeof(unsigned long);
+    unsigned long mask[max_numa_nodes / bits] = {};
+    mask[numa_node / bits] = 1UL << (numa_node % bits);
+    // Values from <numaif.h>, which comes with libnuma.
+    const int mpol_preferred = 1;
+    const unsigned mpol_mf_move = 1 << 1;
+    // Pages are allocated on the node when first touched, and the pages that
+    // were touched already are moved. The policy is a hint, so a failure
+    // leaves the buffer valid and is ignored.
+    syscall(SYS_mbind, start, end - start, mpol_preferred, mask,
+            max_numa_nodes + 1, mpol_mf_move);
+#else
+    UNUSED(ptr);
+    UNUSED(size);
+    UNUSED(numa_node);
+#endif
+}
+
 bool prefer_ymm_requested() {
 #if DNNL_X64
     const bool prefer_ymm = x64::get_cpu_isa_hints() == dnnl_cpu_isa_prefer_ymm;
@@ -150,9 +352,11 @@ unsigned get_num_cores() {
 #endif
 }
 
-#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_WORK_STEALING
 // The purpose of this function is to return the potential maximum number of
-// threads in user's threadpool. It is assumed that the number of threads in an
+// threads in user's threadpool. The work-stealing runtime uses it as the
+// default size of its pool. It is assumed that the number of threads in an
 // actual threadpool will not exceed the number cores in a socket reported by
 // the OS, which may or may not be equal to the number of total physical cores
 // in a socket depending on the OS configuration (read -- VM environment). In
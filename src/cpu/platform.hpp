@@ -18,6 +18,8 @@
 #ifndef CPU_PLATFORM_HPP
 #define CPU_PLATFORM_HPP
 
+#include <vector>
+
 #include "oneapi/dnnl/dnnl_config.h"
 
 #include "common/c_types_map.hpp"
@@ -103,13 +105,34 @@ status_t set_max_cpu_isa(dnnl_cpu_isa_t isa);
 status_t set_cpu_isa_hints(dnnl_cpu_isa_hints_t isa_hints);
 dnnl_cpu_isa_hints_t get_cpu_isa_hints();
 
+status_t set_hugepages_mode(dnnl_cpu_hugepages_mode_t mode);
+dnnl_cpu_hugepages_mode_t get_hugepages_mode();
+// Allocates a buffer backed by huge pages according to the huge pages mode.
+// Returns nullptr if huge pages are not used for a buffer of this size or the
+// allocation failed. A non-null buffer must be freed with free_hugepages()
+// called with the same size and the returned `is_mapped` value.
+void *malloc_hugepages(size_t size, bool &is_mapped);
+void free_hugepages(void *ptr, size_t size, bool is_mapped);
+
+// Returns the cores of a NUMA node, or an empty list if the node does not
+// exist or the topology is unknown.
+std::vector<int> get_numa_node_cores(int numa_node);
+// Returns the NUMA node all the cores belong to, or -1.
+int get_numa_node(const std::vector<int> &cores);
+// Returns the NUMA node of the core the calling thread runs on, or 0 if it
+// is unknown. Cheap enough to be called on every primitive execution.
+int get_current_numa_node();
+// Sets the preferred NUMA node of the pages of a buffer.
+void bind_to_numa_node(void *ptr, size_t size, int numa_node);
+
 bool DNNL_API prefer_ymm_requested();
 bool DNNL_API has_data_type_support(data_type_t data_type);
 float DNNL_API s8s8_weights_scale_factor();
 
-unsigned get_per_core_cache_size(int level);
+unsigned DNNL_API get_per_core_cache_size(int level);
 unsigned get_num_cores();
-#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL \
+        || DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_WORK_STEALING
 unsigned DNNL_API get_max_threads_to_use();
 #endif
 
@@ -106,6 +106,7 @@ void brgemm_kernel_execute_postops(const brgemm_kernel_t *brg_kernel, int bs,
     brgemm_p.a_zp_compensations = post_ops_data.a_zp_compensations;
     brgemm_p.b_zp_compensations = post_ops_data.b_zp_compensations;
     brgemm_p.c_zp_values = post_ops_data.c_zp_values;
+    brgemm_p.row_scales = post_ops_data.row_scales;
     (*brg_kernel)(&brgemm_p);
 }
 
@@ -137,30 +138,41 @@ void brgemm_kernel_execute_postops(const brgemm_kernel_t *brg_kernel, int bs,
 namespace {
 status_t brgemm_blocking(brgemm_t *brg) {
     if (!brg->is_int8_amx && !brg->is_bf16_amx) {
-        brg->ld_block = 16;
+        const bool is_ymm = brg->is_ymm();
+        brg->ld_block = is_ymm ? 8 : 16;
         brg->ldb = brg->load_dim / brg->ld_block;
         brg->ldb_tail = brg->load_dim % brg->ld_block;
 
-        brg->ld_block2 = 4; // (M < 9) ? 2 : 4 | TODO - fix this for INT8
+        // (M < 9) ? 2 : 4 | TODO - fix this for INT8
+        brg->ld_block2 = is_ymm ? 2 : 4;
         brg->ldb2 = brg->ldb / brg->ld_block2;
         brg->ldb2_tail = brg->ldb % brg->ld_block2;
 
         if (brg->ldb2 == 0) brg->ld_block2 = nstl::max(1, brg->ldb2_tail);
-        brg->embd_bcst = !brg->is_int8 && !brg->is_bf16
+        brg->embd_bcst = !is_ymm && !brg->is_int8 && !brg->is_bf16
                 && (brg->ldb2_tail <= 1 && brg->ldb2 == 0);
 
         int ld_block = (brg->ldb2 != 0) ? brg->ld_block2 : brg->ldb2_tail;
         int adj_ld_block = (ld_block == 0) ? (ld_block + 1) : ld_block;
 
-        const int max_avx512_regs = 32;
-        const int max_bcst_regs = 1;
-        int max_regs = max_avx512_regs - (adj_ld_block + max_bcst_regs);
-        int max_block
-                = (brg->embd_bcst ? 28
-                                  : ((brg->beta == 1.f || brg->beta == 0.f)
-                                                  ? max_regs
-                                                  : max_regs - 1));
-        max_block -= brg->req_s8s8_compensation;
+        int max_block = 0;
+        if (is_ymm) {
+            // the avx2 kernel reserves three vector registers for the
+            // broadcast, the input shift and the post-ops temporaries
+            const int max_avx2_regs = 16;
+            const int max_reserved_regs = 3;
+            max_block = max_avx2_regs - (adj_ld_block + max_reserved_regs);
+        } else {
+            const int max_avx512_regs = 32;
+            const int max_bcst_regs = 1;
+            int max_regs = max_avx512_regs - (adj_ld_block + max_bcst_regs);
+            max_block = (brg->embd_bcst
+                            ? 28
+                            : ((brg->beta == 1.f || brg->beta == 0.f)
+                                            ? max_regs
+                                            : max_regs - 1));
+            max_block -= brg->req_s8s8_compensation;
+        }
         max_block /= adj_ld_block;
         int min_block = 1;
         float best_bd_block_eff = 0.f;
@@ -392,32 +404,58 @@ status_t brgemm_desc_init(brgemm_t *brg, cpu_isa_t isa,
     brg->dt_d = brg->dt_c;
     brg->dt_bias = brg->dt_c;
 
-    if (!IMPLICATION(brg->is_f32, mayiuse(avx512_core)))
-        return status::unimplemented;
-    if (!IMPLICATION(brg->is_bf16, mayiuse(avx512_core_bf16)))
-        return status::unimplemented;
-    if (!IMPLICATION(brg->is_int8, mayiuse(avx512_core_vnni)))
-        return status::unimplemented;
+    if (isa != isa_any
+            && !one_of(isa, avx2, avx2_vnni, avx512_core, avx512_core_bf16,
+                    avx512_core_vnni, avx512_core_bf16_amx_bf16,
+                    avx512_core_bf16_amx_int8))
+        return status::invalid_arguments;
 
-    if (isa != isa_any) {
-        if (!one_of(isa, avx512_core, avx512_core_bf16, avx512_core_vnni,
-                    avx512_core_bf16_amx_bf16, avx512_core_bf16_amx_int8)) {
-            return status::invalid_arguments;
-        }
-        brg->is_int8_amx = brg->is_bf16_amx = false;
-        if (brg->is_int8 && isa == avx512_core_bf16_amx_int8) {
-            if (!mayiuse(avx512_core_bf16_amx_int8))
-                return status::invalid_arguments;
-            brg->is_int8_amx = true;
-        }
-        if (brg->is_bf16 && isa == avx512_core_bf16_amx_bf16) {
-            if (!mayiuse(avx512_core_bf16_amx_bf16))
-                return status::invalid_arguments;
-            brg->is_bf16_amx = true;
+    const bool use_avx512 = isa == isa_any ? mayiuse(avx512_core)
+                                           : is_superset(isa, avx512_core);
+    if (use_avx512) {
+        if (!IMPLICATION(brg->is_f32, mayiuse(avx512_core)))
+            return status::unimplemented;
+        if (!IMPLICATION(brg->is_bf16, mayiuse(avx512_core_bf16)))
+            return status::unimplemented;
+        if (!IMPLICATION(brg->is_int8, mayiuse(avx512_core_vnni)))
+            return status::unimplemented;
+
+        if (isa != isa_any) {
+            brg->is_int8_amx = brg->is_bf16_amx = false;
+            if (brg->is_int8 && isa == avx512_core_bf16_amx_int8) {
+                if (!mayiuse(avx512_core_bf16_amx_int8))
+                    return status::invalid_arguments;
+                brg->is_int8_amx = true;
+            }
+            if (brg->is_bf16 && isa == avx512_core_bf16_amx_bf16) {
+                if (!mayiuse(avx512_core_bf16_amx_bf16))
+                    return status::invalid_arguments;
+                brg->is_bf16_amx = true;
+            }
+        } else {
+            brg->is_int8_amx
+                    = brg->is_int8 && mayiuse(avx512_core_bf16_amx_int8);
+            brg->is_bf16_amx
+                    = brg->is_bf16 && mayiuse(avx512_core_bf16_amx_bf16);
         }
+        brg->isa_impl = brg->is_int8_amx
+                ? avx512_core_bf16_amx_int8
+                : brg->is_bf16_amx
+                        ? avx512_core_bf16_amx_bf16
+                        : brg->is_int8 ? avx512_core_vnni
+                                       : brg->is_bf16 ? avx512_core_bf16
+                                                      : avx512_core;
     } else {
-        brg->is_int8_amx = brg->is_int8 && mayiuse(avx512_core_bf16_amx_int8);
-        brg->is_bf16_amx = brg->is_bf16 && mayiuse(avx512_core_bf16_amx_bf16);
+        // avx2 kernels work on ymm registers without opmasks: f32 is
+        // computed with fma and int8 with the vex-encoded vpdpbusd
+        if (brg->is_bf16) return status::unimplemented;
+        if (!IMPLICATION(brg->is_f32, mayiuse(avx2)))
+            return status::unimplemented;
+        if (!IMPLICATION(brg->is_int8,
+                    one_of(isa, isa_any, avx2_vnni) && mayiuse(avx2_vnni)))
+            return status::unimplemented;
+        brg->is_int8_amx = brg->is_bf16_amx = false;
+        brg->isa_impl = brg->is_int8 ? avx2_vnni : avx2;
     }
     brg->is_amx = (brg->is_int8_amx || brg->is_bf16_amx);
     brg->req_s8s8_compensation
@@ -599,6 +637,9 @@ status_t brgemm_desc_set_postops(brgemm_t *brg, const primitive_attr_t *attr,
             && (!one_of(dt_bias, data_type::undef, data_type::f32)))
         return status::unimplemented;
 
+    // there is no bf16 conversion instruction on avx2
+    if (brg->is_ymm() && dt_d == data_type::bf16) return status::unimplemented;
+
     brg->dt_d = dt_d;
     brg->typesize_D = types::data_type_size(brg->dt_d);
 
@@ -611,7 +652,7 @@ status_t brgemm_desc_set_postops(brgemm_t *brg, const primitive_attr_t *attr,
 
     const int binary_ind = post_ops.find(primitive_kind::binary);
     brg->with_binary = binary_ind != -1;
-    const cpu_isa_t isa = get_max_cpu_isa();
+    const cpu_isa_t isa = brg->is_ymm() ? avx2 : get_max_cpu_isa();
 
     if ((brg->with_binary && !dst_md)
             || !injector::post_ops_ok(
@@ -671,6 +712,8 @@ status_t brgemm_desc_set_postops(brgemm_t *brg, const primitive_attr_t *attr,
     init_zp_type(brg->zp_type_b, DNNL_ARG_WEIGHTS);
     init_zp_type(brg->zp_type_c, DNNL_ARG_DST);
 
+    brg->with_row_scales = attr->src_dyn_quant_dt_ != data_type::undef;
+
     return status::success;
 }
 
@@ -714,6 +757,10 @@ status_t brgemm_desc_set_attr(brgemm_t *brg, const brgemm_attr_t &brgattr) {
 
 status_t brgemm_kernel_create(
         brgemm_kernel_t **brg_kernel, const brgemm_t &brg) {
+    // scales of A rows are supported by the common kernel only
+    if (brg.with_row_scales && (brg.is_dgmm || brg.brgattr.use_uker))
+        return status::unimplemented;
+
     if (brg.is_dgmm) {
         CHECK(safe_ptr_assign<brgemm_kernel_t>(
                 *brg_kernel, new brdgmm_kernel_t(brg)));
@@ -724,8 +771,12 @@ status_t brgemm_kernel_create(
                 *brg_kernel, new brgemm_amx_uker_t(brg)));
         return (*brg_kernel)->create_kernel();
     } else {
-        CHECK(safe_ptr_assign<brgemm_kernel_t>(
-                *brg_kernel, new brgemm_kernel_common_t(brg)));
+        if (brg.is_ymm())
+            CHECK(safe_ptr_assign<brgemm_kernel_t>(*brg_kernel,
+                    new brgemm_kernel_common_t<avx2, Xbyak::Ymm>(brg)));
+        else
+            CHECK(safe_ptr_assign<brgemm_kernel_t>(*brg_kernel,
+                    new brgemm_kernel_common_t<avx512_core, Xbyak::Zmm>(brg)));
         return (*brg_kernel)->create_kernel();
     }
 }
@@ -19,6 +19,7 @@
 
 #include "common/primitive_attr.hpp"
 #include "cpu/platform.hpp"
+#include "cpu/x64/cpu_isa_traits.hpp"
 
 namespace dnnl {
 namespace impl {
@@ -162,6 +163,8 @@ struct brgemm_t {
     bool is_bf16 = false, is_bf16_amx = false;
     bool is_f32 = false;
     bool is_amx = false;
+    // ISA the kernel is generated for, set in brgemm_desc_init
+    cpu_isa_t isa_impl = isa_any;
 
     dim_t stride_a = 0; // Offset in bytes
     dim_t stride_b = 0;
@@ -183,6 +186,8 @@ struct brgemm_t {
     brgemm_broadcast_t zp_type_a = brgemm_broadcast_t::none;
     brgemm_broadcast_t zp_type_b = brgemm_broadcast_t::none;
     brgemm_broadcast_t zp_type_c = brgemm_broadcast_t::none;
+    // A is dynamically quantized, each row of C is multiplied by its scale
+    bool with_row_scales = false;
 
     int is_oc_scale = 0;
 
@@ -193,6 +198,10 @@ struct brgemm_t {
     static constexpr int MAX_VPAD = 100;
 
     int is_M_tail;
+
+    bool is_ymm() const noexcept {
+        return utils::one_of(isa_impl, avx2, avx2_vnni);
+    }
     // Tile register decomposition
     int get_ld_block2() const noexcept {
         return (ldb_tail) ? ld_block2 + 1 : ld_block2;
@@ -240,8 +249,10 @@ struct brgemm_kernel_params_t {
     const void *b_zp_compensations = nullptr;
     const void *c_zp_values = nullptr;
     size_t skip_accm = 0;
+    const void *row_scales = nullptr;
 };
 
+template <cpu_isa_t isa, typename Vmm>
 struct jit_brgemm_kernel_t;
 struct jit_brgemm_amx_uker_base_t;
 struct jit_brdgmm_kernel_base_t;
@@ -253,6 +264,7 @@ struct brgemm_kernel_t {
     virtual void operator()(brgemm_kernel_params_t *) const = 0;
 };
 
+template <cpu_isa_t isa, typename Vmm>
 struct brgemm_kernel_common_t : public brgemm_kernel_t {
     brgemm_kernel_common_t(const brgemm_t abrd);
     ~brgemm_kernel_common_t();
@@ -261,7 +273,7 @@ struct brgemm_kernel_common_t : public brgemm_kernel_t {
     void operator()(brgemm_kernel_params_t *) const;
 
 private:
-    jit_brgemm_kernel_t *brgemm_kernel_ = nullptr;
+    jit_brgemm_kernel_t<isa, Vmm> *brgemm_kernel_ = nullptr;
 
     DNNL_DISALLOW_COPY_AND_ASSIGN(brgemm_kernel_common_t);
 };
@@ -308,6 +320,7 @@ private:
 /// @param c_zp_values - C matrix zero point values.
 /// @param skip_accumulation - specifies whether to skip accumulation when
 ///    computing post-ops.
+/// @param row_scales - Scales of the rows of dynamically quantized A matrix.
 ///
 struct brgemm_post_ops_data_t {
     brgemm_post_ops_data_t() = default;
@@ -317,7 +330,8 @@ struct brgemm_post_ops_data_t {
             const size_t first_mb_matrix_addr_off = 0,
             const void *a_zp_compensations = nullptr,
             const void *b_zp_compensations = nullptr,
-            const void *c_zp_values = nullptr, bool skip_accumulation = false)
+            const void *c_zp_values = nullptr, bool skip_accumulation = false,
+            const float *row_scales = nullptr)
         : bias(bias)
         , scales(scales)
         , binary_post_ops_rhs(binary_post_ops_rhs)
@@ -328,7 +342,8 @@ struct brgemm_post_ops_data_t {
         , a_zp_compensations(a_zp_compensations)
         , b_zp_compensations(b_zp_compensations)
         , c_zp_values(c_zp_values)
-        , skip_accumulation(skip_accumulation) {}
+        , skip_accumulation(skip_accumulation)
+        , row_scales(row_scales) {}
 
     const void *bias = nullptr;
     const float *scales = nullptr;
@@ -341,6 +356,7 @@ struct brgemm_post_ops_data_t {
     const void *b_zp_compensations = nullptr;
     const void *c_zp_values = nullptr;
     const bool skip_accumulation = false;
+    const float *row_scales = nullptr;
 };
 
 } // namespace x64
@@ -37,9 +37,11 @@ namespace x64 {
 using namespace dnnl::impl::utils;
 using namespace Xbyak;
 
+template <cpu_isa_t isa, typename Vmm>
 struct jit_brgemm_kernel_t : public jit_generator {
     jit_brgemm_kernel_t(const brgemm_t &abrg)
-        : jit_generator(nullptr, MAX_CODE_SIZE, true, avx512_common)
+        : jit_generator(nullptr, MAX_CODE_SIZE, true,
+                abrg.is_ymm() ? abrg.isa_impl : avx512_common)
         , brg(abrg)
         , postops_injector_(nullptr) {
 
@@ -61,7 +63,7 @@ struct jit_brgemm_kernel_t : public jit_generator {
                             broadcasting_strategy_t::per_mb_spatial,
                             broadcasting_strategy_t::no_broadcast};
             const binary_injector::rhs_arg_static_params_t rhs_sp {
-                    static_cast<size_t>(Xbyak::Zmm(1).getIdx()), this->rdx,
+                    static_cast<size_t>(Vmm(1).getIdx()), this->rdx,
                     this->r10, preserve_gpr, preserve_vmm,
                     GET_OFF(post_ops_binary_rhs_arg_vec), dst_md_wrapper,
                     static_cast<size_t>(brg.ldb_tail), ld_tail_mask,
@@ -70,7 +72,7 @@ struct jit_brgemm_kernel_t : public jit_generator {
                     this->param1, enabled_bcast_strategy, rhs_sp};
 
             postops_injector_ = utils::make_unique<
-                    injector::jit_uni_postops_injector_t<avx512_core>>(
+                    injector::jit_uni_postops_injector_t<isa, Vmm>>(
                     this, brg.attr->post_ops_, bsp);
 
             using namespace dnnl::impl::cpu::binary_injector_utils;
@@ -92,7 +94,7 @@ struct jit_brgemm_kernel_t : public jit_generator {
     brgemm_t brg;
 
 private:
-    std::unique_ptr<injector::jit_uni_postops_injector_t<avx512_core>>
+    std::unique_ptr<injector::jit_uni_postops_injector_t<isa, Vmm>>
             postops_injector_;
 
     using reg64_t = const Xbyak::Reg64;
@@ -146,6 +148,8 @@ private:
     const reg64_t reg_aux_zp_comp_b = reg_rdb_loop;
     const reg64_t reg_zp_c_values = reg_rdb_loop;
     const reg64_t reg_aux_zp_c_values = reg_rdb_loop;
+    const reg64_t reg_row_scales = reg_rdb_loop;
+    const reg64_t reg_aux_row_scales = reg_rdb_loop;
 
     const reg64_t reg_aux_scales = reg_aux_B;
     const reg64_t reg_do_post_ops = reg_rdb_loop;
@@ -188,7 +192,9 @@ private:
     constexpr static int reg_aux_zp_c_values_offs_ = 176;
     constexpr static int reg_data_C_ptr_ = 184;
     constexpr static int reg_skip_accm_offs_ = 192;
-    constexpr static int stack_space_needed_ = 200;
+    constexpr static int reg_row_scales_offs_ = 200;
+    constexpr static int reg_aux_row_scales_offs_ = 208;
+    constexpr static int stack_space_needed_ = 216;
 
     bool is_ldb_loop_ = false;
     bool handle_binary_po_offset_ = false;
@@ -200,40 +206,42 @@ private:
     Xbyak::Opmask ld_full_mask = Xbyak::Opmask(2);
     Xbyak::Opmask ld_tail_mask = Xbyak::Opmask(3);
 
-    Xbyak::Zmm accm(int ld_block, int bd, int ld) {
-        return Xbyak::Zmm(31 - (bd * ld_block + ld));
+    static constexpr int max_vregs = cpu_isa_traits<isa>::n_vregs;
+
+    Vmm accm(int ld_block, int bd, int ld) {
+        return Vmm(max_vregs - 1 - (bd * ld_block + ld));
     }
 
-    Xbyak::Zmm bcst(int bd = 0) {
+    Vmm bcst(int bd = 0) {
         if (n_bcast_1_load) {
-            int idx = 31 - (brg.ld_block2 * brg.bd_block) - bd;
+            int idx = max_vregs - 1 - (brg.ld_block2 * brg.bd_block) - bd;
             assert(idx > 0);
-            return Xbyak::Zmm(idx);
+            return Vmm(idx);
         } else
-            return this->zmm0;
+            return Vmm(0);
     }
 
-    Xbyak::Zmm load(int ld = 0) {
+    Vmm load(int ld = 0) {
         if (n_bcast_1_load) {
-            return this->zmm0;
+            return Vmm(0);
         } else {
-            int idx = 31 - (brg.ld_block2 * brg.bd_block) - ld;
+            int idx = max_vregs - 1 - (brg.ld_block2 * brg.bd_block) - ld;
             assert(idx > 0);
-            return Xbyak::Zmm(idx);
+            return Vmm(idx);
         }
     }
 
-    const Xbyak::Zmm &zmm_tmp_1() const noexcept { return this->zmm0; }
-    const Xbyak::Zmm &zmm_tmp_2() const noexcept { return this->zmm1; }
-    const Xbyak::Zmm &zmm_tmp_3() const noexcept { return this->zmm2; }
-    const Xbyak::Zmm &zmm_inp_shift() const noexcept { return this->zmm1; }
+    Vmm vmm_tmp_1() const noexcept { return Vmm(0); }
+    Vmm vmm_tmp_2() const noexcept { return Vmm(1); }
+    Vmm vmm_tmp_3() const noexcept { return Vmm(2); }
+    Vmm vmm_inp_shift() const noexcept { return Vmm(1); }
 
-    Xbyak::Zmm zmm_mask(const Xbyak::Zmm zmm_in, bool mask_flag, bool store,
+    Vmm vmm_mask(const Vmm vmm_in, bool mask_flag, bool store,
             Xbyak::Opmask ktail_mask) const;
     Xbyak::Ymm ymm_mask(const Xbyak::Ymm ymm_in, bool mask_flag, bool store,
             Xbyak::Opmask ktail_mask) const;
 
-    void cvt2ps(data_type_t type_in, const Xbyak::Zmm zmm_in,
+    void cvt2ps(data_type_t type_in, const Vmm vmm_in,
             const Xbyak::Operand &op, bool mask_flag, bool store,
             Xbyak::Opmask ktail_mask);
 
@@ -301,107 +309,149 @@ private:
     int zp_comp_a_offset(int ld, bool is_tail = false) const noexcept;
     int zp_comp_b_offset(int bd) const noexcept;
     int bdb_zp_comp_b_offset(int bd_block2) const noexcept;
+    int row_scales_offset(int bd) const noexcept;
+    int bdb_row_scales_offset(int bd_block2) const noexcept;
     int zp_c_values_offset(int ld, bool is_tail = false) const noexcept;
 
     bool n_bcast_1_load = false;
     bool vpad_exist = false;
 };
 
-int jit_brgemm_kernel_t::A_offset(int bd, int rd, bool is_amx) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::A_offset(
+        int bd, int rd, bool is_amx) const noexcept {
     return (is_amx) ? brg.typesize_A * (bd * brg.bd_block * brg.LDA)
                     : brg.typesize_A * (bd * brg.LDA + rd);
 }
-int jit_brgemm_kernel_t::B_offset(int ld, int rd, bool is_amx) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::B_offset(
+        int ld, int rd, bool is_amx) const noexcept {
     return (is_amx)
             ? brg.typesize_B * (brg.rd_step * ld * brg.ld_block)
             : brg.typesize_B * (rd * brg.LDB + brg.rd_step * ld * brg.ld_block);
 }
-int jit_brgemm_kernel_t::C_offset(int bd, int ld) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::C_offset(int bd, int ld) const noexcept {
     return brg.typesize_C * (bd * brg.LDC + ld * brg.ld_block);
 }
-int jit_brgemm_kernel_t::D_offset(int bd, int ld) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::D_offset(int bd, int ld) const noexcept {
     return brg.typesize_D * (bd * brg.LDD + ld * brg.ld_block);
 }
-int jit_brgemm_kernel_t::po_offset(int bd, int ld) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::po_offset(int bd, int ld) const noexcept {
     return bd * brg.LDD + ld * brg.ld_block;
 }
 
-int jit_brgemm_kernel_t::rdb_A_offset() const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::rdb_A_offset() const noexcept {
     return brg.typesize_A * brg.rd_block;
 }
-int jit_brgemm_kernel_t::rdb_B_offset() const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::rdb_B_offset() const noexcept {
     return brg.typesize_B * brg.rd_block * brg.LDB;
 }
 
-int jit_brgemm_kernel_t::ldb_B_offset(int ld_block2, bool is_tail) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::ldb_B_offset(
+        int ld_block2, bool is_tail) const noexcept {
     return (is_tail) ? brg.typesize_B * brg.ldb_tail * brg.ld_step
                      : brg.typesize_B * ld_block2 * brg.ld_block * brg.ld_step;
 }
-int jit_brgemm_kernel_t::ldb_C_offset(int ld_block2, bool is_tail) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::ldb_C_offset(
+        int ld_block2, bool is_tail) const noexcept {
     return (is_tail) ? brg.typesize_C * brg.ldb_tail
                      : brg.typesize_C * ld_block2 * brg.ld_block;
 }
-int jit_brgemm_kernel_t::ldb_D_offset(int ld_block2, bool is_tail) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::ldb_D_offset(
+        int ld_block2, bool is_tail) const noexcept {
     return (is_tail) ? brg.typesize_D * brg.ldb_tail
                      : brg.typesize_D * ld_block2 * brg.ld_block;
 }
-int jit_brgemm_kernel_t::ldb_po_offset(int ld_block2, bool is_tail) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::ldb_po_offset(
+        int ld_block2, bool is_tail) const noexcept {
     return (is_tail) ? brg.ldb_tail : ld_block2 * brg.ld_block;
 }
 
-int jit_brgemm_kernel_t::bdb_A_offset(int bd_block2) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bdb_A_offset(int bd_block2) const noexcept {
     return brg.typesize_A * bd_block2 * brg.bd_block * brg.LDA;
 }
-int jit_brgemm_kernel_t::bdb_C_offset(int bd_block2) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bdb_C_offset(int bd_block2) const noexcept {
     return brg.typesize_C * bd_block2 * brg.bd_block * brg.LDC;
 }
-int jit_brgemm_kernel_t::bdb_D_offset(int bd_block2) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bdb_D_offset(int bd_block2) const noexcept {
     return brg.typesize_D * bd_block2 * brg.bd_block * brg.LDD;
 }
-int jit_brgemm_kernel_t::bdb_po_offset(int bd_block2) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bdb_po_offset(int bd_block2) const noexcept {
     return bd_block2 * brg.bd_block * brg.LDD;
 }
 
-int jit_brgemm_kernel_t::bias_offset(int ld, bool is_tail) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bias_offset(
+        int ld, bool is_tail) const noexcept {
     return (is_tail) ? brg.typesize_bias * brg.ldb_tail
                      : brg.typesize_bias * ld * brg.ld_block;
 }
 
-int jit_brgemm_kernel_t::oc_logical_offset(int ld, bool is_tail) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::oc_logical_offset(
+        int ld, bool is_tail) const noexcept {
     return (is_tail) ? brg.ldb_tail : ld * brg.ld_block;
 }
 
-int jit_brgemm_kernel_t::compensations_offset(int ld, bool is_tail) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::compensations_offset(
+        int ld, bool is_tail) const noexcept {
     return (is_tail) ? sizeof(int32_t) * brg.ldb_tail
                      : sizeof(int32_t) * ld * brg.ld_block;
 }
 
-int jit_brgemm_kernel_t::scales_offset(int ld, bool is_tail) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::scales_offset(
+        int ld, bool is_tail) const noexcept {
     return (is_tail) ? brg.is_oc_scale * sizeof(float) * brg.ldb_tail
                      : brg.is_oc_scale * sizeof(float) * ld * brg.ld_block;
 }
 
-int jit_brgemm_kernel_t::zp_comp_a_offset(int ld, bool is_tail) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::zp_comp_a_offset(
+        int ld, bool is_tail) const noexcept {
     return (is_tail) ? sizeof(int32_t) * brg.ldb_tail
                      : sizeof(int32_t) * ld * brg.ld_block;
 }
 
-int jit_brgemm_kernel_t::zp_comp_b_offset(int bd) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::zp_comp_b_offset(int bd) const noexcept {
     return sizeof(int32_t) * bd;
 }
 
-int jit_brgemm_kernel_t::bdb_zp_comp_b_offset(int bd_block2) const noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bdb_zp_comp_b_offset(
+        int bd_block2) const noexcept {
     return zp_comp_b_offset(bd_block2 * brg.bd_block);
 }
 
-int jit_brgemm_kernel_t::zp_c_values_offset(int ld, bool is_tail) const
-        noexcept {
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::row_scales_offset(int bd) const noexcept {
+    return sizeof(float) * bd;
+}
+
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::bdb_row_scales_offset(
+        int bd_block2) const noexcept {
+    return row_scales_offset(bd_block2 * brg.bd_block);
+}
+
+template <cpu_isa_t isa, typename Vmm>
+int jit_brgemm_kernel_t<isa, Vmm>::zp_c_values_offset(
+        int ld, bool is_tail) const noexcept {
     if (brg.zp_type_c == brgemm_broadcast_t::per_n) {
         return (is_tail) ? sizeof(int32_t) * brg.ldb_tail
                          : sizeof(int32_t) * ld * brg.ld_block;
@@ -410,38 +460,58 @@ int jit_brgemm_kernel_t::zp_c_values_offset(int ld, bool is_tail) const
     return 0;
 }
 
-Xbyak::Zmm jit_brgemm_kernel_t::zmm_mask(const Xbyak::Zmm zmm_in,
-        bool mask_flag, bool store, Xbyak::Opmask ktail_mask) const {
-    return mask_flag ? (store ? zmm_in | ktail_mask : zmm_in | ktail_mask | T_z)
-                     : zmm_in;
+template <cpu_isa_t isa, typename Vmm>
+Vmm jit_brgemm_kernel_t<isa, Vmm>::vmm_mask(const Vmm vmm_in, bool mask_flag,
+        bool store, Xbyak::Opmask ktail_mask) const {
+    return mask_flag ? (store ? vmm_in | ktail_mask : vmm_in | ktail_mask | T_z)
+                     : vmm_in;
 }
 
-Xbyak::Ymm jit_brgemm_kernel_t::ymm_mask(const Xbyak::Ymm ymm_in,
+template <cpu_isa_t isa, typename Vmm>
+Xbyak::Ymm jit_brgemm_kernel_t<isa, Vmm>::ymm_mask(const Xbyak::Ymm ymm_in,
         bool mask_flag, bool store, Xbyak::Opmask ktail_mask) const {
     return mask_flag ? (store ? ymm_in | ktail_mask : ymm_in | ktail_mask | T_z)
                      : ymm_in;
 }
 
-void jit_brgemm_kernel_t::cvt2ps(data_type_t type_in, const Xbyak::Zmm zmm_in,
-        const Xbyak::Operand &op, bool mask_flag, bool store,
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::cvt2ps(data_type_t type_in,
+        const Vmm vmm_in, const Xbyak::Operand &op, bool mask_flag, bool store,
         Xbyak::Opmask ktail_mask) {
-    const Xbyak::Zmm zmm = zmm_mask(zmm_in, mask_flag, store, ktail_mask);
+    if (mask_flag && brg.is_ymm()) {
+        // no opmasks on avx2: load only the ldb_tail elements
+        const Xbyak::Ymm ymm(vmm_in.getIdx());
+        const Xbyak::Address &addr = op.getAddress();
+        if (type_in == data_type::bf16) {
+            load_bytes(ymm, addr,
+                    types::data_type_size(type_in) * brg.ldb_tail);
+            vpmovzxwd(ymm, Xbyak::Xmm(ymm.getIdx()));
+            vpslld(ymm, ymm, 16);
+        } else
+            load_data(type_in, ymm, addr, brg.ldb_tail);
+        if (!one_of(type_in, data_type::f32, data_type::bf16))
+            vcvtdq2ps(vmm_in, vmm_in);
+        return;
+    }
+
+    const Vmm vmm = vmm_mask(vmm_in, mask_flag, store, ktail_mask);
     switch (type_in) {
         case data_type::f32:
-        case data_type::s32: vmovups(zmm, op); break;
+        case data_type::s32: vmovups(vmm, op); break;
         case data_type::bf16:
-            vpmovzxwd(zmm, op);
-            vpslld(zmm, zmm, 16);
+            vpmovzxwd(vmm, op);
+            vpslld(vmm, vmm, 16);
             break;
-        case data_type::s8: vpmovsxbd(zmm, op); break;
-        case data_type::u8: vpmovzxbd(zmm, op); break;
+        case data_type::s8: vpmovsxbd(vmm, op); break;
+        case data_type::u8: vpmovzxbd(vmm, op); break;
         default: assert(!"unsupported data type");
     }
     if (!one_of(type_in, data_type::f32, data_type::bf16))
-        vcvtdq2ps(zmm_in, zmm_in);
+        vcvtdq2ps(vmm_in, vmm_in);
 }
 
-void jit_brgemm_kernel_t::advance_ldb_post_op_regs() {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::advance_ldb_post_op_regs() {
     if (brg.with_bias) {
         mov(reg_aux_bias, ptr[rsp + reg_aux_bias_offs_]);
         add(reg_aux_bias, bias_offset(1));
@@ -471,7 +541,8 @@ void jit_brgemm_kernel_t::advance_ldb_post_op_regs() {
     }
 }
 
-void jit_brgemm_kernel_t::restore_ldb_post_op_regs(int ld_block2) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::restore_ldb_post_op_regs(int ld_block2) {
     if (brg.with_bias) {
         mov(reg_aux_bias, ptr[rsp + reg_aux_bias_offs_]);
         sub(reg_aux_bias, bias_offset(ld_block2 - 1));
@@ -501,12 +572,18 @@ void jit_brgemm_kernel_t::restore_ldb_post_op_regs(int ld_block2) {
     }
 }
 
-void jit_brgemm_kernel_t::advance_bdb_post_op_regs(int adj_bd_block) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::advance_bdb_post_op_regs(int adj_bd_block) {
     if (brg.zp_type_b != brgemm_broadcast_t::none) {
         mov(reg_aux_zp_comp_b, ptr[rsp + reg_aux_zp_comp_b_offs_]);
         add(reg_aux_zp_comp_b, bdb_zp_comp_b_offset(1));
         mov(ptr[rsp + reg_aux_zp_comp_b_offs_], reg_aux_zp_comp_b);
     }
+    if (brg.with_row_scales) {
+        mov(reg_aux_row_scales, ptr[rsp + reg_aux_row_scales_offs_]);
+        add(reg_aux_row_scales, bdb_row_scales_offset(1));
+        mov(ptr[rsp + reg_aux_row_scales_offs_], reg_aux_row_scales);
+    }
     if (with_binary_per_oc_sp_bcast_) {
         const injector_utils::register_preserve_guard_t register_guard(
                 this, {reg_aux_binary_postops_oc_l});
@@ -520,7 +597,8 @@ void jit_brgemm_kernel_t::advance_bdb_post_op_regs(int adj_bd_block) {
     }
 }
 
-void jit_brgemm_kernel_t::restore_bdb_post_op_regs(int bd_block2) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::restore_bdb_post_op_regs(int bd_block2) {
     bool post_processed = false;
     if (bd_block2 > 1) {
         if (brg.zp_type_b != brgemm_broadcast_t::none) {
@@ -529,6 +607,12 @@ void jit_brgemm_kernel_t::restore_bdb_post_op_regs(int bd_block2) {
             sub(reg_aux_zp_comp_b, bdb_zp_comp_b_offset(bd_block2 - 1));
             mov(ptr[rsp + reg_aux_zp_comp_b_offs_], reg_aux_zp_comp_b);
         }
+        if (brg.with_row_scales) {
+            post_processed = true;
+            mov(reg_aux_row_scales, ptr[rsp + reg_aux_row_scales_offs_]);
+            sub(reg_aux_row_scales, bdb_row_scales_offset(bd_block2 - 1));
+            mov(ptr[rsp + reg_aux_row_scales_offs_], reg_aux_row_scales);
+        }
         if (with_binary_per_oc_sp_bcast_) {
             post_processed = true;
             const injector_utils::register_preserve_guard_t register_guard(
@@ -545,7 +629,9 @@ void jit_brgemm_kernel_t::restore_bdb_post_op_regs(int bd_block2) {
     if (post_processed) mov(reg_buf, ptr[rsp + reg_buf_offs_]);
 }
 
-void jit_brgemm_kernel_t::ldb_regs_shift(int ld_block2, bool is_tail) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::ldb_regs_shift(
+        int ld_block2, bool is_tail) {
     int C_offset = (is_tail) ? ldb_C_offset(1, true) : ldb_C_offset(ld_block2);
     int D_offset = (is_tail) ? ldb_D_offset(1, true) : ldb_D_offset(ld_block2);
     add(reg_aux_C, C_offset);
@@ -607,7 +693,9 @@ void jit_brgemm_kernel_t::ldb_regs_shift(int ld_block2, bool is_tail) {
     }
 }
 
-void jit_brgemm_kernel_t::advance_bd_block2_post_op_regs(int bd_block2) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::advance_bd_block2_post_op_regs(
+        int bd_block2) {
     if (with_binary_per_oc_sp_bcast_) {
         mov(reg_aux_binary_postops_oc_l,
                 ptr[rsp + reg_binary_postops_oc_l_offs_]);
@@ -625,9 +713,16 @@ void jit_brgemm_kernel_t::advance_bd_block2_post_op_regs(int bd_block2) {
         add(reg_zp_comp_b, bdb_zp_comp_b_offset(bd_block2));
         mov(ptr[rsp + reg_zp_comp_b_offs_], reg_zp_comp_b);
     }
+    if (brg.with_row_scales) {
+        mov(reg_row_scales, ptr[rsp + reg_row_scales_offs_]);
+        add(reg_row_scales, bdb_row_scales_offset(bd_block2));
+        mov(ptr[rsp + reg_row_scales_offs_], reg_row_scales);
+    }
 }
 
-void jit_brgemm_kernel_t::copy_post_ops_stack_values_to_aux(bool is_reg_tail) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::copy_post_ops_stack_values_to_aux(
+        bool is_reg_tail) {
     if (!is_reg_tail) {
         mov(reg_aux_C, reg_C);
         mov(reg_aux_D, reg_D);
@@ -671,6 +766,10 @@ void jit_brgemm_kernel_t::copy_post_ops_stack_values_to_aux(bool is_reg_tail) {
         mov(reg_zp_comp_b, ptr[rsp + reg_zp_comp_b_offs_]);
         mov(ptr[rsp + reg_aux_zp_comp_b_offs_], reg_zp_comp_b);
     }
+    if (brg.with_row_scales) {
+        mov(reg_row_scales, ptr[rsp + reg_row_scales_offs_]);
+        mov(ptr[rsp + reg_aux_row_scales_offs_], reg_row_scales);
+    }
     if (with_binary_per_oc_sp_bcast_) {
         mov(reg_aux_binary_postops_oc_l,
                 ptr[rsp + reg_binary_postops_oc_l_offs_]);
@@ -679,7 +778,8 @@ void jit_brgemm_kernel_t::copy_post_ops_stack_values_to_aux(bool is_reg_tail) {
     }
 }
 
-void jit_brgemm_kernel_t::read_params() {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::read_params() {
     Label label_done;
 
     if (brg.with_binary) mov(ptr[rsp + abi_param1_offs_], param1);
@@ -756,6 +856,11 @@ void jit_brgemm_kernel_t::read_params() {
         mov(ptr[rsp + reg_zp_c_values_offs_], reg_zp_c_values);
     }
 
+    if (brg.with_row_scales) {
+        mov(reg_row_scales, ptr[param1 + GET_OFF(row_scales)]);
+        mov(ptr[rsp + reg_row_scales_offs_], reg_row_scales);
+    }
+
     mov(reg_do_post_ops, ptr[param1 + GET_OFF(do_post_ops)]);
     mov(ptr[rsp + reg_do_post_ops_offs_], reg_do_post_ops);
 
@@ -763,8 +868,10 @@ void jit_brgemm_kernel_t::read_params() {
     mov(ptr[rsp + reg_skip_accm_offs_], reg_skip_accm);
 }
 
-void jit_brgemm_kernel_t::zero_accumulators(int bd_block2, bool is_bdb_tail,
-        int ld_block2, bool is_ld_tail, bool skip_accumulation) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::zero_accumulators(int bd_block2,
+        bool is_bdb_tail, int ld_block2, bool is_ld_tail,
+        bool skip_accumulation) {
     if (brg.is_amx) {
         // avoid usage of tile registers if there is no accumulation
         if (skip_accumulation) return;
@@ -777,18 +884,19 @@ void jit_brgemm_kernel_t::zero_accumulators(int bd_block2, bool is_bdb_tail,
         int bd_block = (is_bdb_tail) ? brg.bdb_tail : brg.bd_block;
         for_(int bd = 0; bd < bd_block; bd++)
         for (int ld = 0; ld < ld_block2; ld++) {
-            auto zmm = accm(ld_block2, bd, ld);
-            vxorps(zmm, zmm, zmm);
+            auto vmm = accm(ld_block2, bd, ld);
+            vxorps(vmm, vmm, vmm);
         }
     }
 }
 
-void jit_brgemm_kernel_t::apply_alpha_beta(
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::apply_alpha_beta(
         int bd_block, int ld_block2, bool is_ld_tail) {
     auto k_mask = (!is_ld_tail) ? ld_full_mask : ld_tail_mask;
-    auto zmm_beta = zmm_tmp_1();
-    auto zmm_alpha = zmm_tmp_2();
-    auto zmm_prev_dst = zmm_tmp_3();
+    auto vmm_beta = vmm_tmp_1();
+    auto vmm_alpha = vmm_tmp_2();
+    auto vmm_prev_dst = vmm_tmp_3();
 
     const bool apply_alpha = brg.alpha != 1.f;
     const bool apply_beta = brg.beta != 0.f;
@@ -799,36 +907,48 @@ void jit_brgemm_kernel_t::apply_alpha_beta(
 
     if (apply_beta && !use_vadd_for_beta) {
         mov(reg_tmp_gpr, float2int(static_cast<float>(brg.beta)));
-        movq(Xmm(zmm_beta.getIdx()), reg_tmp_gpr);
-        vbroadcastss(zmm_beta, Xmm(zmm_beta.getIdx()));
+        movq(Xmm(vmm_beta.getIdx()), reg_tmp_gpr);
+        vbroadcastss(vmm_beta, Xmm(vmm_beta.getIdx()));
     }
     if (apply_alpha) {
         mov(reg_tmp_gpr, float2int(static_cast<float>(brg.alpha)));
-        movq(Xmm(zmm_alpha.getIdx()), reg_tmp_gpr);
-        vbroadcastss(zmm_alpha, Xmm(zmm_alpha.getIdx()));
+        movq(Xmm(vmm_alpha.getIdx()), reg_tmp_gpr);
+        vbroadcastss(vmm_alpha, Xmm(vmm_alpha.getIdx()));
     }
     for_(int bd = 0; bd < bd_block; bd++)
     for (int ld = 0; ld < ld_block2; ld++) {
-        auto zmm = accm(ld_block2, bd, ld);
-        if (dq2ps_required) vcvtdq2ps(zmm, zmm);
-        if (apply_alpha) vmulps(zmm, zmm, zmm_alpha);
+        auto vmm = accm(ld_block2, bd, ld);
+        if (dq2ps_required) vcvtdq2ps(vmm, vmm);
+        if (apply_alpha) vmulps(vmm, vmm, vmm_alpha);
         if (apply_beta) {
             auto ptr_C = ptr[reg_aux_C + C_offset(bd, ld)];
-            if (use_vadd_for_beta) {
-                auto zmm_masked = zmm | k_mask | T_z;
+            if (use_vadd_for_beta && brg.is_ymm()) {
+                if (is_ld_tail)
+                    load_bytes(Xbyak::Ymm(vmm_prev_dst.getIdx()), ptr_C,
+                            brg.typesize_C * brg.ldb_tail);
+                else
+                    vmovups(vmm_prev_dst, ptr_C);
+                if (brg.is_int8)
+                    vpaddd(vmm, vmm, vmm_prev_dst);
+                else
+                    vaddps(vmm, vmm, vmm_prev_dst);
+            } else if (use_vadd_for_beta) {
+                auto vmm_masked = vmm | k_mask | T_z;
                 if (brg.is_int8)
-                    vpaddd(zmm_masked, zmm, ptr_C);
+                    vpaddd(vmm_masked, vmm, ptr_C);
                 else
-                    vaddps(zmm_masked, zmm, ptr_C);
+                    vaddps(vmm_masked, vmm, ptr_C);
             } else {
-                cvt2ps(brg.dt_c, zmm_prev_dst, ptr_C, true, false, k_mask);
-                vfmadd231ps(zmm, zmm_prev_dst, zmm_beta);
+                cvt2ps(brg.dt_c, vmm_prev_dst, ptr_C, is_ld_tail, false,
+                        k_mask);
+                vfmadd231ps(vmm, vmm_prev_dst, vmm_beta);
             }
         }
     }
 }
 
-void jit_brgemm_kernel_t::apply_post_ops(
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::apply_post_ops(
         int bd_block, int ld_block2, int ldb_and_bdb_offset, bool is_ld_tail) {
 
     binary_injector::rhs_arg_dynamic_params_t rhs_arg_params;
@@ -844,32 +964,32 @@ void jit_brgemm_kernel_t::apply_post_ops(
 
             for_(int bd = 0; bd < bd_block; bd++)
             for (int ld = 0; ld < ld_block2; ld++) {
-                const auto zmm_idx = accm(ld_block2, bd, ld).getIdx();
-                rhs_arg_params.vmm_idx_to_oc_elem_off_addr.emplace(zmm_idx,
+                const auto vmm_idx = accm(ld_block2, bd, ld).getIdx();
+                rhs_arg_params.vmm_idx_to_oc_elem_off_addr.emplace(vmm_idx,
                         ptr[reg_binary_po_stack_frame
                                 + reg_aux_binary_postops_oc_l_offs_
                                 + guard_space]);
                 if (with_binary_per_oc_bcast_)
                     rhs_arg_params.vmm_idx_to_oc_elem_off_val.emplace(
-                            zmm_idx, oc_logical_offset(ld));
+                            vmm_idx, oc_logical_offset(ld));
                 else if (with_binary_per_oc_sp_bcast_)
                     rhs_arg_params.vmm_idx_to_oc_elem_off_val.emplace(
-                            zmm_idx, bd);
+                            vmm_idx, bd);
                 if (with_binary_channel_bcast_) {
                     rhs_arg_params.vmm_idx_to_sp_elem_off_val.emplace(
-                            zmm_idx, po_offset(bd, ld) + ldb_and_bdb_offset);
-                    rhs_arg_params.vmm_idx_to_sp_elem_off_addr.emplace(zmm_idx,
+                            vmm_idx, po_offset(bd, ld) + ldb_and_bdb_offset);
+                    rhs_arg_params.vmm_idx_to_sp_elem_off_addr.emplace(vmm_idx,
                             ptr[reg_binary_po_stack_frame
                                     + reg_aux_binary_postops_sp_offs_
                                     + guard_space]);
                 }
                 if (with_binary_no_bcast_) {
                     rhs_arg_params.vmm_idx_to_out_elem_off_val.emplace(
-                            zmm_idx, po_offset(bd, ld));
+                            vmm_idx, po_offset(bd, ld));
                     rhs_arg_params.vmm_idx_to_out_off_oprnd.emplace(
-                            zmm_idx, reg_aux_D);
+                            vmm_idx, reg_aux_D);
                 }
-                if (is_ld_tail) rhs_arg_params.vmm_tail_idx_.emplace(zmm_idx);
+                if (is_ld_tail) rhs_arg_params.vmm_tail_idx_.emplace(vmm_idx);
             }
         }
     }
@@ -900,26 +1020,38 @@ void jit_brgemm_kernel_t::apply_post_ops(
             if (p_sum_scale_reg_set)
                 mov(reg_ptr_sum_scale, reinterpret_cast<size_t>(p_sum_scale));
 
-            const auto &zmm_sum_zp = zmm_tmp_2();
+            const auto vmm_sum_zp = vmm_tmp_2();
             if (p_sum_zp_reg_set) {
                 mov(reg_ptr_sum_zp, reinterpret_cast<size_t>(p_sum_zp));
-                vcvtdq2ps(zmm_sum_zp, ptr_b[reg_ptr_sum_zp]);
+                if (brg.is_ymm()) {
+                    vpbroadcastd(vmm_sum_zp, ptr[reg_ptr_sum_zp]);
+                    vcvtdq2ps(vmm_sum_zp, vmm_sum_zp);
+                } else
+                    vcvtdq2ps(vmm_sum_zp, ptr_b[reg_ptr_sum_zp]);
             }
 
+            // ymm has no embedded broadcast, so the scale is kept in a register
+            const auto vmm_sum_scale = vmm_tmp_3();
+            if (p_sum_scale_reg_set && brg.is_ymm())
+                vbroadcastss(vmm_sum_scale, ptr[reg_ptr_sum_scale]);
+
             const auto k_mask = (!is_ld_tail) ? ld_full_mask : ld_tail_mask;
 
             for (int bd = 0; bd < bd_block; bd++) {
                 for (int ld = 0; ld < ld_block2; ld++) {
-                    const auto zmm = accm(ld_block2, bd, ld);
+                    const auto vmm = accm(ld_block2, bd, ld);
                     const auto addr = ptr[reg_aux_D + D_offset(bd, ld)];
-                    const auto zmm_prev_dst = Xbyak::Zmm(0);
-                    cvt2ps(brg.sum_dt, zmm_prev_dst, addr, true, false, k_mask);
-                    if (p_sum_zp_reg_set) vsubps(zmm_prev_dst, zmm_sum_zp);
+                    const auto vmm_prev_dst = Vmm(0);
+                    cvt2ps(brg.sum_dt, vmm_prev_dst, addr, is_ld_tail, false,
+                            k_mask);
+                    if (p_sum_zp_reg_set) vsubps(vmm_prev_dst, vmm_sum_zp);
                     if (!p_sum_scale_reg_set)
-                        vaddps(zmm, zmm_prev_dst);
+                        vaddps(vmm, vmm_prev_dst);
+                    else if (brg.is_ymm())
+                        vfmadd231ps(vmm, vmm_prev_dst, vmm_sum_scale);
                     else
                         vfmadd231ps(
-                                zmm, zmm_prev_dst, zword_b[reg_ptr_sum_scale]);
+                                vmm, vmm_prev_dst, zword_b[reg_ptr_sum_scale]);
                 }
             }
         }
@@ -944,16 +1076,17 @@ void jit_brgemm_kernel_t::apply_post_ops(
                 ptr[reg_binary_po_stack_frame + reg_data_C_ptr_ + guard_space]);
         sar(reg_aux_D, D_shift_val);
         postops_injector_->compute_vector_range(
-                32 - bd_block * ld_block2, 32, rhs_arg_params);
+                max_vregs - bd_block * ld_block2, max_vregs, rhs_arg_params);
         sal(reg_aux_D, D_shift_val);
         add(reg_aux_D,
                 ptr[reg_binary_po_stack_frame + reg_data_C_ptr_ + guard_space]);
     } else
         postops_injector_->compute_vector_range(
-                32 - bd_block * ld_block2, 32, rhs_arg_params);
+                max_vregs - bd_block * ld_block2, max_vregs, rhs_arg_params);
 }
 
-void jit_brgemm_kernel_t::store_accumulators_apply_post_ops(
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::store_accumulators_apply_post_ops(
         int bd_block, int ld_block2, int ldb_and_bdb_offset, bool is_ld_tail) {
     auto k_mask = (!is_ld_tail) ? ld_full_mask : ld_tail_mask;
 
@@ -965,32 +1098,35 @@ void jit_brgemm_kernel_t::store_accumulators_apply_post_ops(
     const bool dq2ps_required = brg.is_int8
             && IMPLICATION(alpha_or_beta_applicable, beta_uses_vadd);
 
-    if (brg.with_bias) { mov(reg_aux_bias, ptr[rsp + reg_aux_bias_offs_]); }
+    auto add_bias = [&](Vmm vmm, int ld) {
+        auto vmm_bias = vmm_tmp_1();
+        auto ptr_bias = ptr[reg_aux_bias + bias_offset(ld)];
+        cvt2ps(brg.dt_bias, vmm_bias, ptr_bias, is_ld_tail, false, k_mask);
+        vaddps(vmm, vmm, vmm_bias);
+    };
+
+    // with scales of A rows the bias is added to the scaled result below
+    const bool add_bias_first = brg.with_bias && !brg.with_row_scales;
+    if (add_bias_first) mov(reg_aux_bias, ptr[rsp + reg_aux_bias_offs_]);
     for_(int bd = 0; bd < bd_block; bd++)
     for (int ld = 0; ld < ld_block2; ld++) {
-        auto zmm = accm(ld_block2, bd, ld);
-        if (dq2ps_required) vcvtdq2ps(zmm, zmm);
-        if (brg.with_bias) {
-            auto zmm_bias = zmm_tmp_1();
-            auto ptr_bias = ptr[reg_aux_bias + bias_offset(ld)];
-            cvt2ps(brg.dt_bias, zmm_bias, ptr_bias, true, false, k_mask);
-            vaddps(zmm, zmm, zmm_bias);
-        }
+        auto vmm = accm(ld_block2, bd, ld);
+        if (dq2ps_required) vcvtdq2ps(vmm, vmm);
+        if (add_bias_first) add_bias(vmm, ld);
     }
 
     if (brg.zp_type_a != brgemm_broadcast_t::none) {
         mov(reg_aux_zp_comp_a, ptr[rsp + reg_aux_zp_comp_a_offs_]);
         for (int ld = 0; ld < ld_block2; ld++) {
-            auto zmm_zp_comp_a = zmm_tmp_1();
+            auto vmm_zp_comp_a = vmm_tmp_1();
             int zp_comp_a_off = zp_comp_a_offset(ld);
-            auto zp_comp_a_addr
-                    = EVEX_compress_addr(reg_aux_zp_comp_a, zp_comp_a_off);
-            cvt2ps(data_type::s32, zmm_zp_comp_a, zp_comp_a_addr, true, false,
-                    k_mask);
+            auto zp_comp_a_addr = ptr[reg_aux_zp_comp_a + zp_comp_a_off];
+            cvt2ps(data_type::s32, vmm_zp_comp_a, zp_comp_a_addr, is_ld_tail,
+                    false, k_mask);
 
             for (int bd = 0; bd < bd_block; bd++) {
-                auto zmm = accm(ld_block2, bd, ld);
-                vaddps(zmm, zmm, zmm_zp_comp_a);
+                auto vmm = accm(ld_block2, bd, ld);
+                vaddps(vmm, vmm, vmm_zp_comp_a);
             }
         }
     }
@@ -998,13 +1134,19 @@ void jit_brgemm_kernel_t::store_accumulators_apply_post_ops(
     if (brg.zp_type_b != brgemm_broadcast_t::none) {
         mov(reg_aux_zp_comp_b, ptr[rsp + reg_aux_zp_comp_b_offs_]);
         for (int bd = 0; bd < bd_block; bd++) {
-            auto zmm_zp_comp_b = zmm_tmp_1();
+            auto vmm_zp_comp_b = vmm_tmp_1();
             int zp_comp_b_off = zp_comp_b_offset(bd);
-            vcvtdq2ps(zmm_zp_comp_b,
-                    EVEX_compress_addr(reg_aux_zp_comp_b, zp_comp_b_off, true));
+            if (brg.is_ymm()) {
+                vpbroadcastd(
+                        vmm_zp_comp_b, ptr[reg_aux_zp_comp_b + zp_comp_b_off]);
+                vcvtdq2ps(vmm_zp_comp_b, vmm_zp_comp_b);
+            } else
+                vcvtdq2ps(vmm_zp_comp_b,
+                        EVEX_compress_addr(
+                                reg_aux_zp_comp_b, zp_comp_b_off, true));
             for (int ld = 0; ld < ld_block2; ld++) {
-                auto zmm = accm(ld_block2, bd, ld);
-                vaddps(zmm, zmm, zmm_zp_comp_b);
+                auto vmm = accm(ld_block2, bd, ld);
+                vaddps(vmm, vmm, vmm_zp_comp_b);
             }
         }
     }
@@ -1012,25 +1154,54 @@ void jit_brgemm_kernel_t::store_accumulators_apply_post_ops(
     if (brg.req_s8s8_compensation) {
         mov(reg_aux_compensation, ptr[rsp + reg_aux_comp_offs_]);
         for (int ld = 0; ld < ld_block2; ld++) {
-            auto zmm_comp = zmm_tmp_1();
+            auto vmm_comp = vmm_tmp_1();
             int comp_offset = compensations_offset(ld);
-            auto comp_addr
-                    = EVEX_compress_addr(reg_aux_compensation, comp_offset);
-            cvt2ps(data_type::s32, zmm_comp, comp_addr, true, false, k_mask);
+            auto comp_addr = ptr[reg_aux_compensation + comp_offset];
+            cvt2ps(data_type::s32, vmm_comp, comp_addr, is_ld_tail, false,
+                    k_mask);
 
             for (int bd = 0; bd < bd_block; bd++) {
-                auto zmm = accm(ld_block2, bd, ld);
-                vaddps(zmm, zmm, zmm_comp);
+                auto vmm = accm(ld_block2, bd, ld);
+                vaddps(vmm, vmm, vmm_comp);
+            }
+        }
+    }
+
+    if (brg.with_row_scales) {
+        mov(reg_aux_row_scales, ptr[rsp + reg_aux_row_scales_offs_]);
+        for (int bd = 0; bd < bd_block; bd++) {
+            auto vmm_row_scale = vmm_tmp_1();
+            vbroadcastss(vmm_row_scale,
+                    ptr[reg_aux_row_scales + row_scales_offset(bd)]);
+            for (int ld = 0; ld < ld_block2; ld++) {
+                auto vmm = accm(ld_block2, bd, ld);
+                vmulps(vmm, vmm, vmm_row_scale);
             }
         }
+        if (brg.with_bias) {
+            mov(reg_aux_bias, ptr[rsp + reg_aux_bias_offs_]);
+            for_(int bd = 0; bd < bd_block; bd++)
+            for (int ld = 0; ld < ld_block2; ld++)
+                add_bias(accm(ld_block2, bd, ld), ld);
+        }
     }
+
     if (brg.with_scales) {
         mov(reg_aux_scales, ptr[rsp + reg_aux_scales_offs_]);
         for (int bd = 0; bd < bd_block; bd++) {
             for (int ld = 0; ld < ld_block2; ld++) {
-                const Xbyak::Zmm zmm = zmm_mask(
-                        accm(ld_block2, bd, ld), true, false, k_mask);
-                vmulps(zmm, zmm, ptr[reg_aux_scales + scales_offset(ld)]);
+                const auto addr = ptr[reg_aux_scales + scales_offset(ld)];
+                if (brg.is_ymm() && is_ld_tail) {
+                    const auto vmm = accm(ld_block2, bd, ld);
+                    const auto vmm_scales = vmm_tmp_1();
+                    load_bytes(Xbyak::Ymm(vmm_scales.getIdx()), addr,
+                            sizeof(float) * brg.ldb_tail);
+                    vmulps(vmm, vmm, vmm_scales);
+                    continue;
+                }
+                const Vmm vmm = vmm_mask(accm(ld_block2, bd, ld),
+                        !brg.is_ymm(), false, k_mask);
+                vmulps(vmm, vmm, addr);
             }
         }
     }
@@ -1040,65 +1211,78 @@ void jit_brgemm_kernel_t::store_accumulators_apply_post_ops(
 
     if (brg.zp_type_c != brgemm_broadcast_t::none) {
         mov(reg_aux_zp_c_values, ptr[rsp + reg_aux_zp_c_values_offs_]);
-        auto zmm_zp_c = zmm_tmp_1();
+        auto vmm_zp_c = vmm_tmp_1();
         if (brg.zp_type_c == brgemm_broadcast_t::per_tensor) {
-            vcvtdq2ps(
-                    zmm_zp_c, EVEX_compress_addr(reg_aux_zp_c_values, 0, true));
+            if (brg.is_ymm()) {
+                vpbroadcastd(vmm_zp_c, ptr[reg_aux_zp_c_values]);
+                vcvtdq2ps(vmm_zp_c, vmm_zp_c);
+            } else
+                vcvtdq2ps(vmm_zp_c,
+                        EVEX_compress_addr(reg_aux_zp_c_values, 0, true));
         }
         for (int ld = 0; ld < ld_block2; ld++) {
             if (brg.zp_type_c == brgemm_broadcast_t::per_n) {
                 int zp_c_off = zp_c_values_offset(ld);
-                auto zp_c_addr
-                        = EVEX_compress_addr(reg_aux_zp_c_values, zp_c_off);
-                cvt2ps(data_type::s32, zmm_zp_c, zp_c_addr, true, false,
+                auto zp_c_addr = ptr[reg_aux_zp_c_values + zp_c_off];
+                cvt2ps(data_type::s32, vmm_zp_c, zp_c_addr, is_ld_tail, false,
                         k_mask);
             }
             for (int bd = 0; bd < bd_block; bd++) {
-                auto zmm = accm(ld_block2, bd, ld);
-                vaddps(zmm, zmm, zmm_zp_c);
+                auto vmm = accm(ld_block2, bd, ld);
+                vaddps(vmm, vmm, vmm_zp_c);
             }
         }
     }
 
     const bool dt_requires_saturation
             = one_of(brg.dt_d, data_type::u8, data_type::s8, data_type::s32);
-    auto zmm_lbound = zmm_tmp_1();
-    auto zmm_ubound = zmm_tmp_2();
+    auto vmm_lbound = vmm_tmp_1();
+    auto vmm_ubound = vmm_tmp_2();
     if (dt_requires_saturation) {
         init_saturate_f32(
-                zmm_lbound, zmm_ubound, reg_tmp_gpr, data_type::f32, brg.dt_d);
+                vmm_lbound, vmm_ubound, reg_tmp_gpr, data_type::f32, brg.dt_d);
     }
 
     for (int bd = 0; bd < bd_block; bd++) {
         if (dt_requires_saturation) {
             for (int ld = 0; ld < ld_block2; ld++) {
-                auto zmm = accm(ld_block2, bd, ld);
-                saturate_f32(zmm, zmm_lbound, zmm_ubound, brg.dt_d);
-                vcvtps2dq(zmm, zmm);
+                auto vmm = accm(ld_block2, bd, ld);
+                saturate_f32(vmm, vmm_lbound, vmm_ubound, brg.dt_d);
+                vcvtps2dq(vmm, vmm);
             }
         }
         for (int ld = 0; ld < ld_block2; ld++) {
             auto addr = ptr[reg_aux_D + D_offset(bd, ld)];
-            auto zmm = accm(ld_block2, bd, ld);
-            auto ymm = Xbyak::Ymm(zmm.getIdx());
-            const Xbyak::Zmm r_zmm = zmm_mask(zmm, true, true, k_mask);
+            auto vmm = accm(ld_block2, bd, ld);
+            auto ymm = Xbyak::Ymm(vmm.getIdx());
+            if (brg.is_ymm()) {
+                if (!is_ld_tail
+                        && one_of(brg.dt_d, data_type::f32, data_type::s32))
+                    vmovups(addr, vmm);
+                else
+                    store_data(brg.dt_d, ymm, reg_aux_D, D_offset(bd, ld),
+                            is_ld_tail ? brg.ldb_tail : brg.ld_block);
+                continue;
+            }
+            const Vmm r_vmm = vmm_mask(vmm, true, true, k_mask);
             const Xbyak::Ymm r_ymm = ymm_mask(ymm, true, true, k_mask);
             switch (brg.dt_d) {
                 case data_type::f32:
-                case data_type::s32: vmovups(addr, r_zmm); break;
+                case data_type::s32: vmovups(addr, r_vmm); break;
                 case data_type::bf16:
-                    vcvtneps2bf16(ymm, zmm);
+                    vcvtneps2bf16(ymm, vmm);
                     vmovdqu16(addr, r_ymm);
                     break;
-                case data_type::s8: vpmovsdb(addr, r_zmm); break;
-                case data_type::u8: vpmovusdb(addr, r_zmm); break;
+                case data_type::s8: vpmovsdb(addr, r_vmm); break;
+                case data_type::u8: vpmovusdb(addr, r_vmm); break;
                 default: assert(!"unknown dst_dt");
             }
         }
     }
 }
 
-void jit_brgemm_kernel_t::store_accumulators_without_post_ops(
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::store_accumulators_without_post_ops(
         int bd_block, int ld_block2, bool is_ld_tail) {
 
     // if (brg.is_int8 && alpha_or_beta_applicable && !beta_uses_vadd) ->
@@ -1108,39 +1292,45 @@ void jit_brgemm_kernel_t::store_accumulators_without_post_ops(
             = brg.beta == 1.f && IMPLICATION(brg.is_int8, brg.alpha == 1.0f);
     const bool dt_requires_saturation = brg.is_int8
             && !IMPLICATION(alpha_or_beta_applicable, beta_uses_vadd);
-    auto zmm_lbound = zmm_tmp_1();
-    auto zmm_ubound = zmm_tmp_2();
+    auto vmm_lbound = vmm_tmp_1();
+    auto vmm_ubound = vmm_tmp_2();
     if (dt_requires_saturation) {
         init_saturate_f32(
-                zmm_lbound, zmm_ubound, reg_tmp_gpr, data_type::f32, brg.dt_d);
+                vmm_lbound, vmm_ubound, reg_tmp_gpr, data_type::f32, brg.dt_d);
     }
 
     for (int bd = 0; bd < bd_block; bd++) {
         if (dt_requires_saturation) {
             for (int ld = 0; ld < ld_block2; ld++) {
-                auto zmm = accm(ld_block2, bd, ld);
-                saturate_f32(zmm, zmm_lbound, zmm_ubound, brg.dt_d);
-                vcvtps2dq(zmm, zmm);
+                auto vmm = accm(ld_block2, bd, ld);
+                saturate_f32(vmm, vmm_lbound, vmm_ubound, brg.dt_d);
+                vcvtps2dq(vmm, vmm);
             }
         }
         for (int ld = 0; ld < ld_block2; ld++) {
-            auto zmm = accm(ld_block2, bd, ld);
-            if (is_ld_tail)
+            auto vmm = accm(ld_block2, bd, ld);
+            if (is_ld_tail && brg.is_ymm())
+                store_bytes(Xbyak::Ymm(vmm.getIdx()), reg_aux_C,
+                        C_offset(bd, ld), brg.typesize_C * brg.ldb_tail);
+            else if (is_ld_tail)
                 vmovups(ptr[reg_aux_C + C_offset(bd, ld)] | ld_tail_mask | T_z,
-                        zmm);
+                        vmm);
             else
-                vmovups(ptr[reg_aux_C + C_offset(bd, ld)], zmm);
+                vmovups(ptr[reg_aux_C + C_offset(bd, ld)], vmm);
         }
     }
 }
 
-void jit_brgemm_kernel_t::store_accumulators(int bd_block2, bool is_bdb_tail,
-        int ld_block2, bool is_ld_tail, bool skip_accumulation) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::store_accumulators(int bd_block2,
+        bool is_bdb_tail, int ld_block2, bool is_ld_tail,
+        bool skip_accumulation) {
     const bool has_zero_points = !everyone_is(brgemm_broadcast_t::none,
             brg.zp_type_a, brg.zp_type_b, brg.zp_type_c);
     const bool are_post_ops_applicable = one_of(true, brg.with_eltwise,
             brg.with_binary, brg.with_scales, brg.with_bias, brg.with_sum,
-            brg.dt_d != brg.dt_c, brg.req_s8s8_compensation, has_zero_points);
+            brg.dt_d != brg.dt_c, brg.req_s8s8_compensation, has_zero_points,
+            brg.with_row_scales);
     const bool need_to_apply_alpha_beta = brg.beta != 0.f || brg.alpha != 1.f;
 
     if (brg.is_amx) {
@@ -1214,6 +1404,7 @@ void jit_brgemm_kernel_t::store_accumulators(int bd_block2, bool is_bdb_tail,
                         advance_bdb_post_op_regs(adj_bd_block);
                         post_processed |= utils::one_of(true,
                                 brg.zp_type_b != brgemm_broadcast_t::none,
+                                brg.with_row_scales,
                                 with_binary_per_oc_sp_bcast_);
                     }
                     if (post_processed) mov(reg_buf, ptr[rsp + reg_buf_offs_]);
@@ -1263,7 +1454,8 @@ void jit_brgemm_kernel_t::store_accumulators(int bd_block2, bool is_bdb_tail,
     }
 }
 
-void jit_brgemm_kernel_t::restore_A_B_matrices() {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::restore_A_B_matrices() {
     auto restore_reg_batch = brg.brgattr.max_bs > 1 || vpad_exist;
     if (brg.type == brgemm_addr) {
         if (restore_reg_batch) mov(reg_aux1_batch, reg_addr_batch);
@@ -1280,7 +1472,8 @@ void jit_brgemm_kernel_t::restore_A_B_matrices() {
     }
 }
 
-void jit_brgemm_kernel_t::set_A_B_matrices() {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::set_A_B_matrices() {
     if (brg.type == brgemm_addr) {
         if (brg.brgattr.max_bs > 1) {
             if (brg.layout == brgemm_row_major) {
@@ -1334,8 +1527,9 @@ void jit_brgemm_kernel_t::set_A_B_matrices() {
     add(reg_aux_B, reg_b_offset);
 }
 
-void jit_brgemm_kernel_t::gemm_microkernel_amx(int bd_block2, bool is_bdb_tail,
-        int ld_block2, bool is_rd_tail, bool is_ld_tail) {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::gemm_microkernel_amx(int bd_block2,
+        bool is_bdb_tail, int ld_block2, bool is_rd_tail, bool is_ld_tail) {
     auto tdpbxxd = [=](const Tmm &x1, const Tmm &x2, const Tmm &x3) {
         if (brg.dt_a == data_type::bf16 && brg.dt_b == data_type::bf16) {
             tdpbf16ps(x1, x2, x3);
@@ -1393,17 +1587,19 @@ void jit_brgemm_kernel_t::gemm_microkernel_amx(int bd_block2, bool is_bdb_tail,
     }
 }
 
-void jit_brgemm_kernel_t::gemm_microkernel_avx512(int bd_block2,
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::gemm_microkernel_avx512(int bd_block2,
         bool is_bdb_tail, int ld_block2, bool is_rd_tail, bool is_ld_tail,
         int vpad, int rows_for_rd_tail) {
     MAYBE_UNUSED(bd_block2);
-    auto dot_product = [=](Zmm z1, Zmm z2, Zmm z3) {
+    auto dot_product = [=](Vmm v1, Vmm v2, Vmm v3) {
         if (brg.is_f32)
-            vfmadd231ps(z1, z2, z3);
+            vfmadd231ps(v1, v2, v3);
         else if (brg.is_bf16)
-            vdpbf16ps(z1, z2, z3);
+            vdpbf16ps(v1, v2, v3);
         else if (brg.is_int8)
-            vpdpbusd(z1, z3, z2);
+            vpdpbusd(v1, v3, v2,
+                    brg.is_ymm() ? Xbyak::VexEncoding : Xbyak::EvexEncoding);
     };
 
     int bd_block = (is_bdb_tail) ? brg.bdb_tail : brg.bd_block;
@@ -1425,21 +1621,21 @@ void jit_brgemm_kernel_t::gemm_microkernel_avx512(int bd_block2,
     } else
         rd_loop = brg.rd_block;
 
-    auto broadcast = [=](Zmm z1, size_t offset, bool is_tail) {
+    auto broadcast = [=](Vmm v1, size_t offset, bool is_tail) {
         if (is_tail) {
-            vpxord(z1, z1, z1);
-            Xmm xmm_tmp = Xmm(z1.getIdx());
+            uni_vpxor(v1, v1, v1);
+            Xmm xmm_tmp = Xmm(v1.getIdx());
             load_bytes(
                     xmm_tmp, reg_aux_A, offset, rd_tail_size * brg.typesize_A);
-            vpbroadcastd(z1, xmm_tmp);
+            vpbroadcastd(v1, xmm_tmp);
         } else {
             if (brg.is_f32)
-                vbroadcastss(z1, ptr[reg_aux_A + offset]);
+                vbroadcastss(v1, ptr[reg_aux_A + offset]);
             else if (brg.is_bf16 || brg.is_int8)
-                vpbroadcastd(z1, ptr[reg_aux_A + offset]);
+                vpbroadcastd(v1, ptr[reg_aux_A + offset]);
         }
 
-        if (brg.req_s8s8_compensation) vpaddb(z1, z1, zmm_inp_shift());
+        if (brg.req_s8s8_compensation) vpaddb(v1, v1, vmm_inp_shift());
     };
 
     bool maybe_load_bytes = (rows_for_rd_tail > 0 || brg.brgattr.wary_tail_read)
@@ -1457,19 +1653,23 @@ void jit_brgemm_kernel_t::gemm_microkernel_avx512(int bd_block2,
                         have_to_load_bytes && bd_by_load_bytes);
             }
             for (int ld = 0; ld < ld_block2; ld++) {
-                if (is_ld_tail) {
+                if (is_ld_tail && brg.is_ymm()) {
+                    load_bytes(Xbyak::Ymm(load().getIdx()), reg_aux_B,
+                            B_offset(ld, rd),
+                            brg.ldb_tail * brg.ld_step * brg.typesize_B);
+                } else if (is_ld_tail) {
                     vmovups(load() | ld_tail_mask | T_z,
                             ptr[reg_aux_B + B_offset(ld, rd)]);
                 } else {
                     vmovups(load(), ptr[reg_aux_B + B_offset(ld, rd)]);
                 }
                 for (int bd = bd_b; bd < bd_e; bd++) {
-                    auto zmm = accm(ld_block2, bd, ld);
+                    auto vmm = accm(ld_block2, bd, ld);
                     if (is_emdbd)
-                        vfmadd231ps(zmm, load(),
+                        vfmadd231ps(vmm, load(),
                                 zword_b[reg_aux_A + A_offset(bd, rd)]);
                     else
-                        dot_product(zmm, load(), bcst(bd));
+                        dot_product(vmm, load(), bcst(bd));
                 }
             }
         }
@@ -1477,7 +1677,11 @@ void jit_brgemm_kernel_t::gemm_microkernel_avx512(int bd_block2,
         for (int rd = 0; rd < rd_loop; rd += brg.rd_step) {
             int prefetch_count_B = 0;
             for (int ld = 0; ld < ld_block2; ld++) {
-                if (is_ld_tail) {
+                if (is_ld_tail && brg.is_ymm()) {
+                    load_bytes(Xbyak::Ymm(load(ld).getIdx()), reg_aux_B,
+                            B_offset(ld, rd),
+                            brg.ldb_tail * brg.ld_step * brg.typesize_B);
+                } else if (is_ld_tail) {
                     vmovups(load(ld) | ld_tail_mask | T_z,
                             ptr[reg_aux_B + B_offset(ld, rd)]);
                 } else {
@@ -1502,19 +1706,20 @@ void jit_brgemm_kernel_t::gemm_microkernel_avx512(int bd_block2,
                             + brg.LDB * brg.rd_block * brg.typesize_B]);
                 }
                 for (int ld = 0; ld < ld_block2; ld++) {
-                    auto zmm = accm(ld_block2, bd, ld);
+                    auto vmm = accm(ld_block2, bd, ld);
                     if (is_emdbd)
-                        vfmadd231ps(zmm, load(ld),
+                        vfmadd231ps(vmm, load(ld),
                                 zword_b[reg_aux_A + A_offset(bd, rd)]);
                     else
-                        dot_product(zmm, load(ld), bcst());
+                        dot_product(vmm, load(ld), bcst());
                 }
             }
         }
     }
 }
 
-void jit_brgemm_kernel_t::ldb_loop(int bd_block2, bool is_bdb_tail,
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::ldb_loop(int bd_block2, bool is_bdb_tail,
         int ld_block2, int ldb_loop_length, bool is_reg_tail, bool is_ld_tail,
         bool check_top_vpad, bool check_bottom_vpad, int rows_for_rd_tail,
         bool skip_accumulation) {
@@ -1594,7 +1799,12 @@ void jit_brgemm_kernel_t::ldb_loop(int bd_block2, bool is_bdb_tail,
             if (brg.req_s8s8_compensation) {
                 mov(ptr[rsp + reg_bdb_loop_offs_], reg_bdb_loop);
                 mov(reg_s8_input_shift, 128);
-                vpbroadcastb(zmm_inp_shift(), reg_s8_input_shift.cvt8());
+                if (brg.is_ymm()) {
+                    const Xmm xmm_inp_shift(vmm_inp_shift().getIdx());
+                    vmovq(xmm_inp_shift, reg_s8_input_shift);
+                    vpbroadcastb(vmm_inp_shift(), xmm_inp_shift);
+                } else
+                    vpbroadcastb(vmm_inp_shift(), reg_s8_input_shift.cvt8());
                 mov(reg_bdb_loop, ptr[rsp + reg_bdb_loop_offs_]);
             }
 
@@ -1685,7 +1895,8 @@ void jit_brgemm_kernel_t::ldb_loop(int bd_block2, bool is_bdb_tail,
     }
 }
 
-void jit_brgemm_kernel_t::bdb_loop() {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::bdb_loop() {
     auto do_ldb_loop = [=](int bd_block2, bool is_bdb_tail, bool check_top_vpad,
                                bool check_bottom_vpad, int rows_for_rd_tail,
                                bool skip_accumulation) {
@@ -1749,8 +1960,11 @@ void jit_brgemm_kernel_t::bdb_loop() {
         auto ld_block2 = (brg.ldb2 > 0)
                 ? brg.ld_block2
                 : ((brg.ldb2_tail > 0) ? brg.ldb2_tail : 1);
+        // on avx2 the input shift register must not be used for broadcasts
+        const int max_bcast_1_load_vregs
+                = brg.is_ymm() ? max_vregs - 2 : max_vregs;
         n_bcast_1_load = brg.is_int8
-                && ((brg.bd_block * (ld_block2 + 1) < 32)
+                && ((brg.bd_block * (ld_block2 + 1) < max_bcast_1_load_vregs)
                         && (bd_blocks_for_rd_tail == 0)
                         && (rows_for_rd_tail == 0));
         // loop order may be specified in brgemm attributes
@@ -1895,7 +2109,8 @@ void jit_brgemm_kernel_t::bdb_loop() {
         bdb_loop_general(false);
 }
 
-void jit_brgemm_kernel_t::generate() {
+template <cpu_isa_t isa, typename Vmm>
+void jit_brgemm_kernel_t<isa, Vmm>::generate() {
     preamble();
 
     sub(rsp, stack_space_needed_);
@@ -1910,10 +2125,12 @@ void jit_brgemm_kernel_t::generate() {
 
     reg64_t reg_mask = rax;
 
-    mov(reg_mask, full_mask);
-    kmovq(ld_full_mask, reg_mask);
-    mov(reg_mask, tail_mask);
-    kmovq(ld_tail_mask, reg_mask);
+    if (!brg.is_ymm()) {
+        mov(reg_mask, full_mask);
+        kmovq(ld_full_mask, reg_mask);
+        mov(reg_mask, tail_mask);
+        kmovq(ld_tail_mask, reg_mask);
+    }
 
     read_params();
 
@@ -1943,23 +2160,31 @@ brgemm_attr_t::brgemm_attr_t()
     , use_uker(false)
     , use_interleave_stores(false) {}
 
-brgemm_kernel_common_t::brgemm_kernel_common_t(const brgemm_t abrd)
+template <cpu_isa_t isa, typename Vmm>
+brgemm_kernel_common_t<isa, Vmm>::brgemm_kernel_common_t(const brgemm_t abrd)
     : brgemm_kernel_t(abrd) {
-    brgemm_kernel_ = new jit_brgemm_kernel_t(abrd);
+    brgemm_kernel_ = new jit_brgemm_kernel_t<isa, Vmm>(abrd);
 }
 
-status_t brgemm_kernel_common_t::create_kernel() {
+template <cpu_isa_t isa, typename Vmm>
+status_t brgemm_kernel_common_t<isa, Vmm>::create_kernel() {
     return brgemm_kernel_->create_kernel();
 }
 
-void brgemm_kernel_common_t::operator()(brgemm_kernel_params_t *params) const {
+template <cpu_isa_t isa, typename Vmm>
+void brgemm_kernel_common_t<isa, Vmm>::operator()(
+        brgemm_kernel_params_t *params) const {
     (*brgemm_kernel_)(params);
 }
 
-brgemm_kernel_common_t::~brgemm_kernel_common_t() {
+template <cpu_isa_t isa, typename Vmm>
+brgemm_kernel_common_t<isa, Vmm>::~brgemm_kernel_common_t() {
     delete brgemm_kernel_;
 }
 
+template struct brgemm_kernel_common_t<avx512_core, Xbyak::Zmm>;
+template struct brgemm_kernel_common_t<avx2, Xbyak::Ymm>;
+
 } // namespace x64
 } // namespace cpu
 } // namespace impl
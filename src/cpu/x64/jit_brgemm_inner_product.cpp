@@ -460,6 +460,8 @@ status_t brgemm_inner_product_fwd_t<isa>::execute_forward(
     return status::success;
 }
 
+template struct brgemm_inner_product_fwd_t<avx2>;
+template struct brgemm_inner_product_fwd_t<avx2_vnni>;
 template struct brgemm_inner_product_fwd_t<avx512_core>;
 template struct brgemm_inner_product_fwd_t<avx512_core_bf16>;
 template struct brgemm_inner_product_fwd_t<avx512_core_vnni>;
@@ -22,6 +22,8 @@
 #include "common/utils.hpp"
 
 #include "cpu/cpu_primitive.hpp"
+#include "cpu/matmul/matmul_utils.hpp"
+#include "cpu/simple_q10n.hpp"
 
 #include "cpu/x64/amx_tile_configure.hpp"
 #include "cpu/x64/injectors/jit_uni_binary_injector.hpp"
@@ -40,17 +42,47 @@ using namespace nstl;
 
 using namespace data_type;
 
+namespace {
+// Quantizes a row of src symmetrically to s8 and returns the scale of the row
+template <typename src_data_t>
+float quantize_src_row(const src_data_t *src, int8_t *dst, dim_t K) {
+    float amax = 0.f;
+    PRAGMA_OMP_SIMD(reduction(max : amax))
+    for (dim_t k = 0; k < K; k++)
+        amax = nstl::max(amax, nstl::abs((float)src[k]));
+
+    const float qscale = amax > 0.f ? 127.f / amax : 0.f;
+    PRAGMA_OMP_SIMD()
+    for (dim_t k = 0; k < K; k++)
+        dst[k] = saturate_and_round<int8_t>((float)src[k] * qscale);
+    return amax / 127.f;
+}
+} // namespace
+
 template <cpu_isa_t isa>
 status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
     const auto src_dt = src_md_.data_type;
     const auto wei_dt = weights_md_.data_type;
     const auto dst_dt = dst_md_.data_type;
 
-    const bool is_f32 = everyone_is(f32, src_dt, wei_dt, dst_dt);
-    const bool is_int8 = one_of(src_dt, u8, s8) && wei_dt == s8
+    // f32 and bf16 src rows are quantized to s8 before the int8 computations
+    const auto src_dyn_quant_dt = attr()->src_dyn_quant_dt_;
+    const bool with_src_dyn_quant = src_dyn_quant_dt != data_type::undef;
+    const auto src_compute_dt = with_src_dyn_quant ? src_dyn_quant_dt : src_dt;
+
+    // s8 weights of f32 and bf16 problems are decompressed to the src data
+    // type by the copy routine for B
+    const bool is_wei_decompression = !with_src_dyn_quant
+            && one_of(src_dt, f32, bf16) && wei_dt == s8;
+    const auto wei_compute_dt = is_wei_decompression ? src_dt : wei_dt;
+
+    const bool is_f32 = everyone_is(f32, src_dt, wei_compute_dt, dst_dt);
+    const bool is_int8 = one_of(src_compute_dt, u8, s8) && wei_dt == s8
             && one_of(dst_dt, u8, s8, s32, f32, bf16);
-    const bool is_bf16
-            = everyone_is(bf16, src_dt, wei_dt) && one_of(dst_dt, bf16, f32);
+    const bool is_src_dyn_quant_ok = IMPLICATION(with_src_dyn_quant,
+            one_of(src_dt, f32, bf16) && one_of(dst_dt, f32, bf16));
+    const bool is_bf16 = everyone_is(bf16, src_dt, wei_compute_dt)
+            && one_of(dst_dt, bf16, f32);
 
     auto check_bias = [&]() -> bool {
         const bool is_bia_dt_correct
@@ -59,7 +91,8 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
                                   bf16))
                 || (is_bf16 && one_of(weights_md(1)->data_type, f32, bf16))
                 || (is_f32 && weights_md(1)->data_type == f32);
-        return IMPLICATION(with_bias(), is_bia_dt_correct && is_bias_1xN());
+        return IMPLICATION(with_bias(),
+                is_bia_dt_correct && (is_bias_1xN() || is_bias_Gx1xN()));
     };
 
     auto check_attr_oscale = [&]() -> bool {
@@ -68,17 +101,39 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
                 oscale.mask_ != 0, oscale.mask_ == (1 << (dst_md_.ndims - 1)));
     };
 
-    auto check_attr_zero_points
-            = [&]() -> bool { return attr()->zero_points_.common(); };
+    auto check_attr_zero_points = [&]() -> bool {
+        return attr()->zero_points_.common()
+                && IMPLICATION(with_src_dyn_quant,
+                        attr()->zero_points_.has_default_values());
+    };
+
+    // only M can be defined at execution time, the layouts of src and dst
+    // with runtime strides are checked against the plain tags
+    auto check_runtime_dims = [&]() -> bool {
+        if (!has_runtime_dims_or_strides()) return true;
+        if (!is_runtime_value(M())
+                || memory_desc_wrapper(weights_md_)
+                           .has_runtime_dims_or_strides())
+            return false;
+        for (int d = 0; d < ndims(); d++) {
+            if (d == ndims() - 2) continue;
+            if (is_runtime_value(src_md_.dims[d])
+                    || is_runtime_value(dst_md_.dims[d]))
+                return false;
+        }
+        return true;
+    };
 
-    const bool problem_dt_correct = is_int8 || is_bf16 || is_f32;
+    using smask_t = primitive_attr_t::skip_mask_t;
+    auto attr_skip_mask = smask_t::oscale | smask_t::zero_points_runtime
+            | smask_t::post_ops | smask_t::sum_dt;
+    if (with_src_dyn_quant) attr_skip_mask |= smask_t::src_dyn_quant;
+
+    const bool problem_dt_correct
+            = (is_int8 && is_src_dyn_quant_ok) || is_bf16 || is_f32;
     bool ok = mayiuse(isa) && problem_dt_correct
-            && !has_runtime_dims_or_strides()
-            && attr()->has_default_values(primitive_attr_t::skip_mask_t::oscale
-                            | primitive_attr_t::skip_mask_t::zero_points_runtime
-                            | primitive_attr_t::skip_mask_t::post_ops
-                            | primitive_attr_t::skip_mask_t::sum_dt,
-                    dst_dt)
+            && check_runtime_dims()
+            && attr()->has_default_values(attr_skip_mask, dst_dt)
             && attr()->post_ops_.check_sum_consistent_dt(dst_dt)
             && check_attr_oscale() && check_attr_zero_points() && check_bias();
     if (!ok) return status::unimplemented;
@@ -90,11 +145,11 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
     const float beta = 1.0;
     const float beta_init = 0.0;
     for_(int i_init = 0; i_init < 2; i_init++)
-    for_(int i_M = 0; i_M < 2; i_M++)
+    for_(int i_M = 0; i_M < max_num_M_kernels; i_M++)
     for_(int i_N = 0; i_N < 2; i_N++)
     for (int i_K = 0; i_K < 2; i_K++) {
         auto vbeta = (i_init) ? beta_init : beta;
-        auto vM = (i_M) ? bgmmc_.M_tail : bgmmc_.M_blk;
+        auto vM = get_brg_kernel_M(bgmmc_, i_M);
         auto vN = (i_N) ? bgmmc_.N_tail : bgmmc_.N_blk;
         auto vK = (i_K) ? bgmmc_.K_tail : bgmmc_.K_blk;
 
@@ -111,6 +166,9 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
         auto LDD = bgmmc_.N;
         CHECK(brgemm_desc_set_postops(
                 &brg, attr(), &dst_md_, LDD, bgmmc_.bia_dt));
+        // zero point of decompressed weights is applied by the copy routine
+        if (bgmmc_.with_wei_decompression)
+            brg.zp_type_b = brgemm_broadcast_t::none;
 
         constexpr bool is_amx = one_of(
                 isa, avx512_core_bf16_amx_int8, avx512_core_bf16_amx_bf16);
@@ -140,7 +198,7 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
 
 template <cpu_isa_t isa>
 status_t brgemm_matmul_t<isa>::init(engine_t *engine) {
-    for_(int i_M = 0; i_M < 2; i_M++)
+    for_(int i_M = 0; i_M < max_num_M_kernels; i_M++)
     for_(int i_N = 0; i_N < 2; i_N++)
     for_(int i_K = 0; i_K < 2; i_K++)
     for (int i_init = 0; i_init < 2; i_init++) {
@@ -181,10 +239,21 @@ status_t brgemm_matmul_t<isa>::execute_body(const exec_ctx_t &ctx) const {
     DEFINE_ZERO_POINT_VALUE(wei_zero_point, DNNL_ARG_WEIGHTS);
     DEFINE_ZERO_POINT_VALUE(dst_zero_point, DNNL_ARG_DST);
 
+    const auto &bgmmc = pd()->get_brgemm_matmul_conf();
+    if (bgmmc.is_grouped) {
+        const auto group_offsets
+                = CTX_IN_MEM(const int32_t *, DNNL_ARG_GROUP_OFFSETS);
+        if (!cpu::matmul::group_offsets_ok(
+                    group_offsets, bgmmc.batch, pd()->dst_md()->dims[0]))
+            return status::invalid_arguments;
+    }
+
     brg_matmul_exec_ctx_t brgmm_ctx(
             ctx, pd(), src_zero_point, wei_zero_point, dst_zero_point);
 
-    const auto &bgmmc = pd()->get_brgemm_matmul_conf();
+    if (bgmmc.with_src_dyn_quant)
+        quantize_src(brgmm_ctx, CTX_IN_MEM(const char *, DNNL_ARG_SRC));
+
     const bool use_buffer_a
             = bgmmc.use_buffer_a || bgmmc.use_buffer_a_tail_only;
     constexpr bool is_amx
@@ -209,12 +278,11 @@ status_t brgemm_matmul_t<isa>::execute_body(const exec_ctx_t &ctx) const {
         }
 
         int b {0}, mc {0}, nc {0};
-        nd_iterator_init(
-                start, b, bgmmc.batch, mc, bgmmc.M_chunks, nc, bgmmc.N_chunks);
+        brgmm_ctx.init_bmn_idx(start, b, mc, nc);
         while (start < end) {
             auto m_start = mc * bgmmc.M_chunk_size;
-            auto m_end = nstl::min(
-                    (mc + 1) * bgmmc.M_chunk_size, bgmmc.num_M_blocks);
+            auto m_end = nstl::min((mc + 1) * bgmmc.M_chunk_size,
+                    brgmm_ctx.get_num_M_blocks(b));
             auto n_start = nc * bgmmc.N_chunk_size;
             auto n_end = nstl::min(
                     (nc + 1) * bgmmc.N_chunk_size, bgmmc.num_N_blocks);
@@ -230,8 +298,7 @@ status_t brgemm_matmul_t<isa>::execute_body(const exec_ctx_t &ctx) const {
                 }
             }
             ++start;
-            nd_iterator_step(
-                    b, bgmmc.batch, mc, bgmmc.M_chunks, nc, bgmmc.N_chunks);
+            brgmm_ctx.step_bmn_idx(b, mc, nc);
         }
         if (is_amx) { amx_tile_release(); }
     });
@@ -241,10 +308,62 @@ status_t brgemm_matmul_t<isa>::execute_body(const exec_ctx_t &ctx) const {
     return status::success;
 }
 
+template <cpu_isa_t isa>
+void brgemm_matmul_t<isa>::quantize_src(
+        const brg_matmul_exec_ctx_t &brgmm_ctx, const char *src) const {
+    const auto &bgmmc = pd()->get_brgemm_matmul_conf();
+    const dim_t K = bgmmc.K;
+    int8_t *src_quantized = brgmm_ctx.get_src_quantized_ptr();
+    float *row_scales = brgmm_ctx.get_src_row_scales_ptr();
+
+    // The quantized src makes a full round trip through the scratchpad:
+    // the whole src is read and written here and read again by the kernels.
+    // Fusing the quantization into the copy routine for A is out of reach:
+    // the scale of a row depends on all its K elements, while A is copied by
+    // K chunks, possibly by different threads, and is not copied at all when
+    // the kernels read src directly.
+    // src has a plain layout, so its rows are dense and follow each other
+    parallel_nd(bgmmc.src_quant_rows, [&](dim_t r) {
+        if (bgmmc.orig_src_dt == bf16)
+            row_scales[r] = quantize_src_row(
+                    reinterpret_cast<const bfloat16_t *>(src) + r * K,
+                    src_quantized + r * K, K);
+        else
+            row_scales[r] = quantize_src_row(
+                    reinterpret_cast<const float *>(src) + r * K,
+                    src_quantized + r * K, K);
+    });
+}
+
 template <cpu_isa_t isa>
 void brgemm_matmul_t<isa>::compute_kernel(
         const brg_matmul_exec_ctx_t &brgmm_ctx, int ithr, int b_idx,
         int m_blk_idx, int n_blk_idx, int k_chunk_idx, bool do_init) const {
+    const auto &bgmmc = pd()->get_brgemm_matmul_conf();
+    const int M_rows = brgmm_ctx.get_M(b_idx) - m_blk_idx * bgmmc.M_blk;
+    if (M_rows >= bgmmc.M_blk || bgmmc.num_pow2_M_tails == 0) {
+        const int m_ker_idx = M_rows < bgmmc.M_blk ? 1 : 0;
+        compute_kernel_rows(brgmm_ctx, ithr, b_idx, m_blk_idx, n_blk_idx,
+                k_chunk_idx, do_init, 0, m_ker_idx);
+        return;
+    }
+
+    // M tail is known only at execution time, so the tail rows are split
+    // into power-of-two parts each computed by its own kernel
+    int m_off = 0;
+    for (int i = bgmmc.num_pow2_M_tails - 1; i >= 0; i--) {
+        if (!(M_rows & (1 << i))) continue;
+        compute_kernel_rows(brgmm_ctx, ithr, b_idx, m_blk_idx, n_blk_idx,
+                k_chunk_idx, do_init, m_off, 2 + i);
+        m_off += 1 << i;
+    }
+}
+
+template <cpu_isa_t isa>
+void brgemm_matmul_t<isa>::compute_kernel_rows(
+        const brg_matmul_exec_ctx_t &brgmm_ctx, int ithr, int b_idx,
+        int m_blk_idx, int n_blk_idx, int k_chunk_idx, bool do_init, int m_off,
+        int m_ker_idx) const {
     constexpr bool is_amx
             = one_of(isa, avx512_core_bf16_amx_int8, avx512_core_bf16_amx_bf16);
     const auto &bgmmc = pd()->get_brgemm_matmul_conf();
@@ -252,41 +371,46 @@ void brgemm_matmul_t<isa>::compute_kernel(
     const int base_brg_ker_idx = brgmm_ctx.get_base_brgemm_kernel_idx();
 
     const auto wsp_tile = brgmm_ctx.get_tile_workspace(ithr);
-    const int m = m_blk_idx * bgmmc.M_blk;
+    const int m = m_blk_idx * bgmmc.M_blk + m_off;
     const int n = n_blk_idx * bgmmc.N_blk;
     const int k_blk_idx = k_chunk_idx * bgmmc.brgemm_batch_size;
 
-    const bool is_M_tail = (bgmmc.M - m < bgmmc.M_blk);
+    const bool is_M_tail = m_ker_idx != 0;
     const bool is_N_tail = (bgmmc.N - n < bgmmc.N_blk);
     const bool is_last_K_chunk = brgmm_ctx.is_last_K_chunk(k_chunk_idx);
     const bool is_K_tail = is_last_K_chunk && bgmmc.K_tail > 0;
 
     const int gemm_batch = brgmm_ctx.get_brgemm_batch_size(k_chunk_idx);
     const int brg_ker_idx
-            = pd()->get_brg_kernel_idx(do_init, is_M_tail, is_N_tail, false);
+            = pd()->get_brg_kernel_idx(do_init, m_ker_idx, is_N_tail, false);
     const auto brg_kernel = brg_kernels_[brg_ker_idx].get();
-    const auto ptr_bias = brgmm_ctx.get_bias_ptr(n);
+    const auto ptr_bias = brgmm_ctx.get_bias_ptr(b_idx, n);
     auto ptr_D = brgmm_ctx.get_data_C_ptr(b_idx, m, n);
     auto ptr_C = (bgmmc.use_buffer_c)
             ? brgmm_ctx.get_buf_C_ptr(ithr, m_blk_idx, n_blk_idx)
+                    + m_off * bgmmc.LDC * bgmmc.acc_dt_sz
             : ptr_D;
 
     const auto zp_comp_a = brgmm_ctx.get_zp_a_compensation_ptr(ithr, n_blk_idx);
-    const auto zp_comp_b
+    auto zp_comp_b
             = brgmm_ctx.get_zp_b_compensation_result_ptr(ithr, m_blk_idx);
+    if (zp_comp_b) zp_comp_b += m_off;
     const auto zp_c_val_ptr = brgmm_ctx.get_zp_c_val_ptr();
     const auto &post_ops_binary_rhs_arg_vec
             = brgmm_ctx.get_post_ops_binary_rhs_arg_vec();
     const bool post_ops_applicable = bgmmc.post_ops_applicable
             && (bgmmc.nthr_k <= 1 || bgmmc.K_chunks == 1);
+    // row of the dst matrix, groups share the rows of src and dst
+    const int m_row = brgmm_ctx.get_M_offset(b_idx) + m;
+    const auto src_row_scales = brgmm_ctx.get_src_row_scales_ptr(b_idx, m);
 
     if (gemm_batch > 0 && brg_kernel != nullptr) {
         const bool is_tile_reconf_required = is_amx && (is_M_tail || is_N_tail);
         if (is_tile_reconf_required)
             amx_tile_configure(&brg_kernel_palettes_[brg_ker_idx][0]);
 
-        brgmm_ctx.init_brgemm_batch_elements_values(
-                ithr, 0, gemm_batch, b_idx, m_blk_idx, k_blk_idx, n_blk_idx);
+        brgmm_ctx.init_brgemm_batch_elements_values(ithr, 0, gemm_batch, b_idx,
+                m_blk_idx, k_blk_idx, n_blk_idx, m_off);
 
         if (post_ops_applicable && is_last_K_chunk && !is_K_tail) {
             void *scratch = is_amx
@@ -294,13 +418,13 @@ void brgemm_matmul_t<isa>::compute_kernel(
                     : static_cast<void *>(brgmm_ctx.get_s8s8_comp_ptr(
                             ithr, b_idx, n_blk_idx));
 
-            const size_t dst_row_logical_off = m_blk_idx * bgmmc.M_blk;
+            const size_t dst_row_logical_off = m_row;
             const size_t batch_first_dim_idx = bgmmc.batch_ndims > 1
                     ? b_idx / bgmmc.batch_without_first_dim
                     : 0;
             const size_t first_mb_matrix_addr_off
-                    = batch_first_dim_idx * (bgmmc.M * bgmmc.N)
-                    + (m * bgmmc.N + n);
+                    = batch_first_dim_idx * (brgmm_ctx.get_M(b_idx) * bgmmc.N)
+                    + (m_row * bgmmc.N + n);
             const brgemm_post_ops_data_t post_ops_data {
                     static_cast<const void *>(ptr_bias),
                     brgmm_ctx.get_oscales_ptr(n),
@@ -309,7 +433,8 @@ void brgemm_matmul_t<isa>::compute_kernel(
                     first_mb_matrix_addr_off,
                     static_cast<const void *>(zp_comp_a),
                     static_cast<const void *>(zp_comp_b),
-                    static_cast<const void *>(zp_c_val_ptr)};
+                    static_cast<const void *>(zp_c_val_ptr), false,
+                    src_row_scales};
 
             brgemm_kernel_execute_postops(brg_kernel, gemm_batch, addr_batch,
                     (void *)ptr_C, (void *)ptr_D, post_ops_data, scratch);
@@ -322,12 +447,12 @@ void brgemm_matmul_t<isa>::compute_kernel(
             amx_tile_configure(&brg_kernel_palettes_[base_brg_ker_idx][0]);
     }
     if (is_K_tail) {
-        brgmm_ctx.init_brgemm_batch_elements_values(
-                ithr, gemm_batch, 1, b_idx, m_blk_idx, k_blk_idx, n_blk_idx);
+        brgmm_ctx.init_brgemm_batch_elements_values(ithr, gemm_batch, 1,
+                b_idx, m_blk_idx, k_blk_idx, n_blk_idx, m_off);
 
         const bool use_init_ker = (do_init && gemm_batch == 0);
         const int brg_ker_idx = pd()->get_brg_kernel_idx(
-                use_init_ker, is_M_tail, is_N_tail, true);
+                use_init_ker, m_ker_idx, is_N_tail, true);
         const auto brg_kernel_k_tail = brg_kernels_[brg_ker_idx].get();
         const bool is_tile_reconf_required
                 = is_amx && bgmmc.K_tail != bgmmc.K_blk;
@@ -339,13 +464,13 @@ void brgemm_matmul_t<isa>::compute_kernel(
                     : static_cast<void *>(brgmm_ctx.get_s8s8_comp_ptr(
                             ithr, b_idx, n_blk_idx));
 
-            const size_t dst_row_logical_off = m_blk_idx * bgmmc.M_blk;
+            const size_t dst_row_logical_off = m_row;
             const size_t batch_first_dim_idx = bgmmc.batch_ndims > 1
                     ? b_idx / bgmmc.batch_without_first_dim
                     : 0;
             const size_t first_mb_matrix_addr_off
-                    = batch_first_dim_idx * (bgmmc.M * bgmmc.N)
-                    + (m * bgmmc.N + n);
+                    = batch_first_dim_idx * (brgmm_ctx.get_M(b_idx) * bgmmc.N)
+                    + (m_row * bgmmc.N + n);
             const brgemm_post_ops_data_t post_ops_data {
                     static_cast<const void *>(ptr_bias),
                     brgmm_ctx.get_oscales_ptr(n),
@@ -354,7 +479,8 @@ void brgemm_matmul_t<isa>::compute_kernel(
                     first_mb_matrix_addr_off,
                     static_cast<const void *>(zp_comp_a),
                     static_cast<const void *>(zp_comp_b),
-                    static_cast<const void *>(zp_c_val_ptr)};
+                    static_cast<const void *>(zp_c_val_ptr), false,
+                    src_row_scales};
 
             brgemm_kernel_execute_postops(brg_kernel_k_tail, 1, addr_batch,
                     (void *)ptr_C, (void *)ptr_D, post_ops_data, scratch);
@@ -431,7 +557,7 @@ void brgemm_matmul_t<isa>::maybe_reduce_partial_results_and_apply_postops(
                         const auto brg_kernel = brg_kernels_[brg_ker_idx].get();
                         const int m = mb * bgmmc.M_blk;
                         const int n = nb * bgmmc.N_blk;
-                        const auto ptr_bias = brgmm_ctx.get_bias_ptr(n);
+                        const auto ptr_bias = brgmm_ctx.get_bias_ptr(b, n);
                         auto ptr_D = brgmm_ctx.get_data_C_ptr(b, m, n);
                         auto ptr_C = brgmm_ctx.get_buf_C_par_reduction_ptr(
                                 0, mb, nb);
@@ -466,7 +592,8 @@ void brgemm_matmul_t<isa>::maybe_reduce_partial_results_and_apply_postops(
                                 static_cast<const void *>(zp_comp_a),
                                 static_cast<const void *>(zp_comp_b),
                                 static_cast<const void *>(zp_c_val_ptr),
-                                skip_accumulation};
+                                skip_accumulation,
+                                brgmm_ctx.get_src_row_scales_ptr(b, m)};
 
                         brgemm_kernel_execute_postops(brg_kernel, 0, nullptr,
                                 (void *)ptr_C, (void *)ptr_D, post_ops_data,
@@ -495,8 +622,7 @@ void brgemm_matmul_t<isa>::copy_a_chunk_in_buffer(
     const int gemm_batch_iters = bgmmc.use_buffer_a_tail_only ? 0 : gemm_batch;
 
     const int m = m_blk_idx * bgmmc.M_blk;
-    const bool is_M_tail = (bgmmc.M - m < bgmmc.M_blk);
-    ctx.current_M_blk = is_M_tail ? bgmmc.M_tail : bgmmc.M_blk;
+    ctx.current_M_blk = nstl::min(brgmm_ctx.get_M(b_idx) - m, bgmmc.M_blk);
     ctx.zp_b_compensation_buffer_ptr
             = (void *)brgmm_ctx.get_zp_b_compensation_buffer_ptr(
                     ithr, m_blk_idx);
@@ -546,6 +672,7 @@ void brgemm_matmul_t<isa>::copy_b_chunk_in_buffer(
     ctx.zp_a_compensation_ptr
             = (void *)brgmm_ctx.get_zp_a_compensation_ptr(ithr, n_blk_idx);
     ctx.zp_a_neg_value_ptr = (void *)brgmm_ctx.get_zp_a_neg_val_ptr();
+    ctx.zp_b_neg_value_ptr = (void *)brgmm_ctx.get_zp_b_neg_val_ptr();
 
     int gb = 0;
     for (; gb < gemm_batch; gb++) {
@@ -597,6 +724,9 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
         data_C_ptr_ = CTX_OUT_MEM(char *, DNNL_ARG_DST);
 
         bias_ptr_ = CTX_IN_MEM(const char *, DNNL_ARG_BIAS);
+        group_offsets_ = CTX_IN_MEM(const int32_t *, DNNL_ARG_GROUP_OFFSETS);
+        bias_group_stride_
+                = pd->is_bias_Gx1xN() ? bgmmc_.N * bgmmc_.bias_dt_sz : 0;
         oscales_ptr_ = pd->attr()->output_scales_.scales_;
         memory_tracking::grantor_t scratchpad = ctx.get_scratchpad_grantor();
         const auto &bgmmc = pd->get_brgemm_matmul_conf();
@@ -604,6 +734,19 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
         batch_element_ptr_ = scratchpad.template get<brgemm_batch_element_t>(
                 key_brgemm_primitive_batch);
 
+        // with src dynamic quantization the computations use the quantized
+        // copy of src
+        src_quantized_ptr_ = bgmmc.with_src_dyn_quant
+                ? scratchpad.template get<int8_t>(
+                        key_brgemm_primitive_src_quantized)
+                : nullptr;
+        src_row_scales_ptr_ = bgmmc.with_src_dyn_quant
+                ? scratchpad.template get<float>(
+                        key_brgemm_primitive_src_row_scales)
+                : nullptr;
+        if (bgmmc.with_src_dyn_quant)
+            data_A_ptr_ = reinterpret_cast<const char *>(src_quantized_ptr_);
+
         const bool use_buffer_a
                 = bgmmc.use_buffer_a || bgmmc.use_buffer_a_tail_only;
         buf_A_ptr_ = (use_buffer_a)
@@ -673,8 +816,33 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
                     = (int32_t *)&data_B_ptr_[reorder_zp_a_comp_offset];
         }
 
+        // For runtime M the number of rows and the batch strides of src and
+        // dst are taken from the memory descriptors passed at execution
+        M_ = bgmmc.M;
+        A_batch_stride_ = bgmmc.A_strides[2];
+        C_batch_stride_ = bgmmc.C_strides[2];
+        if (bgmmc.is_runtime_M) {
+            const auto src_d = ctx.memory_mdw(DNNL_ARG_SRC, pd->src_md());
+            const auto dst_d = ctx.memory_mdw(DNNL_ARG_DST, pd->dst_md());
+            const int ndims = dst_d.ndims();
+            M_ = dst_d.dims()[ndims - 2];
+            if (ndims > 2) {
+                A_batch_stride_ = bgmmc.a_dt_sz
+                        * src_d.blocking_desc().strides[ndims - 3];
+                C_batch_stride_ = bgmmc.c_dt_sz
+                        * dst_d.blocking_desc().strides[ndims - 3];
+            }
+        }
+        num_M_blocks_ = div_up(M_, bgmmc.M_blk);
+        M_chunks_ = div_up(num_M_blocks_, bgmmc.M_chunk_size);
+
         // parallelization
-        parallel_work_amount_ = bgmmc.batch * bgmmc.M_chunks * bgmmc.N_chunks;
+        parallel_work_amount_ = bgmmc.batch * M_chunks_ * bgmmc.N_chunks;
+        if (bgmmc.is_grouped) {
+            parallel_work_amount_ = 0;
+            for (int b = 0; b < bgmmc.batch; b++)
+                parallel_work_amount_ += get_M_chunks(b) * bgmmc.N_chunks;
+        }
 
         // The number of threads available during primitive execution may
         // increase (ex. Eigen threadpool implementation) or decrease
@@ -739,9 +907,59 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
         return bb_idx;
     }
 
+    // Number of rows and the first row of the src and dst matrices for the
+    // batch element, for grouped problems they are defined by group offsets
+    dim_t get_M(int b) const {
+        return bgmmc_.is_grouped ? group_offsets_[b + 1] - group_offsets_[b]
+                                 : M_;
+    }
+    dim_t get_M_offset(int b) const {
+        return bgmmc_.is_grouped ? group_offsets_[b] : 0;
+    }
+    int get_num_M_blocks(int b) const {
+        return bgmmc_.is_grouped ? div_up(get_M(b), bgmmc_.M_blk)
+                                 : num_M_blocks_;
+    }
+    int get_M_chunks(int b) const {
+        return bgmmc_.is_grouped
+                ? div_up(get_num_M_blocks(b), bgmmc_.M_chunk_size)
+                : M_chunks_;
+    }
+
+    // Iterates over (b, mc, nc) parallel work, empty groups are skipped
+    void init_bmn_idx(int start, int &b, int &mc, int &nc) const {
+        if (!bgmmc_.is_grouped) {
+            nd_iterator_init(
+                    start, b, bgmmc_.batch, mc, M_chunks_, nc, bgmmc_.N_chunks);
+            return;
+        }
+        b = 0;
+        while (b < bgmmc_.batch
+                && start >= get_M_chunks(b) * bgmmc_.N_chunks) {
+            start -= get_M_chunks(b) * bgmmc_.N_chunks;
+            b++;
+        }
+        mc = nc = 0;
+        if (b < bgmmc_.batch)
+            nd_iterator_init(
+                    start, mc, get_M_chunks(b), nc, bgmmc_.N_chunks);
+    }
+    void step_bmn_idx(int &b, int &mc, int &nc) const {
+        if (!bgmmc_.is_grouped) {
+            nd_iterator_step(
+                    b, bgmmc_.batch, mc, M_chunks_, nc, bgmmc_.N_chunks);
+            return;
+        }
+        if (!nd_iterator_step(mc, get_M_chunks(b), nc, bgmmc_.N_chunks))
+            return;
+        do {
+            b++;
+        } while (b < bgmmc_.batch && get_M_chunks(b) == 0);
+    }
+
     const char *get_data_A_ptr(int b, int m, int k) const {
         int cur_b = get_bb_idx(b, bgmmc_.bcast_A_desc);
-        return data_A_ptr_ + get_data_A_off(cur_b, m, k);
+        return data_A_ptr_ + get_data_A_off(cur_b, get_M_offset(b) + m, k);
     }
 
     const char *get_data_B_ptr(int b, int k, int n) const {
@@ -750,7 +968,7 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
     }
 
     char *get_data_C_ptr(int b, int m, int n) const {
-        return data_C_ptr_ + get_data_C_off(b, m, n);
+        return data_C_ptr_ + get_data_C_off(b, get_M_offset(b) + m, n);
     }
 
     brgemm_batch_element_t *get_batch_elem_ptr(int ithr) const {
@@ -760,10 +978,11 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
 
     void init_brgemm_batch_elements_values(int ithr, int brg_batch_start,
             int brg_batch_iters, int b_idx, int m_blk_idx, int k_blk_idx,
-            int n_blk_idx) const {
+            int n_blk_idx, int m_off = 0) const {
         auto addr_batch = get_batch_elem_ptr(ithr);
 
-        const int m = m_blk_idx * bgmmc_.M_blk;
+        const int m = m_blk_idx * bgmmc_.M_blk + m_off;
+        const dim_t buf_A_m_off = m_off * bgmmc_.LDA * bgmmc_.a_dt_sz;
         const int n = n_blk_idx * bgmmc_.N_blk;
 
         for (int b_iter = 0; b_iter < brg_batch_iters; b_iter++) {
@@ -771,6 +990,7 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
             const int k = (k_blk_idx + brg_batch_idx) * bgmmc_.K_blk;
             addr_batch[b_iter].ptr.A = bgmmc_.use_buffer_a
                     ? get_buf_A_ptr(ithr, m_blk_idx, brg_batch_idx)
+                            + buf_A_m_off
                     : get_data_A_ptr(b_idx, m, k);
             addr_batch[b_iter].ptr.B = (bgmmc_.use_buffer_b)
                     ? get_buf_B_ptr(ithr, brg_batch_idx, n_blk_idx)
@@ -834,7 +1054,7 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
     // strides for each tensor to get general sulution for all possible
     // dimension without significant overhead
     dim_t get_data_A_off(int b, int m, int k) const {
-        return bgmmc_.A_strides[2] * b + bgmmc_.A_strides[1] * m
+        return A_batch_stride_ * b + bgmmc_.A_strides[1] * m
                 + bgmmc_.A_strides[0] * k;
     }
     dim_t get_data_B_off(int b, int k, int n) const {
@@ -859,14 +1079,14 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
     }
 
     dim_t get_data_C_off(int b, int m, int n) const {
-        return bgmmc_.C_strides[2] * b + bgmmc_.C_strides[1] * m
+        return C_batch_stride_ * b + bgmmc_.C_strides[1] * m
                 + bgmmc_.C_strides[0] * n;
     }
 
-    const char *get_bias_ptr(int n) const {
+    const char *get_bias_ptr(int b, int n) const {
         if (!bgmmc_.with_bias) return nullptr;
 
-        return bias_ptr_ + n * bgmmc_.bias_dt_sz;
+        return bias_ptr_ + b * bias_group_stride_ + n * bgmmc_.bias_dt_sz;
     }
 
     int32_t *get_s8s8_comp_ptr(int ithr, int b, int n_blk_idx) const {
@@ -884,6 +1104,19 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
         return oscales_ptr_ + bgmmc_.is_oscale_per_n * n;
     }
 
+    int8_t *get_src_quantized_ptr() const { return src_quantized_ptr_; }
+    float *get_src_row_scales_ptr() const { return src_row_scales_ptr_; }
+
+    const float *get_src_row_scales_ptr(int b, int m) const {
+        if (!bgmmc_.with_src_dyn_quant) return nullptr;
+
+        // quantized src is dense, so the offset of the row defines its index
+        const int cur_b = get_bb_idx(b, bgmmc_.bcast_A_desc);
+        return src_row_scales_ptr_
+                + get_data_A_off(cur_b, get_M_offset(b) + m, 0)
+                / bgmmc_.A_strides[1];
+    }
+
     const int32_t *get_zp_a_neg_val_ptr() const {
         return &zero_point_a_negative_val_;
     }
@@ -995,7 +1228,11 @@ private:
 
     char *wsp_tile_ptr_;
     const char *bias_ptr_;
+    const int32_t *group_offsets_;
+    dim_t bias_group_stride_;
     const float *oscales_ptr_;
+    int8_t *src_quantized_ptr_;
+    float *src_row_scales_ptr_;
     int32_t *s8s8_compensation_ptr_;
 
     int32_t *zero_point_a_compensations_ptr_;
@@ -1011,6 +1248,9 @@ private:
     int base_brg_ker_idx_;
     int vnni_factor;
 
+    dim_t M_, A_batch_stride_, C_batch_stride_;
+    int num_M_blocks_, M_chunks_;
+
     // parallelization parameters
     int parallel_work_amount_;
     int nthr_, nthr_k_, nthr_bmn_, num_threads_used_;
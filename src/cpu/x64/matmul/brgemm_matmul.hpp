@@ -35,20 +35,31 @@ namespace x64 {
 namespace matmul {
 
 namespace {
-constexpr int max_num_brg_kernels_matmul = 2 * 2 * 2 * 2;
+// Besides the M_blk and M_tail kernels there are kernels for power-of-two
+// numbers of rows used for M tails known only at execution time
+constexpr int max_num_M_kernels = 2 + max_num_pow2_M_tails;
+constexpr int max_num_brg_kernels_matmul = 2 * 2 * 2 * max_num_M_kernels;
+
+inline dim_t get_brg_kernel_M(
+        const brgemm_matmul_conf_t &bgmmc, int m_ker_idx) {
+    if (m_ker_idx == 0) return bgmmc.M_blk;
+    if (m_ker_idx == 1) return bgmmc.M_tail;
+    const int pow2_idx = m_ker_idx - 2;
+    return pow2_idx < bgmmc.num_pow2_M_tails ? (dim_t)1 << pow2_idx : 0;
+}
 
 inline int get_brg_kernel_index(const brgemm_matmul_conf_t &bgmmc,
-        bool do_initialization, bool is_M_tail, bool is_N_tail,
+        bool do_initialization, int m_ker_idx, bool is_N_tail,
         bool is_K_tail) {
-    auto vM = (is_M_tail) ? bgmmc.M_tail : bgmmc.M_blk;
+    auto vM = get_brg_kernel_M(bgmmc, m_ker_idx);
     auto vN = (is_N_tail) ? bgmmc.N_tail : bgmmc.N_blk;
     auto vK = (is_K_tail) ? bgmmc.K_tail : bgmmc.K_blk;
     if (vM == 0 || vN == 0 || vK == 0 || bgmmc.LDA < vK || bgmmc.LDB < vN
             || bgmmc.LDC < vN)
         return -1;
 
-    int idx = 8 * (int)do_initialization + 4 * (int)is_M_tail
-            + 2 * (int)is_N_tail + (int)is_K_tail;
+    int idx = 8 * m_ker_idx + 4 * (int)do_initialization + 2 * (int)is_N_tail
+            + (int)is_K_tail;
 
     assert(idx < max_num_brg_kernels_matmul);
     return idx;
@@ -65,10 +76,11 @@ struct brgemm_matmul_t : public primitive_t {
                 JIT_IMPL_NAME_HELPER("brg:", isa, ""), brgemm_matmul_t);
 
         status_t init(engine_t *engine);
-        int get_brg_kernel_idx(bool do_initialization, bool is_M_tail,
+        // m_ker_idx: 0 - M_blk rows, 1 - M_tail rows, 2 + i - 2^i rows
+        int get_brg_kernel_idx(bool do_initialization, int m_ker_idx,
                 bool is_N_tail, bool is_K_tail) const {
             return get_brg_kernel_index(
-                    bgmmc_, do_initialization, is_M_tail, is_N_tail, is_K_tail);
+                    bgmmc_, do_initialization, m_ker_idx, is_N_tail, is_K_tail);
         }
         const brgemm_t &get_brg_desc(int idx) const { return brg_descs_[idx]; }
         const brgemm_matmul_conf_t &get_brgemm_matmul_conf() const {
@@ -95,9 +107,14 @@ private:
 
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
     status_t execute_body(const exec_ctx_t &ctx) const;
+    void quantize_src(
+            const brg_matmul_exec_ctx_t &brgmm_ctx, const char *src) const;
     void compute_kernel(const brg_matmul_exec_ctx_t &brgmm_ctx, int ithr,
             int b_idx, int m_blk_idx, int n_blk_idx, int k_blk_idx,
             bool do_init) const;
+    void compute_kernel_rows(const brg_matmul_exec_ctx_t &brgmm_ctx, int ithr,
+            int b_idx, int m_blk_idx, int n_blk_idx, int k_blk_idx,
+            bool do_init, int m_off, int m_ker_idx) const;
     void copy_a_chunk_in_buffer(const brg_matmul_exec_ctx_t &brgmm_ctx,
             int ithr, int b_idx, int m_blk_idx, int k_blk_idx) const;
     void copy_b_chunk_in_buffer(const brg_matmul_exec_ctx_t &brgmm_ctx,
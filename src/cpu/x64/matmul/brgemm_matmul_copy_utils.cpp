@@ -1384,6 +1384,7 @@ private:
     reg32_t regw_tmp = r14d;
     reg64_t imm_addr64 = r15;
 
+    zmm zmm_zp_b_neg_val = zmm29;
     zmm zmm_permw = zmm30;
     zmm zmm_zero = zmm31;
 
@@ -1403,7 +1404,7 @@ void jit_brgemm_matmul_copy_b_bf16_t::copy_2x32_vnni(int nrows, int ncolumns) {
     if (columns_tail < n_blk_step) kmovd(kTail, tail_mask);
 
     const int blk_sz = k_blk_step;
-    const int max_regs_available = 30;
+    const int max_regs_available = 28;
     const int max_unroll = max_regs_available / blk_sz;
     auto get_zmm = [=](int blk, int idx) {
         assert(idx >= 0 && idx < blk_sz && blk >= 0);
@@ -1415,8 +1416,17 @@ void jit_brgemm_matmul_copy_b_bf16_t::copy_2x32_vnni(int nrows, int ncolumns) {
     auto load = [=](int blk, int k, int n, opmask_t current_mask) {
         auto src_reg = get_zmm(blk, k % k_blk_step);
         auto src_load = src_reg | current_mask | T_z;
-        vmovdqu16(src_load,
-                EVEX_compress_addr(reg_src, k * src_stride + n * typesize));
+        const dim_t src_off = k * src_stride + n * conf_->b_dt_sz;
+        if (!conf_->with_wei_decompression) {
+            vmovdqu16(src_load, EVEX_compress_addr(reg_src, src_off));
+            return;
+        }
+        // s8 -> s32 (-> minus zero point) -> f32 -> bf16
+        vpmovsxbd(src_load, ptr[reg_src + src_off]);
+        if (conf_->with_wei_decompression_zp)
+            vpaddd(src_load, src_reg, zmm_zp_b_neg_val);
+        vcvtdq2ps(src_reg, src_reg);
+        vcvtneps2bf16(ymm(src_reg.getIdx()), src_reg);
     };
 
     int iter = 0;
@@ -1452,7 +1462,7 @@ void jit_brgemm_matmul_copy_b_bf16_t::copy_2x32_vnni(int nrows, int ncolumns) {
 void jit_brgemm_matmul_copy_b_bf16_t::generate() {
     preamble();
     vpxord(zmm_zero, zmm_zero, zmm_zero);
-    src_stride = conf_->N * typesize;
+    src_stride = conf_->N * conf_->b_dt_sz;
     tr_src_stride = conf_->LDB * k_blk_step * typesize;
 
     alignas(64) static constexpr const int16_t bf16_vnni_permute[32]
@@ -1463,6 +1473,10 @@ void jit_brgemm_matmul_copy_b_bf16_t::generate() {
     mov(reg_tr_src, ptr[param1 + GET_OFF(tr_src)]);
     mov(reg_K_iters, ptr[param1 + GET_OFF(current_K_iters)]);
     mov(reg_N_blk, ptr[param1 + GET_OFF(current_N_blk)]);
+    if (conf_->with_wei_decompression_zp) {
+        mov(imm_addr64, ptr[param1 + GET_OFF(zp_b_neg_value_ptr)]);
+        vpbroadcastd(zmm_zp_b_neg_val, ptr[imm_addr64]);
+    }
 
     auto kmovw = [=](Opmask k, unsigned w) {
         mov(regw_tmp, w);
@@ -1542,7 +1556,7 @@ struct jit_brgemm_matmul_copy_b_f32_t : public jit_brgemm_matmul_copy_b_t,
 
     jit_brgemm_matmul_copy_b_f32_t(const brgemm_matmul_conf_t *conf)
         : jit_brgemm_matmul_copy_b_t(conf)
-        , src_stride_(conf_->N * typesize)
+        , src_stride_(conf_->N * conf_->b_dt_sz)
         , tr_src_stride_(conf_->LDB * typesize) {}
 
     void operator()(ctx_t *ctx) override { jit_generator::operator()(ctx); }
@@ -1554,7 +1568,7 @@ private:
     using opmask_t = const Xbyak::Opmask;
     using zmm = const Xbyak::Zmm;
 
-    enum { typesize = sizeof(float), n_blk_step = 16, max_regs_available = 30 };
+    enum { typesize = sizeof(float), n_blk_step = 16, max_regs_available = 29 };
     dim_t src_stride_, tr_src_stride_;
 
     opmask_t kTail = k7;
@@ -1569,6 +1583,7 @@ private:
     reg32_t regw_tmp = r14d;
     reg64_t imm_addr64 = r15;
 
+    zmm zmm_zp_b_neg_val = zmm29;
     zmm zmm_permw = zmm30;
     zmm zmm_zero = zmm31;
 
@@ -1592,8 +1607,16 @@ void jit_brgemm_matmul_copy_b_f32_t::copy_16_x_n_block(
     auto load = [=](int blk, int k, int n, opmask_t current_mask) {
         auto src_zmm = get_zmm(blk);
         auto src_zmm_m = src_zmm | current_mask | T_z;
-        vmovups(src_zmm_m,
-                EVEX_compress_addr(reg_src, k * src_stride_ + n * typesize));
+        const dim_t src_off = k * src_stride_ + n * conf_->b_dt_sz;
+        if (!conf_->with_wei_decompression) {
+            vmovups(src_zmm_m, EVEX_compress_addr(reg_src, src_off));
+            return;
+        }
+        // s8 -> s32 (-> minus zero point) -> f32
+        vpmovsxbd(src_zmm_m, ptr[reg_src + src_off]);
+        if (conf_->with_wei_decompression_zp)
+            vpaddd(src_zmm_m, src_zmm, zmm_zp_b_neg_val);
+        vcvtdq2ps(src_zmm, src_zmm);
     };
 
     const int columns_tail = ncolumns % n_blk_step;
@@ -1654,6 +1677,10 @@ void jit_brgemm_matmul_copy_b_f32_t::generate() {
     mov(reg_tr_src, ptr[param1 + GET_OFF(tr_src)]);
     mov(reg_K_iters, ptr[param1 + GET_OFF(current_K_iters)]);
     mov(reg_N_blk, ptr[param1 + GET_OFF(current_N_blk)]);
+    if (conf_->with_wei_decompression_zp) {
+        mov(imm_addr64, ptr[param1 + GET_OFF(zp_b_neg_value_ptr)]);
+        vpbroadcastd(zmm_zp_b_neg_val, ptr[imm_addr64]);
+    }
     kmovw(kFFFF, 0xffff); // 1111111111111111
 
     Label done;
@@ -2062,6 +2089,8 @@ status_t create_brgemm_matmul_copy_b(
     const bool is_bf16
             = everyone_is(data_type::bf16, conf->src_dt, conf->wei_dt);
     const bool is_f32 = everyone_is(data_type::f32, conf->src_dt, conf->wei_dt);
+    // weights are decompressed only by the copy routines for plain B
+    assert(IMPLICATION(conf->with_wei_decompression, !is_B_transposed));
     if (is_B_transposed) {
         CHECK(safe_ptr_assign(
                 copy_ker, new jit_brgemm_matmul_copy_b_transposed_t(conf)));
@@ -38,6 +38,10 @@ using namespace dnnl::impl::utils;
 using namespace data_type;
 using namespace format_tag;
 
+// Number of rows the blocking is chosen for when M is defined at execution
+// time. It is large enough for the heuristics to pick full M blocks.
+constexpr dim_t runtime_M_blocking_hint = 512;
+
 // TODO: add support of post-ops with multiple binary and eltwise execution
 bool post_ops_ok(brgemm_matmul_conf_t &bgmmc, const primitive_attr_t &attr,
         const memory_desc_wrapper &dst_d) {
@@ -102,18 +106,18 @@ status_t brgemm_matmul_conf_utils_t::set_or_check_B_tag(
     if (B_any_layout) {
         bgmmc.wei_tag = blocked_B_layouts_allowed
                 ? this->pick_blocked_B_layout(bgmmc.wei_n_blk)
-                : plain_tensor_layout_tag;
+                : plain_B_layout_tag;
         if (format_tag::undef == bgmmc.wei_tag) return status::unimplemented;
 
         CHECK(memory_desc_init_by_tag(B_md, bgmmc.wei_tag));
     } else {
         bgmmc.wei_tag = blocked_B_layouts_allowed
-                ? memory_desc_matches_one_of_tag(B_md, plain_tensor_layout_tag,
-                        transposed_tensor_layout_tag, blocked_64n_B_layout_tag,
+                ? memory_desc_matches_one_of_tag(B_md, plain_B_layout_tag,
+                        transposed_B_layout_tag, blocked_64n_B_layout_tag,
                         blocked_48n_B_layout_tag, blocked_32n_B_layout_tag,
                         blocked_16n_B_layout_tag)
-                : memory_desc_matches_one_of_tag(B_md, plain_tensor_layout_tag,
-                        transposed_tensor_layout_tag);
+                : memory_desc_matches_one_of_tag(
+                        B_md, plain_B_layout_tag, transposed_B_layout_tag);
         if (format_tag::undef == bgmmc.wei_tag) return status::unimplemented;
     }
 
@@ -157,7 +161,9 @@ status_t brgemm_matmul_conf_utils_t::set_or_check_tags(memory_desc_t &A_md,
         return status::unimplemented;
 
     if (bgmmc.with_bias && bias_any_layout)
-        CHECK(memory_desc_init_by_tag(bias_md, plain_tensor_layout_tag));
+        CHECK(memory_desc_init_by_tag(bias_md,
+                bgmmc.is_grouped ? plain_B_layout_tag
+                                 : plain_tensor_layout_tag));
 
     return status::success;
 }
@@ -185,7 +191,8 @@ status_t brgemm_matmul_conf_utils_t::set_B_flags(memory_desc_t &B_md) const {
 
 format_tag_t brgemm_matmul_conf_utils_t::pick_blocked_B_layout(
         int n_blk) const {
-    if (bgmmc.ndims > 2) return format_tag::undef;
+    if (bgmmc.ndims > 2 || bgmmc.is_grouped || bgmmc.with_wei_decompression)
+        return format_tag::undef;
     if (this->is_int8()) switch (n_blk) {
             case 64: return BA16a64b4a;
             case 48: return BA16a48b4a;
@@ -445,7 +452,11 @@ void compute_blocking_heuristic_amx(const brgemm_matmul_conf_t &bgmmc,
     const int max_k_parallel_work
             = div_up(static_cast<int>(bgmmc.K), min_k_per_thread);
     const bool is_amx_bf16 = bgmmc.isa == avx512_core_bf16_amx_bf16;
-    const int max_nthr_k = is_amx_bf16 && bgmmc.batch == 1
+    // parallel reduction is not supported for batched and grouped problems
+    // and requires M to be known at creation time
+    const bool k_parallel_ok = is_amx_bf16 && bgmmc.batch == 1
+            && !bgmmc.is_grouped && !bgmmc.is_runtime_M;
+    const int max_nthr_k = k_parallel_ok
             ? nstl::min(saturate(1, 7, bgmmc.nthr / 8), max_k_parallel_work)
             : 1;
     int iter = 0;
@@ -546,7 +557,7 @@ float compute_blocking_heuristic_avx512(brgemm_matmul_conf_t &bgmmc,
 
             // force to plain B (wei) in small spatial size for FWD:
             // note: this showed significant performance gain in WnD shapes
-            bool is_FWD = !(bm_conf_utils.check_is_transposed(bgmmc.wei_tag)
+            bool is_FWD = !(bm_conf_utils.check_is_transposed_B(bgmmc.wei_tag)
                     || bm_conf_utils.check_is_transposed(bgmmc.src_tag));
             if (bgmmc.use_buffer_b && is_FWD) {
                 bgmmc.use_buffer_b = bm_conf_utils.use_buffer_b(false);
@@ -689,12 +700,20 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     bgmmc.src_dt = src_d.data_type();
     bgmmc.dst_dt = dst_d.data_type();
     bgmmc.wei_dt = weights_d.data_type();
+    bgmmc.orig_src_dt = bgmmc.src_dt;
+    bgmmc.with_src_dyn_quant = attr.src_dyn_quant_dt_ != data_type::undef;
+    if (bgmmc.with_src_dyn_quant) bgmmc.src_dt = attr.src_dyn_quant_dt_;
+    bgmmc.orig_wei_dt = bgmmc.wei_dt;
+    bgmmc.with_wei_decompression
+            = one_of(bgmmc.src_dt, f32, bf16) && bgmmc.orig_wei_dt == s8;
+    if (bgmmc.with_wei_decompression) bgmmc.wei_dt = bgmmc.src_dt;
 
     bgmmc.with_bias = mmd.bias_desc.format_kind != format_kind::undef;
     bgmmc.bia_dt = bgmmc.with_bias ? mmd.bias_desc.data_type : data_type::undef;
     bgmmc.s8s8_compensation_required
             = isa == avx512_core_vnni && bgmmc.src_dt == s8;
     bgmmc.ndims = dst_d.ndims();
+    bgmmc.is_grouped = mmd.primitive_kind == primitive_kind::matmul_grouped;
 
     brgemm_matmul_conf_utils_t bm_conf_utils(bgmmc,
             src_d.format_kind() == format_kind::any,
@@ -713,7 +732,8 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     bgmmc.acc_dt = bm_conf_utils.is_int8() ? s32 : f32;
 
     bgmmc.a_dt_sz = types::data_type_size(bgmmc.src_dt);
-    bgmmc.b_dt_sz = types::data_type_size(bgmmc.wei_dt);
+    bgmmc.b_dt_sz = types::data_type_size(bgmmc.orig_wei_dt);
+    bgmmc.tr_b_dt_sz = types::data_type_size(bgmmc.wei_dt);
     bgmmc.c_dt_sz = types::data_type_size(bgmmc.dst_dt);
     bgmmc.acc_dt_sz = types::data_type_size(bgmmc.acc_dt);
     if (bgmmc.with_bias) bgmmc.bias_dt_sz = types::data_type_size(bgmmc.bia_dt);
@@ -741,6 +761,13 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     bgmmc.wei_zp_type = get_zp_type(attr, DNNL_ARG_WEIGHTS);
     bgmmc.dst_zp_type = get_zp_type(attr, DNNL_ARG_DST);
 
+    // zero point of decompressed weights is applied by the copy routine for B
+    if (bgmmc.with_wei_decompression) {
+        bgmmc.with_wei_decompression_zp
+                = bgmmc.wei_zp_type != brgemm_broadcast_t::none;
+        bgmmc.wei_zp_type = brgemm_broadcast_t::none;
+    }
+
     if (!IMPLICATION(!bm_conf_utils.is_int8(),
                 everyone_is(brgemm_broadcast_t::none, bgmmc.src_zp_type,
                         bgmmc.wei_zp_type, bgmmc.dst_zp_type)))
@@ -761,6 +788,25 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     bgmmc.bcast_B_desc.set_params(
             weights_d.dims(), dst_d.dims(), bgmmc.batch_ndims, bgmmc.batch);
 
+    bgmmc.is_runtime_M = is_runtime_value(bgmmc.M);
+    if (bgmmc.is_runtime_M) {
+        // binary post-ops are initialized for the dst shape
+        if (bgmmc.is_grouped || bgmmc.with_binary)
+            return status::unimplemented;
+        bgmmc.M = runtime_M_blocking_hint;
+    }
+
+    // src is quantized into the scratchpad which size depends on M
+    if (bgmmc.with_src_dyn_quant && bgmmc.is_runtime_M)
+        return status::unimplemented;
+
+    if (bgmmc.is_grouped) {
+        // Groups are processed as a batch with the number of rows known only
+        // at execution time, so the blocking is chosen for an average group.
+        bgmmc.batch = weights_d.dims()[0];
+        bgmmc.M = nstl::max(div_up(bgmmc.M, bgmmc.batch), (dim_t)1);
+    }
+
     // required granularity for k dimension
     bgmmc.required_k_granularity
             = bgmmc.is_amx ? data_type_vnni_granularity(bgmmc.wei_dt) : 1;
@@ -775,6 +821,11 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     bgmmc.blocked_B = bm_conf_utils.get_blocked_B();
     bgmmc.use_buffer_b = bm_conf_utils.use_buffer_b();
 
+    // only plain weights can be decompressed by the copy routine for B
+    if (bgmmc.with_wei_decompression
+            && !bm_conf_utils.check_is_plain_B(bgmmc.wei_tag))
+        return status::unimplemented;
+
     bgmmc.transposed_A = bm_conf_utils.check_is_transposed(bgmmc.src_tag);
     const bool lda_is_big_2pow = bm_conf_utils.is_bf16() && !bgmmc.transposed_A
             && math::is_pow2(bgmmc.K) && bgmmc.K >= 4096 && bgmmc.M >= 1024;
@@ -785,9 +836,16 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
             || bgmmc.transposed_A || lda_is_big_2pow;
     bgmmc.use_buffer_a = is_copy_a_required;
 
+    // copy routine for transposed A assumes M is the leading dimension
+    if ((bgmmc.is_grouped || bgmmc.is_runtime_M) && bgmmc.transposed_A)
+        return status::unimplemented;
+
     if ((!bgmmc.is_amx) && bgmmc.wei_zp_type != brgemm_broadcast_t::none)
         return status::unimplemented; // TODO
 
+    if (bgmmc.with_src_dyn_quant && bgmmc.transposed_A)
+        return status::unimplemented;
+
     // Supported computation with copy only part of A related to K_tail if
     // is_copy_a_required == true, but the current performance measurements
     // show worse performance for it in comparison with copy whole A approach
@@ -810,6 +868,12 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     CHECK(bm_conf_utils.set_B_flags(weights_md));
 
     bgmmc.M_tail = bgmmc.M % bgmmc.M_blk;
+    if (bgmmc.is_grouped || bgmmc.is_runtime_M) {
+        bgmmc.M_blk = nstl::min(bgmmc.M_blk, (dim_t)1 << max_num_pow2_M_tails);
+        bgmmc.M_tail = 0;
+        while ((1 << bgmmc.num_pow2_M_tails) < bgmmc.M_blk)
+            bgmmc.num_pow2_M_tails++;
+    }
     bgmmc.N_tail = bgmmc.N % bgmmc.N_blk;
     bgmmc.K_tail = bgmmc.K > bgmmc.K_blk
             ? rnd_up(bgmmc.K % bgmmc.K_blk, bgmmc.required_k_granularity)
@@ -851,8 +915,8 @@ void init_aux_values(brgemm_matmul_conf_t &bgmmc,
     bgmmc.buffer_a_per_thread_sz
             = bgmmc.buffer_a_chunk_shift_along_m * bgmmc.M_chunk_size;
 
-    bgmmc.buffer_b_chunk_sz
-            = bgmmc.b_dt_sz * bgmmc.LDB * rnd_up(bgmmc.K_blk, bgmmc.wei_k_blk);
+    bgmmc.buffer_b_chunk_sz = bgmmc.tr_b_dt_sz * bgmmc.LDB
+            * rnd_up(bgmmc.K_blk, bgmmc.wei_k_blk);
     bgmmc.buffer_b_per_thread_sz
             = bgmmc.buffer_b_chunk_sz * bgmmc.brgemm_batch_size;
 
@@ -867,9 +931,24 @@ void init_aux_values(brgemm_matmul_conf_t &bgmmc,
     for (int d = 0; d < dmax; d++) {
         int dim = bgmmc.ndims - 1 - d;
         bgmmc.A_strides[d] = bgmmc.a_dt_sz * src_d.blocking_desc().strides[dim];
-        bgmmc.B_strides[d] = bgmmc.b_dt_sz * wei_d.blocking_desc().strides[dim];
         bgmmc.C_strides[d] = bgmmc.c_dt_sz * dst_d.blocking_desc().strides[dim];
     }
+    // quantized src is stored in a dense buffer with the shape of src
+    if (bgmmc.with_src_dyn_quant) {
+        const int ndims = src_d.ndims();
+        bgmmc.src_quant_rows = src_d.nelems() / bgmmc.K;
+        bgmmc.A_strides[0] = bgmmc.a_dt_sz;
+        bgmmc.A_strides[1] = bgmmc.a_dt_sz * src_d.dims()[ndims - 1];
+        if (ndims > 2)
+            bgmmc.A_strides[2]
+                    = bgmmc.A_strides[1] * src_d.dims()[ndims - 2];
+    }
+    // weights of grouped matmul have an extra groups dimension
+    const int B_ndims = wei_d.ndims();
+    for (int d = 0; d < nstl::min(B_ndims, 3); d++) {
+        int dim = B_ndims - 1 - d;
+        bgmmc.B_strides[d] = bgmmc.b_dt_sz * wei_d.blocking_desc().strides[dim];
+    }
 
     bgmmc.has_zero_point_a = bgmmc.src_zp_type != brgemm_broadcast_t::none;
     bgmmc.has_zero_point_b = bgmmc.wei_zp_type != brgemm_broadcast_t::none;
@@ -878,7 +957,7 @@ void init_aux_values(brgemm_matmul_conf_t &bgmmc,
             bgmmc.with_scales, bgmmc.with_eltwise, bgmmc.with_binary,
             bgmmc.acc_dt != bgmmc.dst_dt, bgmmc.s8s8_compensation_required,
             bgmmc.has_zero_point_a, bgmmc.has_zero_point_b,
-            bgmmc.has_zero_point_c);
+            bgmmc.has_zero_point_c, bgmmc.with_src_dyn_quant);
 
     bgmmc.zp_a_comp_shift_n = bgmmc.wei_n_blk;
     bgmmc.zp_a_comp_elems_per_thr
@@ -932,6 +1011,14 @@ void init_scratchpad(memory_tracking::registrar_t &scratchpad,
                 bgmmc.nthr * bgmmc.zp_b_comp_elems_per_thr,
                 types::data_type_size(s32));
 
+    if (bgmmc.with_src_dyn_quant) {
+        scratchpad.book(key_brgemm_primitive_src_quantized,
+                bgmmc.a_dt_sz * bgmmc.src_quant_rows * bgmmc.K,
+                default_data_align);
+        scratchpad.book(key_brgemm_primitive_src_row_scales,
+                bgmmc.src_quant_rows, types::data_type_size(f32));
+    }
+
     if (one_of(bgmmc.isa, avx512_core_bf16_amx_int8, avx512_core_bf16_amx_bf16))
         scratchpad.book(key_conv_amx_tile_buffer,
                 bgmmc.nthr * bgmmc.wsp_tile_per_thr_bytes, default_data_align);
@@ -29,6 +29,8 @@ namespace x64 {
 namespace matmul {
 
 constexpr int max_batch_ndims = DNNL_MAX_NDIMS - 2;
+// Bounds M_blk when M tails are only known at execution time
+constexpr int max_num_pow2_M_tails = 6;
 
 struct brgemm_matmul_bcast_desc_t {
 
@@ -78,8 +80,15 @@ struct brgemm_matmul_bcast_desc_t {
 
 struct brgemm_matmul_conf_t {
     int ndims, batch_ndims;
+    // For grouped matmul the batch is the number of groups and M is the
+    // average number of rows per group, used only to choose the blocking.
+    // The same holds for runtime M, which is replaced by a blocking hint.
     dim_t M, N, K, batch, batch_without_first_dim;
     dim_t M_blk, N_blk, K_blk, M_tail, N_tail, K_tail;
+    bool is_grouped, is_runtime_M;
+    // M tails that are only known at execution time are computed by a
+    // sequence of kernels for M equal to the powers of two below M_blk.
+    int num_pow2_M_tails;
     int M_chunk_size, N_chunk_size;
     dim_t LDA, LDB, LDC, LDD;
     int brgemm_batch_size;
@@ -116,8 +125,23 @@ struct brgemm_matmul_conf_t {
     int nthr;
     int nthr_k;
 
+    // With weights decompression the s8 weights (orig_wei_dt) are converted
+    // to the src data type (wei_dt) by the copy routine for B.
+    bool with_wei_decompression;
+    bool with_wei_decompression_zp;
+    data_type_t orig_wei_dt;
+
+    // With src dynamic quantization the rows of src (orig_src_dt) are
+    // quantized to src_dt into a dense buffer before the computations and
+    // the result rows are multiplied by the scales of src rows.
+    bool with_src_dyn_quant;
+    data_type_t orig_src_dt;
+    dim_t src_quant_rows;
+
     // Auxiliary values for init_config() and execute()
-    dim_t a_dt_sz, b_dt_sz, c_dt_sz, acc_dt_sz, bias_dt_sz;
+    // b_dt_sz is the size of the weights data type in memory and tr_b_dt_sz
+    // is the size of the data type of B in the copy buffer.
+    dim_t a_dt_sz, b_dt_sz, tr_b_dt_sz, c_dt_sz, acc_dt_sz, bias_dt_sz;
 
     int M_chunks;
     int N_chunks;
@@ -173,12 +197,13 @@ struct brgemm_matmul_conf_utils_t {
         using namespace format_tag;
 
         // uses 'batch_ndims'
-        plain_tensor_layout_tag = utils::pick(bgmmc.ndims - 2, ab, abc, abcd,
-                abcde, abcdef, abcdefg, abcdefgh, abcdefghi, abcdefghij,
-                abcdefghijk, abcdefghijkl);
-        transposed_tensor_layout_tag = utils::pick(bgmmc.ndims - 2, ba, acb,
-                abdc, abced, abcdfe, abcdegf, abcdefhg, abcdefgih, abcdefghji,
-                abcdefghikj, abcdefghijlk);
+        plain_tensor_layout_tag = get_plain_tag(bgmmc.ndims);
+        transposed_tensor_layout_tag = get_transposed_tag(bgmmc.ndims);
+
+        // weights of grouped matmul have an extra groups dimension
+        const int B_ndims = bgmmc.ndims + bgmmc.is_grouped;
+        plain_B_layout_tag = get_plain_tag(B_ndims);
+        transposed_B_layout_tag = get_transposed_tag(B_ndims);
 
         blocked_64n_B_layout_tag = pick_blocked_B_layout(64);
         blocked_48n_B_layout_tag = pick_blocked_B_layout(48);
@@ -206,6 +231,7 @@ struct brgemm_matmul_conf_utils_t {
     }
 
     inline bool use_buffer_b(bool use_heuristic = true) const {
+        if (bgmmc.with_wei_decompression) return true;
         if (bgmmc.is_amx) return !bgmmc.blocked_B;
 
         // Values based on measured performance difference
@@ -213,15 +239,16 @@ struct brgemm_matmul_conf_utils_t {
         size_t big_LDB = bgmmc.N > 256;
         size_t is_pow2 = math::is_pow2(bgmmc.N);
         bool f32_use_copy_buffer = use_heuristic
-                && this->check_is_plain(bgmmc.wei_tag) && (big_LDB && is_pow2);
+                && this->check_is_plain_B(bgmmc.wei_tag)
+                && (big_LDB && is_pow2);
         return this->is_f32()
                 && (f32_use_copy_buffer
-                        || this->check_is_transposed(bgmmc.wei_tag));
+                        || this->check_is_transposed_B(bgmmc.wei_tag));
     }
 
     inline dim_t get_actual_LDB() const {
         bool use_blocked_LDB = bgmmc.is_amx || bgmmc.use_buffer_b
-                || bgmmc.wei_tag != plain_tensor_layout_tag;
+                || bgmmc.wei_tag != plain_B_layout_tag;
         return use_blocked_LDB ? bgmmc.wei_n_blk : bgmmc.N;
     }
 
@@ -235,6 +262,14 @@ struct brgemm_matmul_conf_utils_t {
         return tag == plain_tensor_layout_tag;
     }
 
+    inline bool check_is_transposed_B(format_tag_t tag) const {
+        return tag == transposed_B_layout_tag;
+    }
+
+    inline bool check_is_plain_B(format_tag_t tag) const {
+        return tag == plain_B_layout_tag;
+    }
+
     inline bool is_f32() const { return f32_dt; }
 
     inline bool is_bf16() const { return bf16_dt; }
@@ -249,6 +284,18 @@ struct brgemm_matmul_conf_utils_t {
     format_tag_t pick_blocked_B_layout(int n_blk) const;
 
 private:
+    static format_tag_t get_plain_tag(int ndims) {
+        using namespace format_tag;
+        return utils::pick(ndims - 2, ab, abc, abcd, abcde, abcdef, abcdefg,
+                abcdefgh, abcdefghi, abcdefghij, abcdefghijk, abcdefghijkl);
+    }
+
+    static format_tag_t get_transposed_tag(int ndims) {
+        using namespace format_tag;
+        return utils::pick(ndims - 2, ba, acb, abdc, abced, abcdfe, abcdegf,
+                abcdefhg, abcdefgih, abcdefghji, abcdefghikj, abcdefghijlk);
+    }
+
     brgemm_matmul_conf_t &bgmmc;
 
     const bool f32_dt, bf16_dt, int8_dt;
@@ -260,6 +307,8 @@ private:
 
     format_tag_t plain_tensor_layout_tag;
     format_tag_t transposed_tensor_layout_tag;
+    format_tag_t plain_B_layout_tag;
+    format_tag_t transposed_B_layout_tag;
     format_tag_t blocked_64n_B_layout_tag, blocked_48n_B_layout_tag,
             blocked_32n_B_layout_tag, blocked_16n_B_layout_tag;
     bool blocked_B_layouts_allowed;
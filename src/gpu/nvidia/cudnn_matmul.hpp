@@ -43,6 +43,8 @@ struct cudnn_matmul_t : public primitive_t {
             using namespace data_type;
             using smask_t = primitive_attr_t::skip_mask_t;
 
+            if (is_grouped()) return status::unimplemented;
+
             data_type_t src_dt = src_md()->data_type;
             data_type_t dst_dt = dst_md()->data_type;
             data_type_t wei_dt = weights_md(0)->data_type;
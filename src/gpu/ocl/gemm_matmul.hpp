@@ -43,6 +43,8 @@ struct gemm_matmul_t : public gpu_primitive_t {
         status_t init(engine_t *engine) {
             using namespace data_type;
 
+            if (is_grouped()) return status::unimplemented;
+
             primitive_attr_t gemm_attr;
             if (!attr()->output_scales_.has_default_values()) {
                 gemm_attr.output_scales_.copy_from(attr()->output_scales_);
@@ -45,6 +45,8 @@ struct ref_matmul_t : public gpu_primitive_t {
             using namespace data_type;
             using smask_t = primitive_attr_t::skip_mask_t;
 
+            if (is_grouped()) return status::unimplemented;
+
             src_dt_ = src_md()->data_type;
             dst_dt_ = dst_md()->data_type;
             wei_dt_ = weights_md(0)->data_type;
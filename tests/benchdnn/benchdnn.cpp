@@ -33,6 +33,7 @@
 #include "conv/conv.hpp"
 #include "conv/deconv.hpp"
 #include "eltwise/eltwise.hpp"
+#include "graph/graph.hpp"
 #include "ip/ip.hpp"
 #include "lnorm/lnorm.hpp"
 #include "lrn/lrn.hpp"
@@ -60,6 +61,8 @@ const char *driver_name = "";
 double max_ms_per_prb {3e3};
 int min_times_per_prb {5};
 int fix_times_per_prb {0};
+int n_instances {1};
+int instance_nthr {0};
 
 bool fast_ref_gpu {DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE};
 
@@ -83,6 +86,8 @@ int main(int argc, char **argv) {
     for (; argc > 0; --argc, ++argv)
         if (!parse_bench_settings(argv[0])) break;
 
+    if (import_primitive_cache() != OK) return 1;
+
     if (!strcmp("--self", argv[0])) {
         self::bench(--argc, ++argv);
     } else if (!strcmp("--conv", argv[0])) {
@@ -125,10 +130,14 @@ int main(int argc, char **argv) {
         reduction::bench(--argc, ++argv);
     } else if (!strcmp("--zeropad", argv[0])) {
         zeropad::bench(--argc, ++argv);
+    } else if (!strcmp("--graph", argv[0])) {
+        graph::bench(--argc, ++argv);
     } else {
         fprintf(stderr, "err: unknown driver\n");
     }
 
+    if (export_primitive_cache() != OK) return 1;
+
     printf("tests:%d passed:%d "
            "skipped:%d mistrusted:%d unimplemented:%d "
            "failed:%d listed:%d\n",
@@ -83,6 +83,7 @@ const char *skip_reason2str(skip_reason_t skip_reason) {
     CASE(NOT_ENOUGH_RAM);
     CASE(SKIP_IMPL_HIT);
     CASE(SKIP_START);
+    CASE(SKIP_CAPTURED);
 #undef CASE
     return "SKIP_UNKNOWN";
 }
@@ -116,6 +117,8 @@ void parse_result(
             break;
         case SKIPPED:
             assert(status == OK);
+            // A captured primitive is executed by its owner, not a test case.
+            if (res.reason == SKIP_CAPTURED) break;
             BENCHDNN_PRINT(0, "%d:%s (%s) __REPRO: %s\n", bs.tests, state,
                     skip_reason2str(res.reason), pstr);
             bs.skipped++;
@@ -33,6 +33,7 @@
 
 #include "src/common/z_magic.hpp"
 
+#include "utils/perf_counters.hpp"
 #include "utils/timer.hpp"
 
 #define ABS(a) ((a) > 0 ? (a) : (-(a)))
@@ -118,6 +119,8 @@ bool is_bench_mode(bench_mode_t user_mode);
 extern double max_ms_per_prb; /** maximum time spends per prb in ms */
 extern int min_times_per_prb; /** minimal amount of runs per prb */
 extern int fix_times_per_prb; /** if non-zero run prb that many times */
+extern int n_instances; /** number of concurrent instances of prb */
+extern int instance_nthr; /** number of threads per instance, 0 - auto */
 
 extern bool fast_ref_gpu;
 extern bool allow_enum_tags_only;
@@ -157,6 +160,7 @@ enum skip_reason_t {
     NOT_ENOUGH_RAM,
     SKIP_IMPL_HIT,
     SKIP_START,
+    SKIP_CAPTURED,
 };
 const char *skip_reason2str(skip_reason_t skip_reason);
 
@@ -167,6 +171,8 @@ struct res_t {
     std::string impl_name;
     skip_reason_t reason;
     size_t ibytes, obytes;
+    perf_counters::values_t counters;
+    double throughput; /** runs per second of all instances */
 };
 
 void parse_result(
@@ -187,6 +193,7 @@ bool maybe_skip(const std::string &impl_str);
 
 typedef int (*bench_f)(int argc, char **argv);
 int batch(const char *fname, bench_f bench);
+std::string locate_batch_file(const std::string &fname);
 
 /* returns 1 with given probability */
 int flip_coin(ptrdiff_t seed, float probability);
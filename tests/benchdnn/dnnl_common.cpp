@@ -15,9 +15,12 @@
 *******************************************************************************/
 
 #include <algorithm> // for std::reverse and std::copy
+#include <atomic> // for std::atomic
 #include <cctype> // for std::isdigit
 #include <functional> // for std::bind and std::placeholders
+#include <memory> // for std::unique_ptr
 #include <string> // for std::string
+#include <thread> // for std::thread
 #include <utility> // for std::pair
 #include <vector> // for std::vector
 
@@ -44,6 +47,15 @@
 
 #include "cpu/platform.hpp"
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
 int check_pd_cache(dnnl_primitive_desc_t pd) {
 #ifndef DNNL_DISABLE_PRIMITIVE_CACHE
     int capacity = 0;
@@ -95,6 +107,15 @@ isa_hints_t hints {isa_hints_t::none};
 
 memory_kind_ext_t memory_kind {default_memory_kind};
 
+std::string cache_import_file;
+std::string cache_export_file;
+
+dnnl_cpu_hugepages_mode_t mem_hugepages {dnnl_cpu_hugepages_none};
+bool collect_perf_counters {false};
+bool report_roofline {false};
+cold_cache_mode_t cold_cache_mode {cold_cache_mode_t::none};
+std::function<void(dnnl_primitive_t)> primitive_capture_hook;
+
 void init_isa_settings() {
     if (hints.get() == isa_hints_t::no_hints)
         DNN_SAFE_V(dnnl_set_cpu_isa_hints(dnnl_cpu_isa_no_hints));
@@ -106,6 +127,32 @@ void init_isa_settings() {
     }
 }
 
+int import_primitive_cache() {
+    if (cache_import_file.empty()) return OK;
+
+    timer::timer_t t;
+    t.start();
+    int n_imported = 0;
+    DNN_SAFE(dnnl_import_primitive_cache(
+                     get_test_engine(), cache_import_file.c_str(), &n_imported),
+            CRIT);
+    t.stamp();
+    BENCHDNN_PRINT(0, "primitive cache: imported %d primitives in %g ms\n",
+            n_imported, t.ms());
+    return OK;
+}
+
+int export_primitive_cache() {
+    if (cache_export_file.empty()) return OK;
+
+    DNN_SAFE(dnnl_export_primitive_cache(cache_export_file.c_str()), CRIT);
+    int n_entries = 0;
+    DNN_SAFE(dnnl_get_primitive_cache_usage(&n_entries, nullptr), CRIT);
+    BENCHDNN_PRINT(0, "primitive cache: exported %d primitives to %s\n",
+            n_entries, cache_export_file.c_str());
+    return OK;
+}
+
 args_t &args_t::set(int arg, const dnn_mem_t &mem) {
     args_.emplace_back(arg, &mem);
     return *this;
@@ -201,10 +248,79 @@ dnnl_engine_kind_t get_engine_kind(const dnnl_engine_t &engine) {
     return engine_kind;
 }
 
+// Evicts the arguments selected by `cold_cache_mode` from the CPU caches
+// before each run. On x86 the buffers are flushed line by line. On other
+// architectures a buffer larger than the last level cache is written instead,
+// which evicts all arguments regardless of the mode.
+struct cold_cache_t {
+    cold_cache_t(const std::vector<dnnl_exec_arg_t> &dnnl_args) {
+        if (cold_cache_mode == cold_cache_mode_t::none) return;
+
+        for (const auto &a : dnnl_args) {
+            if (!is_cold(a.arg)) continue;
+            void *handle = nullptr;
+            const dnnl_memory_desc_t *md = nullptr;
+            if (dnnl_memory_get_data_handle(a.memory, &handle) != dnnl_success
+                    || dnnl_memory_get_memory_desc(a.memory, &md)
+                            != dnnl_success
+                    || !handle)
+                continue;
+            buffers_.emplace_back(
+                    (const char *)handle, dnnl_memory_desc_get_size(md));
+        }
+
+#if !defined(__x86_64__) && !defined(_M_X64)
+        using namespace dnnl::impl::cpu;
+        const size_t llc_size = (size_t)platform::get_per_core_cache_size(3)
+                * dnnl_get_max_threads();
+        if (!buffers_.empty()) thrash_buffer_.resize(2 * llc_size);
+#endif
+    }
+
+    bool is_enabled() const { return !buffers_.empty(); }
+
+    void flush() {
+#if defined(__x86_64__) || defined(_M_X64)
+        const size_t line_size = 64;
+        for (const auto &b : buffers_)
+            for (size_t off = 0; off < b.second; off += line_size)
+                _mm_clflush(b.first + off);
+        _mm_mfence();
+#else
+        for (size_t i = 0; i < thrash_buffer_.size(); i += 64)
+            thrash_buffer_[i]++;
+#endif
+    }
+
+private:
+    static bool is_cold(int arg) {
+        arg &= ~DNNL_ARG_ATTR_POST_OP_DW;
+        const bool is_output
+                = (arg >= DNNL_ARG_DST_0 && arg < DNNL_ARG_WEIGHTS_0)
+                || (arg >= DNNL_ARG_DIFF_SRC_0 && arg < DNNL_ARG_DIFF_DST_0)
+                || (arg >= DNNL_ARG_DIFF_WEIGHTS_0 && arg <= DNNL_ARG_DIFF_BIAS)
+                || arg == DNNL_ARG_SCRATCHPAD;
+        const bool is_wei = arg >= DNNL_ARG_WEIGHTS_0 && arg <= DNNL_ARG_BIAS;
+        if (cold_cache_mode == cold_cache_mode_t::wei) return is_wei;
+        return !is_output;
+    }
+
+    std::vector<std::pair<const char *, size_t>> buffers_;
+    std::vector<char> thrash_buffer_;
+};
+
 inline int measure_perf_individual(timer::timer_t &t, dnnl_stream_t stream,
-        perf_function_t &perf_func, std::vector<dnnl_exec_arg_t> &dnnl_args) {
+        perf_function_t &perf_func, std::vector<dnnl_exec_arg_t> &dnnl_args,
+        perf_counters::collector_t *counters) {
+    cold_cache_t cold_cache(dnnl_args);
     t.reset();
+    if (counters) counters->start();
     while (true) {
+        if (cold_cache.is_enabled()) {
+            // The time spent on flushing is not measured.
+            cold_cache.flush();
+            t.start();
+        }
         DNN_SAFE(perf_func(stream, dnnl_args), WARN);
         t.stamp();
         if (should_stop(t)) break;
@@ -213,7 +329,8 @@ inline int measure_perf_individual(timer::timer_t &t, dnnl_stream_t stream,
 }
 
 inline int measure_perf_aggregate(timer::timer_t &t, dnnl_stream_t stream,
-        perf_function_t &perf_func, std::vector<dnnl_exec_arg_t> &dnnl_args) {
+        perf_function_t &perf_func, std::vector<dnnl_exec_arg_t> &dnnl_args,
+        perf_counters::collector_t *counters) {
     const int max_batch_times = 10000;
 
     // Warm-up run, this is not measured due to possibility the associated
@@ -225,6 +342,7 @@ inline int measure_perf_aggregate(timer::timer_t &t, dnnl_stream_t stream,
             = fix_times_per_prb ? fix_times_per_prb : min_times_per_prb;
 
     t.reset();
+    if (counters) counters->start();
 
     bool is_first_loop = true;
     while (true) {
@@ -260,21 +378,190 @@ int measure_perf(res_t *res, perf_function_t &perf_func, args_t &args) {
         std::vector<dnnl_exec_arg_t> dnnl_args;
         execute_unmap_args(args, dnnl_args);
 
+        std::unique_ptr<perf_counters::collector_t> counters;
+        if (collect_perf_counters && is_cpu()) {
+            // Run the primitive once to let the threading runtime start its
+            // threads before the collector enumerates them.
+            DNN_SAFE(perf_func(stream, dnnl_args), WARN);
+            DNN_SAFE(dnnl_stream_wait(stream), WARN);
+            counters.reset(new perf_counters::collector_t());
+        }
+
         auto &t = res->timer_map.perf_timer();
         // For non-DPCPP CPU: measure individual iterations.
         // For DPCPP CPU and GPU: measure iterations in batches to hide driver
         // overhead. DPCPP CPU follows the model of GPU, thus, handled similar.
         if (is_cpu() && !is_sycl_engine(engine))
-            ret = measure_perf_individual(t, stream, perf_func, dnnl_args);
+            ret = measure_perf_individual(
+                    t, stream, perf_func, dnnl_args, counters.get());
         else
-            ret = measure_perf_aggregate(t, stream, perf_func, dnnl_args);
+            ret = measure_perf_aggregate(
+                    t, stream, perf_func, dnnl_args, counters.get());
+
+        if (counters) counters->stop(res->counters, t.times());
 
         if (ret == OK) execute_map_args(args);
     }
     return ret;
 }
 
+// Binds the calling thread to the `instance`-th group of `nthr` CPUs out of the
+// CPUs available to the process. The threads of the threading runtime started
+// from the calling thread inherit the binding, unless the runtime binds them
+// explicitly, e.g. with OMP_PROC_BIND.
+static void bind_instance_thread(int instance, int nthr) {
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+    if (cpus.empty()) return;
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (int i = 0; i < nthr; i++)
+        CPU_SET(cpus[(instance * nthr + i) % cpus.size()], &mask);
+    pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+#endif
+}
+
+// Runs `n_instances` copies of the problem concurrently, each in its own
+// thread with its own memories and stream, to account for the interference
+// through shared caches and memory bandwidth. With a user scratchpad, the
+// instances execute the same primitive, since each of them passes its own
+// copy of the scratchpad. Otherwise each instance needs its own primitive and
+// the primitive cache is disabled while the copies are created, which evicts
+// all the cached primitives.
+static int measure_perf_instances(
+        res_t *res, dnnl_primitive_t prim, args_t &args) {
+    const auto &engine = get_test_engine();
+    const int n = n_instances;
+    const int nthr = instance_nthr > 0
+            ? instance_nthr
+            : MAX2(1, dnnl_get_max_threads() / n);
+
+    const_dnnl_primitive_desc_t pd {};
+    DNN_SAFE(dnnl_primitive_get_primitive_desc(prim, &pd), WARN);
+    const_dnnl_primitive_attr_t attr {};
+    DNN_SAFE(dnnl_primitive_desc_get_attr(pd, &attr), WARN);
+    dnnl_scratchpad_mode_t scratchpad_mode {};
+    DNN_SAFE(dnnl_primitive_attr_get_scratchpad_mode(attr, &scratchpad_mode),
+            WARN);
+
+    std::vector<dnnl_primitive_t> prims(n, prim);
+    std::vector<benchdnn_dnnl_wrapper_t<dnnl_primitive_t>> own_prims;
+    if (scratchpad_mode != dnnl_scratchpad_mode_user) {
+        int capacity = 0;
+        DNN_SAFE(dnnl_get_primitive_cache_capacity(&capacity), WARN);
+        DNN_SAFE(dnnl_set_primitive_cache_capacity(0), WARN);
+        own_prims.reserve(n);
+        dnnl_status_t create_status = dnnl_success;
+        for (int i = 0; i < n && create_status == dnnl_success; i++) {
+            dnnl_primitive_t p {};
+            create_status = dnnl_primitive_create(&p, pd);
+            own_prims.emplace_back(p);
+            prims[i] = p;
+        }
+        DNN_SAFE(dnnl_set_primitive_cache_capacity(capacity), WARN);
+        DNN_SAFE(create_status, WARN);
+    }
+
+    std::vector<std::vector<dnn_mem_t>> mems(n);
+    std::vector<args_t> instance_args(n);
+    std::vector<std::vector<dnnl_exec_arg_t>> dnnl_args(n);
+    for (int i = 0; i < n; i++) {
+        mems[i].reserve(args.size());
+        for (int j = 0; j < args.size(); j++) {
+            const auto &mem = args.dnn_mem(j);
+            mems[i].emplace_back(mem.md_, engine);
+            if (mem.size() > 0)
+                std::memcpy(static_cast<void *>(mems[i].back()),
+                        static_cast<void *>(mem), mem.size());
+            instance_args[i].set(args.arg(j), mems[i].back());
+        }
+        execute_unmap_args(instance_args[i], dnnl_args[i]);
+    }
+
+    std::vector<timer::timer_t> timers(n, timer::timer_t(true));
+    std::vector<int> status(n, OK);
+    std::atomic<int> n_ready(0);
+    std::atomic<bool> is_started(false);
+    double start_ms = 0;
+
+    auto run_instance = [&](int i) {
+        stream_t stream(engine);
+        auto exec = [&]() {
+            dnnl_status_t s = dnnl_primitive_execute(prims[i], stream,
+                    (int)dnnl_args[i].size(), dnnl_args[i].data());
+            if (s == dnnl_success) s = dnnl_stream_wait(stream);
+            return s;
+        };
+
+        // The warm-up run starts the threads of the instance.
+        if (exec() != dnnl_success) status[i] = FAIL;
+        n_ready++;
+        while (!is_started)
+            std::this_thread::yield();
+        if (status[i] != OK) return;
+
+        auto &t = timers[i];
+        t.reset();
+        while (true) {
+            if (exec() != dnnl_success) {
+                status[i] = FAIL;
+                return;
+            }
+            t.stamp();
+            const bool stop = fix_times_per_prb
+                    ? t.times() >= fix_times_per_prb
+                    : timer::ms_now() - start_ms >= max_ms_per_prb
+                            && t.times() >= min_times_per_prb;
+            if (stop) break;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < n; i++) {
+        threads.emplace_back([&, i]() {
+            bind_instance_thread(i, nthr);
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+            omp_set_num_threads(nthr);
+            run_instance(i);
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
+            tbb::task_arena arena(nthr);
+            arena.execute([&]() { run_instance(i); });
+#else
+            run_instance(i);
+#endif
+        });
+    }
+    while (n_ready < n)
+        std::this_thread::yield();
+    start_ms = timer::ms_now();
+    is_started = true;
+    for (auto &thread : threads)
+        thread.join();
+    const double total_ms = timer::ms_now() - start_ms;
+
+    for (int i = 0; i < n; i++)
+        SAFE(status[i], WARN);
+
+    auto &t = res->timer_map.perf_timer();
+    t.reset();
+    for (const auto &instance_timer : timers)
+        t.merge(instance_timer);
+    res->throughput = total_ms > 0 ? t.times() / (total_ms / 1e3) : 0;
+    return OK;
+}
+
 int measure_perf(res_t *res, dnnl_primitive_t prim, args_t &args) {
+    if (is_bench_mode(PERF) && n_instances > 1 && is_cpu()
+            && !is_sycl_engine(get_test_engine()))
+        return measure_perf_instances(res, prim, args);
+
     perf_function_t perf_func = std::bind(&primitive_executor, prim,
             std::placeholders::_1, std::placeholders::_2);
 
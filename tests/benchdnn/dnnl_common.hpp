@@ -220,7 +220,32 @@ const memory_kind_ext_t default_memory_kind = memory_kind_ext_t::usm;
 
 extern memory_kind_ext_t memory_kind;
 
+// Files to import the primitive cache from before testing and to export it
+// to after testing. Empty values mean no import or export.
+extern std::string cache_import_file;
+extern std::string cache_export_file;
+
+// Huge pages mode for CPU memory. With a mode other than none, CPU memory is
+// allocated by the library instead of the driver.
+extern dnnl_cpu_hugepages_mode_t mem_hugepages;
+extern bool collect_perf_counters;
+extern bool report_roofline;
+
+enum class cold_cache_mode_t {
+    none, // caches are warm
+    wei, // weights and bias are evicted before each run
+    all, // all inputs are evicted before each run
+};
+extern cold_cache_mode_t cold_cache_mode;
+
+// When set, init_prim() passes the ownership of a created primitive to the
+// hook instead of the driver, and the problem is skipped with SKIP_CAPTURED.
+// The graph driver uses it to create layers with the regular drivers.
+extern std::function<void(dnnl_primitive_t)> primitive_capture_hook;
+
 void init_isa_settings();
+int import_primitive_cache();
+int export_primitive_cache();
 
 inline const char *query_impl_info(const_dnnl_primitive_desc_t pd) {
     const char *str;
@@ -432,6 +457,12 @@ int init_prim(benchdnn_dnnl_wrapper_t<dnnl_primitive_t> &user_prim,
     // Collect memory footprint for a given primitive descriptor.
     SAFE(get_memory_footprint(pd, res), WARN);
 
+    if (primitive_capture_hook) {
+        primitive_capture_hook(prim.release());
+        res->state = SKIPPED, res->reason = SKIP_CAPTURED;
+        return OK;
+    }
+
     user_prim.reset(prim.release());
 
     return OK;
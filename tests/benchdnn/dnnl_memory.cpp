@@ -226,7 +226,10 @@ int dnn_mem_t::initialize_memory_create(const handle_info_t &handle_info) {
         SAFE(is_cpu(engine_) ? OK : FAIL, CRIT);
     }
 
-    if (is_cpu(engine_) && handle_info.is_allocate() && !is_sycl) {
+    // With huge pages requested, the library allocates CPU memory to make the
+    // buffers of the tested primitives follow the library policy.
+    if (is_cpu(engine_) && handle_info.is_allocate() && !is_sycl
+            && mem_hugepages == dnnl_cpu_hugepages_none) {
         // Allocate memory for native runtime directly.
         is_data_owner_ = true;
         const size_t alignment = 2 * 1024 * 1024;
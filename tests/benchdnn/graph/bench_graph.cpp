@@ -0,0 +1,57 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dnnl_common.hpp"
+#include "utils/parser.hpp"
+
+#include "graph/graph.hpp"
+
+namespace graph {
+
+void check_correctness(const std::string &fname) {
+    const char *pstr = fname.c_str();
+    BENCHDNN_PRINT(1, "run: %s\n", pstr);
+
+    res_t res {};
+    const int status = doit(fname, &res);
+
+    bool want_perf_report = false;
+    parse_result(res, want_perf_report, status, pstr);
+
+    benchdnn_stat.tests++;
+}
+
+int bench(int argc, char **argv) {
+    driver_name = "graph";
+    using namespace parser;
+    static settings_t s;
+    for (; argc > 0; --argc, ++argv) {
+        const bool parsed_options = parse_bench_settings(argv[0])
+                || parse_batch(bench, argv[0]) || parse_reset(s, argv[0]);
+        if (!parsed_options) {
+            catch_unknown_options(argv[0]);
+
+            check_correctness(argv[0]);
+        }
+    }
+
+    return parse_last_argument();
+}
+
+} // namespace graph
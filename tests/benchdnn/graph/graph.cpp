@@ -0,0 +1,503 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "tests/test_thread.hpp"
+
+#include "dnnl_common.hpp"
+#include "dnnl_memory.hpp"
+
+#include "binary/binary.hpp"
+#include "bnorm/bnorm.hpp"
+#include "concat/concat.hpp"
+#include "conv/conv.hpp"
+#include "conv/deconv.hpp"
+#include "eltwise/eltwise.hpp"
+#include "ip/ip.hpp"
+#include "lnorm/lnorm.hpp"
+#include "lrn/lrn.hpp"
+#include "matmul/matmul.hpp"
+#include "pool/pool.hpp"
+#include "prelu/prelu.hpp"
+#include "reduction/reduction.hpp"
+#include "reorder/reorder.hpp"
+#include "resampling/resampling.hpp"
+#include "rnn/rnn.hpp"
+#include "shuffle/shuffle.hpp"
+#include "softmax/softmax.hpp"
+#include "sum/sum.hpp"
+
+#include "graph/graph.hpp"
+
+namespace graph {
+
+namespace {
+
+const struct {
+    const char *name;
+    bench_f bench;
+} drivers[] = {
+        {"binary", binary::bench},
+        {"bnorm", bnorm::bench},
+        {"concat", concat::bench},
+        {"conv", conv::bench},
+        {"deconv", deconv::bench},
+        {"eltwise", eltwise::bench},
+        {"ip", ip::bench},
+        {"lnorm", lnorm::bench},
+        {"lrn", lrn::bench},
+        {"matmul", matmul::bench},
+        {"pool", pool::bench},
+        {"prelu", prelu::bench},
+        {"reduction", reduction::bench},
+        {"reorder", reorder::bench},
+        {"resampling", resampling::bench},
+        {"rnn", rnn::bench},
+        {"shuffle", shuffle::bench},
+        {"softmax", softmax::bench},
+        {"sum", sum::bench},
+};
+
+const struct {
+    const char *name;
+    int arg;
+} arg_names[] = {
+        {"src", DNNL_ARG_SRC},
+        {"src1", DNNL_ARG_SRC_1},
+        {"src2", DNNL_ARG_SRC_2},
+        {"src_iter", DNNL_ARG_SRC_ITER},
+        {"src_iter_c", DNNL_ARG_SRC_ITER_C},
+        {"wei", DNNL_ARG_WEIGHTS},
+        {"wei_iter", DNNL_ARG_WEIGHTS_ITER},
+        {"wei_peephole", DNNL_ARG_WEIGHTS_PEEPHOLE},
+        {"wei_proj", DNNL_ARG_WEIGHTS_PROJECTION},
+        {"bia", DNNL_ARG_BIAS},
+        {"dst", DNNL_ARG_DST},
+        {"dst_iter", DNNL_ARG_DST_ITER},
+        {"dst_iter_c", DNNL_ARG_DST_ITER_C},
+        {"mean", DNNL_ARG_MEAN},
+        {"var", DNNL_ARG_VARIANCE},
+        {"sc", DNNL_ARG_SCALE},
+        {"sh", DNNL_ARG_SHIFT},
+        {"ws", DNNL_ARG_WORKSPACE},
+};
+
+// Inputs of concat and sum, and binary post-op sources are numbered.
+const int max_multiple_src = 64;
+const int max_post_ops = 32;
+
+int post_op_arg(int idx) {
+    return DNNL_ARG_ATTR_MULTIPLE_POST_OP(idx) | DNNL_ARG_SRC_1;
+}
+
+int str2arg(const std::string &str) {
+    for (const auto &e : arg_names)
+        if (str == e.name) return e.arg;
+
+    const auto str2idx = [&](const std::string &prefix, int max_idx) {
+        const size_t len = prefix.size();
+        if (str.size() == len || str.compare(0, len, prefix) != 0) return -1;
+        for (size_t i = len; i < str.size(); ++i)
+            if (!isdigit(str[i])) return -1;
+        const int idx = atoi(str.c_str() + len);
+        return idx < max_idx ? idx : -1;
+    };
+
+    int idx = str2idx("msrc", max_multiple_src);
+    if (idx >= 0) return DNNL_ARG_MULTIPLE_SRC + idx;
+    idx = str2idx("po", max_post_ops);
+    if (idx >= 0) return post_op_arg(idx);
+    return -1;
+}
+
+std::string arg2str(int arg) {
+    for (const auto &e : arg_names)
+        if (arg == e.arg) return e.name;
+    if (arg == DNNL_ARG_SCRATCHPAD) return "scratchpad";
+    if (arg >= DNNL_ARG_MULTIPLE_SRC
+            && arg < DNNL_ARG_MULTIPLE_SRC + max_multiple_src)
+        return "msrc" + std::to_string(arg - DNNL_ARG_MULTIPLE_SRC);
+    for (int idx = 0; idx < max_post_ops; ++idx)
+        if (arg == post_op_arg(idx)) return "po" + std::to_string(idx);
+    return std::to_string(arg);
+}
+
+bool is_output(int arg) {
+    return (arg >= DNNL_ARG_DST_0 && arg <= DNNL_ARG_DST_2)
+            || arg == DNNL_ARG_WORKSPACE;
+}
+
+// Returns the arguments a primitive expects at execution.
+std::vector<int> query_args(const_dnnl_primitive_desc_t pd) {
+    std::vector<int> candidates;
+    for (const auto &e : arg_names)
+        candidates.push_back(e.arg);
+    candidates.push_back(DNNL_ARG_SCRATCHPAD);
+    for (int i = 0; i < max_multiple_src; ++i)
+        candidates.push_back(DNNL_ARG_MULTIPLE_SRC + i);
+
+    // Only binary post-ops have a memory argument.
+    const_dnnl_primitive_attr_t attr {};
+    const_dnnl_post_ops_t po {};
+    if (dnnl_primitive_desc_get_attr(pd, &attr) == dnnl_success
+            && dnnl_primitive_attr_get_post_ops(attr, &po) == dnnl_success) {
+        for (int idx = 0; idx < dnnl_post_ops_len(po); ++idx)
+            if (dnnl_post_ops_get_kind(po, idx) == dnnl_binary)
+                candidates.push_back(post_op_arg(idx));
+    }
+
+    std::vector<int> args;
+    for (int arg : candidates) {
+        const auto *md
+                = dnnl_primitive_desc_query_md(pd, dnnl_query_exec_arg_md, arg);
+        if (md && md->ndims > 0) args.push_back(arg);
+    }
+    return args;
+}
+
+// Fills a memory with a small deterministic pattern. Values are not checked,
+// they only have to be valid inputs for every data type.
+int fill_mem(dnn_mem_t &mem, int seed) {
+    dnn_mem_t mem_f32(mem.md_, dnnl_f32, tag::abx, get_test_engine());
+    const int64_t nelems = mem_f32.nelems();
+    dnnl::impl::parallel_nd(nelems, [&](int64_t i) {
+        const int64_t value = (i * 37 + seed * 11) % 17 - 8;
+        mem_f32.set_elem(i, value * 0.125f);
+    });
+    SAFE(mem.reorder(mem_f32), WARN);
+    return OK;
+}
+
+// Creates a primitive of a layer with the regular driver, which hands the
+// primitive over through the capture hook instead of testing it.
+int init_layer_prim(const layer_desc_t &desc,
+        benchdnn_dnnl_wrapper_t<dnnl_primitive_t> &prim) {
+    bench_f bench = nullptr;
+    for (const auto &d : drivers)
+        if (desc.driver == d.name) bench = d.bench;
+    if (!bench) {
+        fprintf(stderr, "ERROR: graph: layer '%s': unknown driver '%s'\n",
+                desc.name.c_str(), desc.driver.c_str());
+        return FAIL;
+    }
+
+    std::vector<std::string> opts {"--reset"};
+    opts.insert(opts.end(), desc.options.begin(), desc.options.end());
+    std::vector<char *> c_opts;
+    for (const auto &opt : opts)
+        c_opts.push_back(const_cast<char *>(opt.c_str()));
+
+    std::vector<dnnl_primitive_t> captured;
+    primitive_capture_hook
+            = [&](dnnl_primitive_t p) { captured.push_back(p); };
+    // A layer is not a test case, its statistics are not reported.
+    const stat_t stat = benchdnn_stat;
+    bench(static_cast<int>(c_opts.size()), c_opts.data());
+    benchdnn_stat = stat;
+    primitive_capture_hook = nullptr;
+    driver_name = "graph";
+
+    if (captured.size() != 1) {
+        fprintf(stderr,
+                "ERROR: graph: layer '%s' created %d primitives, expected "
+                "exactly one\n",
+                desc.name.c_str(), (int)captured.size());
+        for (auto p : captured)
+            dnnl_primitive_destroy(p);
+        return FAIL;
+    }
+    prim.reset(captured[0]);
+    return OK;
+}
+
+int init_reorder_prim(const dnnl_memory_desc_t &src_md,
+        const dnnl_memory_desc_t &dst_md,
+        benchdnn_dnnl_wrapper_t<dnnl_primitive_t> &prim) {
+    const auto &engine = get_test_engine();
+    dnnl_primitive_desc_t rpd {};
+    DNN_SAFE(dnnl_reorder_primitive_desc_create(
+                     &rpd, &src_md, engine, &dst_md, engine, nullptr),
+            WARN);
+    auto rpd_w = make_benchdnn_dnnl_wrapper(rpd);
+
+    dnnl_primitive_t r {};
+    DNN_SAFE(dnnl_primitive_create(&r, rpd_w), WARN);
+    prim.reset(r);
+    return OK;
+}
+
+// Appends a layer to a topology. The tensor bound to an argument for the
+// first time takes the memory descriptor the layer expects for it. When a
+// later layer expects a different one, a reorder is inserted before the layer
+// for an input or after the layer for an output. An input already reordered
+// to the same layout for a previous layer is not reordered again.
+int add_layer(topology_t &topo, const layer_desc_t &desc) {
+    benchdnn_dnnl_wrapper_t<dnnl_primitive_t> prim;
+    SAFE(init_layer_prim(desc, prim), WARN);
+
+    const_dnnl_primitive_desc_t pd {};
+    DNN_SAFE(dnnl_primitive_get_primitive_desc(prim, &pd), WARN);
+    const auto &engine = get_test_engine();
+
+    for (const auto &b : desc.bindings) {
+        const auto *md = dnnl_primitive_desc_query_md(
+                pd, dnnl_query_exec_arg_md, b.first);
+        if (!md || md->ndims == 0) {
+            fprintf(stderr,
+                    "ERROR: graph: layer '%s' has no argument '%s'\n",
+                    desc.name.c_str(), arg2str(b.first).c_str());
+            return FAIL;
+        }
+    }
+
+    step_t layer("layer", desc.name, prim.release());
+    std::vector<step_t> pre, post;
+    std::vector<std::string> written;
+    for (int arg : query_args(pd)) {
+        const auto &md = *dnnl_primitive_desc_query_md(
+                pd, dnnl_query_exec_arg_md, arg);
+        const bool output = is_output(arg);
+
+        const auto b = desc.bindings.find(arg);
+        if (b == desc.bindings.end()) {
+            topo.private_mems.emplace_back(md, engine);
+            auto &mem = topo.private_mems.back();
+            if (!output && arg != DNNL_ARG_SCRATCHPAD)
+                SAFE(fill_mem(mem, arg), WARN);
+            layer.args.emplace_back(arg, &mem);
+            continue;
+        }
+
+        const std::string &name = b->second;
+        auto t = topo.tensors.find(name);
+        if (t == topo.tensors.end()) {
+            t = topo.tensors.emplace(name, dnn_mem_t(md, engine)).first;
+            // A tensor first used as an input is an input of the topology.
+            if (!output) SAFE(fill_mem(t->second, arg), WARN);
+        }
+        dnn_mem_t &tensor = t->second;
+        if (output) written.push_back(name);
+        if (dnnl_memory_desc_equal(&tensor.md_, &md)) {
+            layer.args.emplace_back(arg, &tensor);
+            continue;
+        }
+
+        if (!output) {
+            const dnn_mem_t *copy = nullptr;
+            const auto range = topo.converted.equal_range(name);
+            for (auto it = range.first; it != range.second; ++it)
+                if (dnnl_memory_desc_equal(&it->second->md_, &md))
+                    copy = it->second;
+            if (copy) {
+                layer.args.emplace_back(arg, copy);
+                continue;
+            }
+        }
+
+        topo.private_mems.emplace_back(md, engine);
+        auto &mem = topo.private_mems.back();
+        const dnn_mem_t &from = output ? mem : tensor;
+        const dnn_mem_t &to = output ? tensor : mem;
+
+        benchdnn_dnnl_wrapper_t<dnnl_primitive_t> r;
+        if (init_reorder_prim(from.md_, to.md_, r) != OK) {
+            fprintf(stderr,
+                    "ERROR: graph: layer '%s': argument '%s' does not match "
+                    "tensor '%s'\n",
+                    desc.name.c_str(), arg2str(arg).c_str(), name.c_str());
+            return FAIL;
+        }
+        auto &steps = output ? post : pre;
+        steps.emplace_back("reorder", desc.name + ":" + arg2str(arg),
+                r.release());
+        steps.back().args.emplace_back(DNNL_ARG_FROM, &from);
+        steps.back().args.emplace_back(DNNL_ARG_TO, &to);
+        layer.args.emplace_back(arg, &mem);
+        if (!output) topo.converted.emplace(name, &mem);
+    }
+
+    // The copies of the tensors written by the layer become stale.
+    for (const auto &name : written)
+        topo.converted.erase(name);
+
+    for (auto &s : pre)
+        topo.steps.push_back(std::move(s));
+    topo.steps.push_back(std::move(layer));
+    for (auto &s : post)
+        topo.steps.push_back(std::move(s));
+    return OK;
+}
+
+bool should_stop(const timer::timer_t &t) {
+    if (!is_bench_mode(PERF)) return true;
+    if (fix_times_per_prb) return t.times() >= fix_times_per_prb;
+    return t.total_ms() >= max_ms_per_prb && t.times() >= min_times_per_prb;
+}
+
+// Runs the whole topology once to warm it up, and then, in performance mode,
+// repeatedly with each step timed separately.
+int execute(topology_t &topo) {
+    std::vector<std::vector<dnnl_exec_arg_t>> dnnl_args(topo.steps.size());
+    for (size_t i = 0; i < topo.steps.size(); ++i) {
+        for (const auto &a : topo.steps[i].args) {
+            if (a.second->is_mapped()) a.second->unmap();
+            dnnl_args[i].push_back({a.first, a.second->m_});
+        }
+    }
+
+    stream_t stream(get_test_engine());
+    const auto run = [&](bool timed) {
+        for (size_t i = 0; i < topo.steps.size(); ++i) {
+            auto &s = topo.steps[i];
+            const auto &args = dnnl_args[i];
+            if (timed) s.timer.start();
+            DNN_SAFE(dnnl_primitive_execute(
+                             s.prim, stream, (int)args.size(), args.data()),
+                    WARN);
+            DNN_SAFE(dnnl_stream_wait(stream), WARN);
+            if (timed) s.timer.stamp();
+        }
+        return OK;
+    };
+
+    SAFE(run(false), WARN);
+    auto &t = topo.timer;
+    t.reset();
+    while (is_bench_mode(PERF)) {
+        t.start();
+        SAFE(run(true), WARN);
+        t.stamp();
+        if (should_stop(t)) break;
+    }
+
+    for (const auto &s : topo.steps)
+        for (const auto &a : s.args)
+            if (!a.second->is_mapped()) a.second->map();
+    return OK;
+}
+
+void report(const topology_t &topo, const std::string &fname) {
+    using mode_t = timer::timer_t::mode_t;
+    const double total_avg = topo.timer.ms(mode_t::avg);
+    const auto share = [&](double ms) {
+        return total_avg > 0 ? 100. * ms / total_avg : 0.;
+    };
+
+    int n_reorders = 0;
+    double reorders_min = 0, reorders_avg = 0;
+    for (const auto &s : topo.steps) {
+        const_dnnl_primitive_desc_t pd {};
+        dnnl_primitive_get_primitive_desc(s.prim, &pd);
+        const double avg = s.timer.ms(mode_t::avg);
+        BENCHDNN_PRINT(0, "graph,%s,%s,%s,%s,%g,%g,%.1f%%\n", fname.c_str(),
+                s.kind.c_str(), s.name.c_str(), query_impl_info(pd),
+                s.timer.ms(mode_t::min), avg, share(avg));
+        if (s.kind == "reorder") {
+            n_reorders++;
+            reorders_min += s.timer.ms(mode_t::min);
+            reorders_avg += avg;
+        }
+    }
+    BENCHDNN_PRINT(0, "graph,%s,reorders,%d,,%g,%g,%.1f%%\n", fname.c_str(),
+            n_reorders, reorders_min, reorders_avg, share(reorders_avg));
+    BENCHDNN_PRINT(0, "graph,%s,total,%d,,%g,%g,100.0%%\n", fname.c_str(),
+            (int)topo.steps.size(), topo.timer.ms(mode_t::min), total_avg);
+}
+
+} // namespace
+
+int parse_topology(const std::string &fname, std::vector<layer_desc_t> &descs) {
+    std::ifstream ifs(locate_batch_file(fname));
+    SAFE(ifs.is_open() ? OK : FAIL, WARN);
+
+    std::string line, full_line;
+    while (std::getline(ifs, line)) {
+        line = line.substr(0, line.find('#'));
+        // shell style line break
+        const auto last = line.find_last_not_of(" \t\r");
+        if (last != std::string::npos && line[last] == '\\') {
+            full_line += line.substr(0, last) + " ";
+            continue;
+        }
+        full_line += line;
+
+        std::istringstream iss(full_line);
+        full_line.clear();
+        layer_desc_t desc;
+        std::string token;
+        if (!(iss >> desc.name)) continue; // empty line
+
+        const std::string driver_prefix = "--";
+        if (!(iss >> token) || token.compare(0, 2, driver_prefix) != 0) {
+            fprintf(stderr, "ERROR: graph: layer '%s' has no driver\n",
+                    desc.name.c_str());
+            return FAIL;
+        }
+        desc.driver = token.substr(2);
+
+        while (iss >> token) {
+            if (token[0] != '@') {
+                desc.options.push_back(token);
+                continue;
+            }
+            const auto eq = token.find('=');
+            const int arg = eq == std::string::npos
+                    ? -1
+                    : str2arg(token.substr(1, eq - 1));
+            if (arg < 0 || eq + 1 == token.size()) {
+                fprintf(stderr,
+                        "ERROR: graph: layer '%s': bad binding '%s'\n",
+                        desc.name.c_str(), token.c_str());
+                return FAIL;
+            }
+            desc.bindings[arg] = token.substr(eq + 1);
+        }
+        descs.push_back(std::move(desc));
+    }
+    return OK;
+}
+
+int doit(const std::string &fname, res_t *res) {
+    std::vector<layer_desc_t> descs;
+    SAFE(parse_topology(fname, descs), WARN);
+    if (descs.empty()) {
+        fprintf(stderr, "ERROR: graph: no layers in '%s'\n", fname.c_str());
+        return FAIL;
+    }
+    if (bench_mode == LIST) return res->state = LISTED, OK;
+
+    topology_t topo;
+    for (const auto &desc : descs)
+        SAFE(add_layer(topo, desc), WARN);
+
+    SAFE(execute(topo), WARN);
+    // Results are not validated: a topology passes once all its layers are
+    // created and executed.
+    if (is_bench_mode(CORR)) res->state = PASSED;
+    if (is_bench_mode(PERF)) report(topo, fname);
+    return OK;
+}
+
+} // namespace graph
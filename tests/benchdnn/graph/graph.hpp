@@ -0,0 +1,84 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_HPP
+#define GRAPH_HPP
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "common.hpp"
+#include "dnnl_common.hpp"
+#include "dnnl_memory.hpp"
+#include "utils/timer.hpp"
+
+namespace graph {
+
+struct settings_t {
+    settings_t() = default;
+
+    void reset() { *this = settings_t(); }
+};
+
+// A single line of a topology file: the driver and its options that describe
+// exactly one primitive and the bindings of the primitive arguments to
+// tensors shared between layers.
+struct layer_desc_t {
+    std::string name;
+    std::string driver;
+    std::vector<std::string> options;
+    std::map<int, std::string> bindings; // exec arg -> tensor name
+};
+
+int parse_topology(const std::string &fname, std::vector<layer_desc_t> &descs);
+
+// A primitive executed as a part of a topology: either a layer or a reorder
+// inserted to convert a tensor between layouts expected by the layers.
+struct step_t {
+    step_t(const std::string &kind, const std::string &name,
+            dnnl_primitive_t prim)
+        : kind(kind), name(name), prim(prim) {}
+
+    std::string kind;
+    std::string name;
+    benchdnn_dnnl_wrapper_t<dnnl_primitive_t> prim;
+    std::vector<std::pair<int, const dnn_mem_t *>> args;
+    timer::timer_t timer;
+};
+
+struct topology_t {
+    // Named tensors live in a map and private memories in a list, so the
+    // pointers kept by steps stay valid while the topology grows.
+    std::map<std::string, dnn_mem_t> tensors;
+    std::list<dnn_mem_t> private_mems;
+    // Copies of tensors reordered to the layouts expected by the layers,
+    // keyed by the tensor name. A copy is reused by the subsequent layers
+    // expecting the same layout until the tensor is written again.
+    std::multimap<std::string, const dnn_mem_t *> converted;
+    std::vector<step_t> steps;
+    timer::timer_t timer;
+};
+
+int doit(const std::string &fname, res_t *res);
+int bench(int argc, char **argv);
+
+} // namespace graph
+
+#endif
@@ -144,6 +144,7 @@ struct perf_report_t : public base_perf_report_t {
     }
 
     double ops() const override { return p_->ops; }
+    dnnl_data_type_t ops_dt() const override { return p_->cfg[WEI].dt; }
     const attr_t *attr() const override { return &p_->attr; }
     const int64_t *user_mb() const override { return &p_->user_mb; }
     const char *name() const override { return p_->name; }
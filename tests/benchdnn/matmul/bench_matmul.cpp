@@ -43,6 +43,8 @@ void check_correctness(const settings_t &s, const settings_t &def) {
     for_(const auto &i_wtag : s.wtag)
     for_(const auto &i_dtag : s.dtag)
     for_(const auto &i_strides : s.strides)
+    for_(const auto &i_groups : s.groups)
+    for_(const auto &i_src_dyn_quant_dt : s.src_dyn_quant_dt)
     for_(const auto &i_rt_dims_masks : s.rt_dims_masks)
     for_(const auto &i_oscale : s.oscale)
     for_(const auto &i_zero_points : s.zero_points)
@@ -79,7 +81,8 @@ void check_correctness(const settings_t &s, const settings_t &def) {
         }
 
         const prb_t prb(s.prb_vdims, i_cfg, i_stag, i_wtag, i_dtag, i_strides,
-                i_bia_cfg.first, i_bia_cfg.second, i_rt_dims_masks, attr);
+                i_bia_cfg.first, i_bia_cfg.second, i_groups,
+                i_src_dyn_quant_dt, i_rt_dims_masks, attr);
         std::stringstream ss;
         ss << prb;
         const std::string cpp_pstr = ss.str();
@@ -117,6 +120,10 @@ int bench(int argc, char **argv) {
                 || parse_dt(s.bia_dt, def.bia_dt, argv[0], "bia_dt")
                 || parse_vector_option(
                         s.bia_mask, def.bia_mask, atoi, argv[0], "bia_mask")
+                || parse_vector_option(
+                        s.groups, def.groups, atoi, argv[0], "groups")
+                || parse_dt(s.src_dyn_quant_dt, def.src_dyn_quant_dt, argv[0],
+                        "src_dyn_quant")
                 || parse_multivector_option(s.rt_dims_masks, def.rt_dims_masks,
                         atoi, argv[0], "runtime_dims_masks")
                 || parse_attr(s.attr, argv[0])
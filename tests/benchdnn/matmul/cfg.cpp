@@ -95,6 +95,39 @@ const _dt_conf_t conf_bf16f32bf16 = {
         {dnnl_f32},
 };
 
+// s8 weights decompressed to the src data type
+const _dt_conf_t conf_f32s8f32 = {
+        {dnnl_f32, -int_max_exact, int_max_exact, -64, 64, 0, .35, 1. / 128,
+                1e-6},
+        {dnnl_s8, INT8_MIN, INT8_MAX, -5, 5, 0, .35, 1, 0.},
+        {dnnl_f32, -int_max_exact, int_max_exact, -10, 10, 0, 1.0, 1. / 64,
+                1e-6},
+        {dnnl_f32, -int_max_exact, int_max_exact, -10, 10, 0, .35, 1. / 64,
+                1e-6},
+        {dnnl_f32},
+};
+
+const _dt_conf_t conf_bf16s8f32 = {
+        {dnnl_bf16, -int_max_exact, int_max_exact, -64, 64, 0, .35, 1. / 128,
+                0},
+        {dnnl_s8, INT8_MIN, INT8_MAX, -5, 5, 0, .35, 1, 0.},
+        {dnnl_f32, -int_max_exact, int_max_exact, -10, 10, 0, 1.0, 1. / 64, 0},
+        {dnnl_f32, -int_max_exact, int_max_exact, -10, 10, 0, .35, 1. / 64,
+                1e-6},
+        {dnnl_f32},
+};
+
+const _dt_conf_t conf_bf16s8bf16 = {
+        {dnnl_bf16, -int_max_exact, int_max_exact, -64, 64, 0, .35, 1. / 128,
+                1e-2},
+        {dnnl_s8, INT8_MIN, INT8_MAX, -5, 5, 0, .35, 1, 0.},
+        {dnnl_bf16, -int_max_exact, int_max_exact, -10, 10, 0, 1.0, 1. / 64,
+                1e-2},
+        {dnnl_bf16, -int_max_exact, int_max_exact, -10, 10, 0, .35, 1. / 64,
+                1e-2},
+        {dnnl_f32},
+};
+
 const int int_max_exact_half = 1 << 11;
 const _dt_conf_t conf_f16 = {
         {dnnl_f16, -int_max_exact_half, int_max_exact_half, -4, 4, 0, .35, 1,
@@ -231,6 +264,9 @@ const dt_conf_t *str2cfg(const char *str) {
     CASE(bf16bf16bf16);
     CASE(f32bf16bf16);
     CASE(bf16f32bf16);
+    CASE(f32s8f32);
+    CASE(bf16s8f32);
+    CASE(bf16s8bf16);
 #undef CASE
     SAFE_V(CRIT);
     return (const dt_conf_t *)1;
@@ -257,6 +293,9 @@ std::ostream &operator<<(std::ostream &s, const dt_conf_t *cfg) {
     CASE(bf16bf16bf16);
     CASE(f32bf16bf16);
     CASE(bf16f32bf16);
+    CASE(f32s8f32);
+    CASE(bf16s8f32);
+    CASE(bf16s8bf16);
 #undef CASE
     SAFE_V(CRIT);
     return s;
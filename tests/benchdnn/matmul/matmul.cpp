@@ -34,6 +34,13 @@
 namespace matmul {
 
 void prep_bia_dims(const prb_t *prb, dims_t &bia_dims) {
+    if (prb->is_grouped()) {
+        // Grouped bias is {G, 1, N}: the M bit of the mask selects a bias per
+        // group.
+        bia_dims = {(prb->bia_mask & 1) ? prb->groups : 1, 1,
+                (prb->bia_mask & 2) ? prb->n : 1};
+        return;
+    }
     bia_dims.resize(prb->ndims);
     for (int d = 0; d < prb->ndims; ++d)
         bia_dims[d] = (prb->bia_mask & (1 << d)) ? prb->dst_dims[d] : 1;
@@ -65,9 +72,16 @@ static int init_pd(dnnl_engine_t engine, const prb_t *prb,
                  prb->stag, prb->strides[STRIDES_SRC]),
             CRIT);
 
-    SAFE(init_md(&wei_d, prb->ndims, weights_rt_dims.data(), prb->cfg[WEI].dt,
-                 prb->wtag, prb->strides[STRIDES_WEI]),
-            CRIT);
+    if (prb->is_grouped()) {
+        const dims_t wei_dims = {prb->groups, prb->k, prb->n};
+        SAFE(init_md(&wei_d, 3, wei_dims.data(), prb->cfg[WEI].dt,
+                     prb->wtag == tag::any ? tag::any : tag::abx),
+                CRIT);
+    } else {
+        SAFE(init_md(&wei_d, prb->ndims, weights_rt_dims.data(),
+                     prb->cfg[WEI].dt, prb->wtag, prb->strides[STRIDES_WEI]),
+                CRIT);
+    }
 
     SAFE(init_md(&dst_d, prb->ndims, dst_rt_dims.data(), prb->cfg[DST].dt,
                  prb->dtag, prb->strides[STRIDES_DST]),
@@ -76,17 +90,34 @@ static int init_pd(dnnl_engine_t engine, const prb_t *prb,
     if (prb->bia_dt != dnnl_data_type_undef) {
         dims_t bia_dims;
         prep_bia_dims(prb, bia_dims);
-        bia_dims = get_runtime_dims(bia_dims, prb->dst_runtime_dim_mask());
-        DNN_SAFE(dnnl_memory_desc_init_by_strides(&bia_d, prb->ndims,
-                         bia_dims.data(), prb->bia_dt, nullptr),
+        // Grouped bias dims are {G, 1, N} and never depend on run-time M.
+        if (!prb->is_grouped())
+            bia_dims = get_runtime_dims(bia_dims, prb->dst_runtime_dim_mask());
+        DNN_SAFE(dnnl_memory_desc_init_by_strides(&bia_d,
+                         (int)bia_dims.size(), bia_dims.data(), prb->bia_dt,
+                         nullptr),
                 WARN);
     }
 
     dnnl_matmul_desc_t op_d;
-    DNN_SAFE(
-            dnnl_matmul_desc_init(&op_d, &src_d, &wei_d, &bia_d, &dst_d), WARN);
-    DNN_SAFE(op_d.accum_data_type == prb->cfg[ACC].dt ? dnnl_success
-                                                      : dnnl_unimplemented,
+    dnnl_matmul_grouped_desc_t grouped_op_d;
+    dnnl_data_type_t accum_dt;
+    if (prb->is_grouped()) {
+        dnnl_memory_desc_t grp_d;
+        const dnnl_dims_t grp_dims = {prb->groups + 1};
+        DNN_SAFE(dnnl_memory_desc_init_by_tag(
+                         &grp_d, 1, grp_dims, dnnl_s32, dnnl_a),
+                WARN);
+        DNN_SAFE(dnnl_matmul_grouped_desc_init(&grouped_op_d, &src_d, &wei_d,
+                         &bia_d, &dst_d, &grp_d),
+                WARN);
+        accum_dt = grouped_op_d.accum_data_type;
+    } else {
+        DNN_SAFE(dnnl_matmul_desc_init(&op_d, &src_d, &wei_d, &bia_d, &dst_d),
+                WARN);
+        accum_dt = op_d.accum_data_type;
+    }
+    DNN_SAFE(accum_dt == prb->cfg[ACC].dt ? dnnl_success : dnnl_unimplemented,
             CRIT);
 
     // Overload PER_OC mask definition for batched case
@@ -99,9 +130,16 @@ static int init_pd(dnnl_engine_t engine, const prb_t *prb,
     attr_args.prepare_post_ops_mds(prb->attr, prb->ndims, prb->dst_dims.data());
     auto dnnl_attr = make_benchdnn_dnnl_wrapper(
             create_dnnl_attr(prb->attr, attr_args));
+    if (prb->with_src_dyn_quant())
+        DNN_SAFE(dnnl_primitive_attr_set_src_dynamic_quantization(
+                         dnnl_attr, prb->src_dyn_quant_dt),
+                WARN);
 
-    dnnl_status_t init_status = dnnl_primitive_desc_create(
-            &mpd, &op_d, dnnl_attr, engine, nullptr);
+    dnnl_status_t init_status = prb->is_grouped()
+            ? dnnl_primitive_desc_create(
+                    &mpd, &grouped_op_d, dnnl_attr, engine, nullptr)
+            : dnnl_primitive_desc_create(
+                    &mpd, &op_d, dnnl_attr, engine, nullptr);
 
     if (!res) return OK;
 
@@ -120,7 +158,10 @@ static int init_pd(dnnl_engine_t engine, const prb_t *prb,
                 5, "oneDNN implementation: %s\n", res->impl_name.c_str());
     }
 
-    SAFE(check_pd_w_and_wo_attr(res, prb->attr, op_d), WARN);
+    if (prb->is_grouped())
+        SAFE(check_pd_w_and_wo_attr(res, prb->attr, grouped_op_d), WARN);
+    else
+        SAFE(check_pd_w_and_wo_attr(res, prb->attr, op_d), WARN);
 
     return OK;
 }
@@ -139,8 +180,8 @@ int init_prim_ref(
     auto cpu_attr = prb->attr;
     update_cpu_ref_attrs(cpu_attr);
     prb_t prb_cpu {*prb, conf_f32, tag::abx, tag::abx, tag::abx,
-            {vdims_t(STRIDES_SIZE)}, cpu_bia_dt, cpu_bia_mask, {0, 0, 0},
-            cpu_attr};
+            {vdims_t(STRIDES_SIZE)}, cpu_bia_dt, cpu_bia_mask, prb->groups,
+            prb->src_dyn_quant_dt, {0, 0, 0}, cpu_attr};
 
     dnnl_primitive_desc_t pd_ref_ {};
     SAFE(init_pd(get_cpu_engine(), &prb_cpu, pd_ref_, nullptr, FLAG_FWD,
@@ -243,6 +284,39 @@ void check_known_skipped_case(const prb_t *prb, res_t *res) {
     auto wei_rt_mask = prb->weights_runtime_dim_mask();
     auto dst_rt_mask = prb->dst_runtime_dim_mask();
 
+    // src dynamic quantization takes f32 or bf16 src and s8 weights, and
+    // is supported only on CPU
+    if (prb->with_src_dyn_quant()) {
+        const bool dt_ok = prb->src_dyn_quant_dt == dnnl_s8
+                && (prb->cfg[SRC].dt == dnnl_f32
+                        || prb->cfg[SRC].dt == dnnl_bf16)
+                && prb->cfg[WEI].dt == dnnl_s8;
+        if (!dt_ok || !prb->attr.zero_points.is_def()) {
+            res->state = SKIPPED, res->reason = INVALID_CASE;
+            return;
+        }
+        if (is_gpu()) {
+            res->state = SKIPPED, res->reason = CASE_NOT_SUPPORTED;
+            return;
+        }
+    }
+
+    // grouped matmul takes 2D src and dst, and dense weights of a known shape
+    if (prb->is_grouped()) {
+        const bool wtag_ok = prb->wtag == tag::any
+                || normalize_tag(prb->wtag, prb->ndims)
+                        == normalize_tag(tag::abx, prb->ndims);
+        if (prb->ndims != 2 || wei_rt_mask.any() || !wtag_ok
+                || !prb->strides[STRIDES_WEI].empty()) {
+            res->state = SKIPPED, res->reason = INVALID_CASE;
+            return;
+        }
+        if (is_gpu()) {
+            res->state = SKIPPED, res->reason = CASE_NOT_SUPPORTED;
+            return;
+        }
+    }
+
     // memory layout should be defined when some dimension is unknown in pd
     // creation time
     if ((src_rt_mask.any() && prb->stag == "any")
@@ -417,8 +491,9 @@ int doit(const prb_t *prb, res_t *res) {
     if (prb->bia_dt != dnnl_data_type_undef) {
         dims_t bia_dims;
         prep_bia_dims(prb, bia_dims);
-        DNN_SAFE(dnnl_memory_desc_init_by_strides(&bia_md, prb->ndims,
-                         bia_dims.data(), prb->bia_dt, nullptr),
+        DNN_SAFE(dnnl_memory_desc_init_by_strides(&bia_md,
+                         (int)bia_dims.size(), bia_dims.data(), prb->bia_dt,
+                         nullptr),
                 WARN);
     }
 
@@ -447,6 +522,12 @@ int doit(const prb_t *prb, res_t *res) {
     if (prb->bia_dt != dnnl_data_type_undef)
         bia_dt = dnn_mem_t(bia_md, test_engine);
     dnn_mem_t scratchpad_dt(scratchpad_md, test_engine);
+    dnn_mem_t grp_dt;
+    if (prb->is_grouped()) {
+        grp_dt = dnn_mem_t(q(DNNL_ARG_GROUP_OFFSETS), test_engine);
+        for (int g = 0; g <= prb->groups; ++g)
+            grp_dt.set_elem(g, prb->group_offsets[g]);
+    }
 
     const auto fp = dnnl_f32;
     dnn_mem_t src_fp(src_md, fp, tag::abx, ref_engine);
@@ -494,6 +575,7 @@ int doit(const prb_t *prb, res_t *res) {
     args.set(DNNL_ARG_DST, dst_dt);
     if (prb->bia_dt != dnnl_data_type_undef) args.set(DNNL_ARG_BIAS, bia_dt);
     args.set(DNNL_ARG_SCRATCHPAD, scratchpad_dt);
+    if (prb->is_grouped()) args.set(DNNL_ARG_GROUP_OFFSETS, grp_dt);
     args.set(DNNL_ARG_ATTR_OUTPUT_SCALES, scales);
     args.set(DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_SRC, src_zero_points_m);
     args.set(DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_WEIGHTS, wei_zero_points_m);
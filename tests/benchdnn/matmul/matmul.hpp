@@ -62,6 +62,8 @@ struct settings_t {
     std::vector<vdims_t> strides {vdims_t(STRIDES_SIZE)};
     std::vector<dnnl_data_type_t> bia_dt {dnnl_data_type_undef};
     std::vector<int> bia_mask {2};
+    std::vector<int> groups {0};
+    std::vector<dnnl_data_type_t> src_dyn_quant_dt {dnnl_data_type_undef};
     std::vector<std::vector<dims_mask_t>> rt_dims_masks {{}};
     std::vector<attr_t::scale_t> oscale {attr_t::scale_t()};
     std::vector<attr_t::zero_points_t> zero_points {attr_t::zero_points_t()};
@@ -85,7 +87,8 @@ struct prb_t : public prb_vdims_t {
     prb_t(const prb_vdims_t &prb_vdims, const dt_conf_t *cfg,
             const std::string &stag, const std::string &wtag,
             const std::string &dtag, const vdims_t &strides,
-            dnnl_data_type_t bia_dt, int bia_mask,
+            dnnl_data_type_t bia_dt, int bia_mask, int groups,
+            dnnl_data_type_t src_dyn_quant_dt,
             const std::vector<dims_mask_t> &rt_dims_masks, const attr_t &attr)
         : prb_vdims_t(prb_vdims)
         , cfg(cfg)
@@ -95,6 +98,8 @@ struct prb_t : public prb_vdims_t {
         , strides(strides)
         , bia_dt(bia_dt)
         , bia_mask(bia_mask)
+        , groups(groups)
+        , src_dyn_quant_dt(src_dyn_quant_dt)
         , rt_dims_masks(rt_dims_masks)
         , attr(attr)
         , scales(NULL) {
@@ -114,6 +119,7 @@ struct prb_t : public prb_vdims_t {
         ops = 2. * nelems * k;
 
         generate_oscales();
+        generate_group_offsets();
         src_zp = generate_zero_points(DNNL_ARG_SRC, attr.zero_points, k);
         dst_zp = generate_zero_points(DNNL_ARG_DST, attr.zero_points, n);
     }
@@ -129,6 +135,8 @@ struct prb_t : public prb_vdims_t {
     vdims_t strides;
     dnnl_data_type_t bia_dt;
     int bia_mask;
+    int groups;
+    dnnl_data_type_t src_dyn_quant_dt;
     std::vector<dims_mask_t> rt_dims_masks;
 
     attr_t attr;
@@ -136,6 +144,9 @@ struct prb_t : public prb_vdims_t {
     double ops;
     float *scales;
     int32_t *src_zp, *dst_zp;
+    // Grouped matmul: rows [group_offsets[g], group_offsets[g + 1]) of src
+    // are multiplied by the g-th weights matrix.
+    std::vector<int32_t> group_offsets;
 
     const dims_t &src_dims() const { return vdims[0]; }
     const dims_t &weights_dims() const { return vdims[1]; }
@@ -152,7 +163,17 @@ struct prb_t : public prb_vdims_t {
 
     int bias_broadcast_mask() const { return bia_mask; }
 
+    bool is_grouped() const { return groups > 0; }
+    bool with_src_dyn_quant() const {
+        return src_dyn_quant_dt != dnnl_data_type_undef;
+    }
+    int64_t group_idx(int64_t m) const {
+        return std::upper_bound(group_offsets.begin(), group_offsets.end(), m)
+                - group_offsets.begin() - 1;
+    }
+
     void generate_oscales();
+    void generate_group_offsets();
     int32_t *generate_zero_points(
             int arg, const attr_t::zero_points_t &zero_points, int N);
 
@@ -201,6 +222,7 @@ struct perf_report_t : public base_perf_report_t {
     void dump_desc_csv(std::ostream &s) const override { dump_desc(s); }
 
     double ops() const override { return p_->ops; }
+    dnnl_data_type_t ops_dt() const override { return p_->cfg[WEI].dt; }
     const attr_t *attr() const override { return &p_->attr; }
     const char *name() const override { return p_->name.c_str(); }
     const std::vector<std::string> *stag() const override { return &stag_; }
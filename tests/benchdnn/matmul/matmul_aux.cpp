@@ -59,6 +59,27 @@ void prb_t::generate_oscales() {
     }
 }
 
+void prb_t::generate_group_offsets() {
+    if (!is_grouped()) return;
+
+    // Split rows between groups with uneven weights, leaving some groups
+    // empty, so that the offsets exercise group boundaries inside blocks.
+    std::vector<int64_t> weights(groups);
+    int64_t total = 0;
+    for (int g = 0; g < groups; ++g) {
+        weights[g] = (g * 7 + 3) % 5;
+        total += weights[g];
+    }
+
+    group_offsets.resize(groups + 1);
+    group_offsets[0] = 0;
+    int64_t acc = 0;
+    for (int g = 0; g < groups; ++g) {
+        acc += weights[g];
+        group_offsets[g + 1] = (int32_t)(m * acc / total);
+    }
+}
+
 int32_t *prb_t::generate_zero_points(
         int arg, const attr_t::zero_points_t &zero_points, int N) {
     if (zero_points.is_def(arg)) return nullptr;
@@ -104,6 +125,11 @@ std::ostream &operator<<(std::ostream &s, const prb_t &prb) {
             s << "--bia_mask=" << prb.bia_mask << " ";
     }
 
+    if (canonical || prb.groups != def.groups[0])
+        s << "--groups=" << prb.groups << " ";
+    if (canonical || prb.src_dyn_quant_dt != def.src_dyn_quant_dt[0])
+        s << "--src_dyn_quant=" << prb.src_dyn_quant_dt << " ";
+
     s << prb.attr;
     s << static_cast<const prb_vdims_t &>(prb);
 
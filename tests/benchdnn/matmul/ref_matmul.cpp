@@ -38,6 +38,25 @@ void compute_ref_matmul(const prb_t *prb, const args_t &args) {
     const auto src_broadcast_mask = prb->src_broadcast_mask();
     const auto wei_broadcast_mask = prb->weights_broadcast_mask();
 
+    // src rows are quantized to s8 with a scale of 127 / absmax of the row
+    const bool with_src_dyn_quant = prb->with_src_dyn_quant();
+    const int64_t src_rows = src_m.nelems() / K;
+    std::vector<float> src_q, src_row_scales;
+    if (with_src_dyn_quant) {
+        src_q.resize(src_rows * K);
+        src_row_scales.resize(src_rows);
+        dnnl::impl::parallel_nd(src_rows, [&](int64_t r) {
+            auto src = (const float *)src_m + r * K;
+            float amax = 0;
+            for (int64_t k = 0; k < K; ++k)
+                amax = MAX2(amax, fabsf(src[k]));
+            const float qscale = amax > 0 ? 127.f / amax : 0.f;
+            for (int64_t k = 0; k < K; ++k)
+                src_q[r * K + k] = saturate_and_round<dnnl_s8>(src[k] * qscale);
+            src_row_scales[r] = amax / 127.f;
+        });
+    }
+
     dnnl::impl::parallel_nd(MB, M, N, [&](int64_t mb, int64_t m, int64_t n) {
         auto src = (const float *)src_m;
         auto wei = (const float *)wei_m;
@@ -45,13 +64,16 @@ void compute_ref_matmul(const prb_t *prb, const args_t &args) {
         float dst = 0;
         const int64_t src_mb
                 = dst_m.get_scale_idx(mb, src_broadcast_mask, batch_ndims);
-        const int64_t wei_mb
-                = dst_m.get_scale_idx(mb, wei_broadcast_mask, batch_ndims);
+        const int64_t wei_mb = prb->is_grouped()
+                ? prb->group_idx(m)
+                : dst_m.get_scale_idx(mb, wei_broadcast_mask, batch_ndims);
         for (int64_t k = 0; k < K; ++k) {
-            auto s = src[src_off_f(prb, src_mb, m, k)];
+            const int64_t src_off = src_off_f(prb, src_mb, m, k);
+            auto s = with_src_dyn_quant ? src_q[src_off] : src[src_off];
             maybe_zero_point(prb->attr, s, prb->src_zp, k, DNNL_ARG_SRC);
             dst += s * (wei[wei_off_f(prb, wei_mb, k, n)] - wei_zero_point);
         }
+        if (with_src_dyn_quant) dst *= src_row_scales[src_mb * M + m];
         ((float *)dst_tmp)[dst_off_f(prb, mb, m, n)] = dst;
     });
 
@@ -64,6 +86,12 @@ void compute_ref_matmul(const prb_t *prb, const args_t &args) {
         float tmp = ((float *)dst_tmp)[dst_off];
         if (prb->bia_dt != dnnl_data_type_undef) {
             int64_t bia_off = dst_m.get_scale_idx(dst_off, bias_broadcast_mask);
+            if (prb->is_grouped()) {
+                const int64_t g = (bias_broadcast_mask & 1) ? prb->group_idx(m)
+                                                            : 0;
+                const int64_t bia_n = (bias_broadcast_mask & 2) ? N : 1;
+                bia_off = g * bia_n + ((bias_broadcast_mask & 2) ? n : 0);
+            }
             float *bia_ptr = (float *)bia_m;
             tmp += bia_ptr[bia_off];
         }
@@ -297,6 +297,30 @@ static bool parse_fix_times_per_prb(
     return false;
 }
 
+static bool parse_instances(
+        const char *str, const std::string &option_name = "instances") {
+    if (!parse_single_value_option(n_instances, 1, atoi, str, option_name))
+        return false;
+    n_instances = MAX2(1, n_instances);
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+    if (n_instances > 1) {
+        n_instances = 1;
+        fprintf(stderr,
+                "%s driver: WARNING: option `instances` is not supported with "
+                "the threadpool runtime.\n",
+                driver_name);
+    }
+#endif
+    return true;
+}
+
+static bool parse_instance_nthr(
+        const char *str, const std::string &option_name = "instance-nthr") {
+    if (parse_single_value_option(instance_nthr, 0, atoi, str, option_name))
+        return instance_nthr = MAX2(0, instance_nthr), true;
+    return false;
+}
+
 static bool parse_verbose(
         const char *str, const std::string &option_name = "verbose") {
     const std::string pattern("-v"); // check short option first
@@ -423,16 +447,88 @@ static bool parse_attr_same_pd_check(const char *str,
             attr_same_pd_check, false, str2bool, str, option_name);
 }
 
+static bool parse_cache_import(
+        const char *str, const std::string &option_name = "cache-import") {
+    return parse_single_value_option(cache_import_file, std::string(),
+            [](const std::string &s) { return s; }, str, option_name);
+}
+
+static bool parse_cache_export(
+        const char *str, const std::string &option_name = "cache-export") {
+    return parse_single_value_option(cache_export_file, std::string(),
+            [](const std::string &s) { return s; }, str, option_name);
+}
+
+static bool parse_mem_hugepages(
+        const char *str, const std::string &option_name = "mem-hugepages") {
+    const bool parsed = parse_single_value_option(mem_hugepages,
+            dnnl_cpu_hugepages_none,
+            [](const std::string &s) {
+                if (s == "none") return dnnl_cpu_hugepages_none;
+                if (s == "thp") return dnnl_cpu_hugepages_thp;
+                if (s == "hugetlb") return dnnl_cpu_hugepages_hugetlb;
+                fprintf(stderr,
+                        "ERROR: unknown huge pages mode `%s`, exiting...\n",
+                        s.c_str());
+                exit(2);
+            },
+            str, option_name);
+    if (parsed) DNN_SAFE_V(dnnl_set_cpu_hugepages_mode(mem_hugepages));
+    return parsed;
+}
+
+static bool parse_perf_counters(
+        const char *str, const std::string &option_name = "perf-counters") {
+    const bool parsed = parse_single_value_option(
+            collect_perf_counters, false, str2bool, str, option_name);
+#if !defined(__linux__)
+    if (parsed && collect_perf_counters) {
+        collect_perf_counters = false;
+        fprintf(stderr,
+                "%s driver: WARNING: option `perf-counters` is supported on "
+                "Linux only.\n",
+                driver_name);
+    }
+#endif
+    return parsed;
+}
+
+static bool parse_roofline(
+        const char *str, const std::string &option_name = "roofline") {
+    return parse_single_value_option(
+            report_roofline, false, str2bool, str, option_name);
+}
+
+static bool parse_cold_cache(
+        const char *str, const std::string &option_name = "cold-cache") {
+    return parse_single_value_option(
+            cold_cache_mode, cold_cache_mode_t::none,
+            [](const std::string &s) {
+                if (s == "none") return cold_cache_mode_t::none;
+                if (s == "wei") return cold_cache_mode_t::wei;
+                if (s == "all") return cold_cache_mode_t::all;
+                fprintf(stderr,
+                        "ERROR: unknown cold cache mode `%s`, exiting...\n",
+                        s.c_str());
+                exit(2);
+            },
+            str, option_name);
+}
+
 bool parse_bench_settings(const char *str) {
     last_parsed_is_problem = false; // if start parsing, expect an option
 
     return parse_bench_mode(str) || parse_max_ms_per_prb(str)
-            || parse_fix_times_per_prb(str) || parse_verbose(str)
+            || parse_fix_times_per_prb(str) || parse_instances(str)
+            || parse_instance_nthr(str) || parse_verbose(str)
             || parse_engine(str) || parse_fast_ref_gpu(str)
             || parse_canonical(str) || parse_mem_check(str)
             || parse_skip_impl(str) || parse_allow_enum_tags_only(str)
             || parse_cpu_isa_hints(str) || parse_memory_kind(str)
-            || parse_test_start(str) || parse_attr_same_pd_check(str);
+            || parse_test_start(str) || parse_attr_same_pd_check(str)
+            || parse_cache_import(str) || parse_cache_export(str)
+            || parse_mem_hugepages(str) || parse_perf_counters(str)
+            || parse_roofline(str) || parse_cold_cache(str);
 }
 
 void catch_unknown_options(const char *str) {
@@ -0,0 +1,212 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <string.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "utils/perf_counters.hpp"
+
+namespace perf_counters {
+
+#if defined(__linux__)
+namespace {
+
+// Returns a file descriptor of the counter or -1 on failure.
+int open_event(uint32_t type, uint64_t config, bool is_uncore, int pid,
+        int cpu) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+            | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // Uncore PMUs do not support filtering by privilege level. For core
+    // events only user space is counted, which works with the default
+    // perf_event_paranoid setting.
+    if (!is_uncore) {
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+    }
+    return (int)syscall(__NR_perf_event_open, &attr, pid, cpu, -1, 0);
+}
+
+std::vector<int> get_thread_ids() {
+    std::vector<int> tids;
+    DIR *dir = opendir("/proc/self/task");
+    if (!dir) return tids;
+    while (struct dirent *entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') continue;
+        tids.push_back(atoi(entry->d_name));
+    }
+    closedir(dir);
+    return tids;
+}
+
+std::string read_line(const std::string &path) {
+    std::ifstream f(path);
+    std::string line;
+    if (f) std::getline(f, line);
+    return line;
+}
+
+// Translates an event description from sysfs, e.g. `event=0x04,umask=0x03`,
+// into the `config` value according to the PMU format, e.g. `config:8-15`
+// for `umask`.
+bool get_uncore_config(const std::string &pmu_dir, const std::string &event,
+        uint64_t &config) {
+    const std::string desc = read_line(pmu_dir + "/events/" + event);
+    if (desc.empty()) return false;
+
+    config = 0;
+    std::stringstream ss(desc);
+    std::string term;
+    while (std::getline(ss, term, ',')) {
+        const size_t eq_pos = term.find('=');
+        const std::string name = term.substr(0, eq_pos);
+        const uint64_t value = eq_pos == std::string::npos
+                ? 1
+                : strtoull(term.c_str() + eq_pos + 1, nullptr, 0);
+
+        const std::string format = read_line(pmu_dir + "/format/" + name);
+        if (format.compare(0, 7, "config:") != 0) return false;
+        const int lo = atoi(format.c_str() + 7);
+        config |= value << lo;
+    }
+    return true;
+}
+
+} // namespace
+
+collector_t::collector_t() {
+    const std::vector<int> tids = get_thread_ids();
+
+    auto add_core_event = [&](counter_kind_t kind, uint32_t type,
+                                  uint64_t config) {
+        event_t e {kind, 1., {}};
+        for (int tid : tids) {
+            const int fd = open_event(type, config, false, tid, -1);
+            // The thread may have exited since the enumeration.
+            if (fd < 0 && errno == ESRCH) continue;
+            if (fd < 0) {
+                for (int opened_fd : e.fds)
+                    close(opened_fd);
+                return;
+            }
+            e.fds.push_back(fd);
+        }
+        if (!e.fds.empty()) events_.push_back(e);
+    };
+
+    add_core_event(cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    add_core_event(
+            instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    add_core_event(
+            llc_misses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    add_core_event(dtlb_misses, PERF_TYPE_HW_CACHE,
+            PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                    | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+
+    // Memory controller counters are system-wide and usually require
+    // elevated permissions. Each CAS command transfers a 64-byte line.
+    const char *devices_dir = "/sys/bus/event_source/devices";
+    DIR *dir = opendir(devices_dir);
+    if (!dir) return;
+    while (struct dirent *entry = readdir(dir)) {
+        if (strncmp(entry->d_name, "uncore_imc", 10) != 0) continue;
+        const std::string pmu_dir
+                = std::string(devices_dir) + "/" + entry->d_name;
+        const std::string type = read_line(pmu_dir + "/type");
+        const std::string cpumask = read_line(pmu_dir + "/cpumask");
+        if (type.empty() || cpumask.empty()) continue;
+
+        for (const char *name : {"cas_count_read", "cas_count_write"}) {
+            uint64_t config = 0;
+            if (!get_uncore_config(pmu_dir, name, config)) continue;
+
+            event_t e {dram_bytes, 64., {}};
+            std::stringstream ss(cpumask);
+            std::string cpu;
+            while (std::getline(ss, cpu, ',')) {
+                const int fd = open_event((uint32_t)atoi(type.c_str()),
+                        config, true, -1, atoi(cpu.c_str()));
+                if (fd >= 0) e.fds.push_back(fd);
+            }
+            if (!e.fds.empty()) events_.push_back(e);
+        }
+    }
+    closedir(dir);
+}
+
+collector_t::~collector_t() {
+    for (auto &e : events_)
+        for (int fd : e.fds)
+            close(fd);
+}
+
+void collector_t::start() {
+    for (auto &e : events_)
+        for (int fd : e.fds) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+}
+
+void collector_t::stop(values_t &values, int times) {
+    for (auto &e : events_)
+        for (int fd : e.fds)
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+    for (auto &e : events_) {
+        double sum = 0;
+        for (int fd : e.fds) {
+            // value, time enabled, time running
+            uint64_t data[3] = {0, 0, 0};
+            if (read(fd, data, sizeof(data)) != sizeof(data)) continue;
+            // Scale the value if the counter was multiplexed.
+            if (data[2] > 0) sum += (double)data[0] * data[1] / data[2];
+        }
+        values.total[e.kind] += sum * e.scale;
+        values.available[e.kind] = true;
+    }
+    values.times += times;
+}
+
+#else
+
+collector_t::collector_t() = default;
+collector_t::~collector_t() = default;
+void collector_t::start() {}
+void collector_t::stop(values_t &values, int times) {
+    values.times += times;
+}
+
+#endif
+
+} // namespace perf_counters
@@ -0,0 +1,77 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef UTILS_PERF_COUNTERS_HPP
+#define UTILS_PERF_COUNTERS_HPP
+
+#include <vector>
+
+namespace perf_counters {
+
+enum counter_kind_t {
+    cycles = 0,
+    instructions,
+    llc_misses,
+    dtlb_misses,
+    // DRAM traffic measured with uncore memory controller counters.
+    dram_bytes,
+    n_counters
+};
+
+// Counter values accumulated over `times` runs of a primitive.
+struct values_t {
+    double total[n_counters];
+    bool available[n_counters];
+    int times;
+
+    bool is_available(counter_kind_t kind) const {
+        return times > 0 && available[kind];
+    }
+    // Returns the average value per run.
+    double get(counter_kind_t kind) const {
+        return is_available(kind) ? total[kind] / times : 0;
+    }
+};
+
+// Collects hardware counters of all threads of the process with Linux
+// perf_event_open. Counters which cannot be opened, e.g. due to missing
+// permissions or lack of hardware support, are reported as not available.
+// The threads are enumerated at construction, so the threads created later
+// are not counted.
+struct collector_t {
+    collector_t();
+    ~collector_t();
+
+    void start();
+    // Stops counting and adds the counter values to `values`, which are
+    // treated as collected over `times` runs.
+    void stop(values_t &values, int times);
+
+private:
+    struct event_t {
+        counter_kind_t kind;
+        double scale;
+        std::vector<int> fds;
+    };
+    std::vector<event_t> events_;
+
+    collector_t(const collector_t &) = delete;
+    collector_t &operator=(const collector_t &) = delete;
+};
+
+} // namespace perf_counters
+
+#endif
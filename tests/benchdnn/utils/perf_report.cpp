@@ -14,17 +14,32 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
+#include <cctype>
+
 #include "dnn_types.hpp"
 #include "dnnl_common.hpp"
 
 #include "utils/perf_report.hpp"
+#include "utils/roofline.hpp"
 
 void base_perf_report_t::report(res_t *res, const char *prb_str) const {
-    dump_perf_footer();
+    // Hardware counter metrics are appended to any template.
+    std::string pt_str = pt_;
+    if (collect_perf_counters)
+        pt_str += ",%Mcycles%,%Minsts%,%ipc%,%Kllc_misses%,%Kdtlb_misses%,"
+                  "%Mdram_bytes%,%bpf%";
+    if (n_instances > 1)
+        pt_str += ",%thrpt%,%Gthrpt_flops%,%p50time%,%p99time%";
+    if (report_roofline) {
+        if (is_cpu()) roofline::init();
+        pt_str += ",%ai%,%-eff%,%bound%";
+    }
+    dump_perf_footer(pt_str);
 
     std::stringstream ss;
 
-    const char *pt = pt_;
+    const char *pt = pt_str.c_str();
     char c;
     while ((c = *pt++) != '\0') {
         if (c != '%') {
@@ -70,6 +85,86 @@ void base_perf_report_t::handle_option(std::ostream &s, const char *&option,
         return t.ticks(mode) / t.sec(mode) / unit;
     };
 
+    auto dump_thrpt = [&](double ops_per_run) {
+        if (res->throughput > 0)
+            s << res->throughput * ops_per_run / unit;
+        else
+            s << "n/a";
+    };
+
+    // Counter values are averaged over all runs regardless of the time
+    // modifier. Values which were not collected are reported as `n/a`.
+    using namespace perf_counters;
+    const values_t &cnt = res->counters;
+    auto dump_counter = [&](counter_kind_t kind) {
+        if (cnt.is_available(kind))
+            s << cnt.get(kind) / unit;
+        else
+            s << "n/a";
+    };
+
+    auto dump_ipc = [&]() {
+        if (cnt.is_available(cycles) && cnt.is_available(instructions)
+                && cnt.get(cycles) > 0)
+            s << cnt.get(instructions) / cnt.get(cycles);
+        else
+            s << "n/a";
+    };
+
+    auto dump_dram_bw = [&](const timer::timer_t &t) {
+        if (cnt.is_available(dram_bytes) && t.sec(timer::timer_t::avg) > 0)
+            s << cnt.get(dram_bytes) / t.sec(timer::timer_t::avg) / unit;
+        else
+            s << "n/a";
+    };
+
+    // Bytes per flop are based on the DRAM traffic when it is available and
+    // on the LLC misses otherwise.
+    auto dump_bpf = [&]() {
+        const bool has_bytes = cnt.is_available(dram_bytes)
+                || cnt.is_available(llc_misses);
+        if (!has_bytes || ops() <= 0) {
+            s << "n/a";
+            return;
+        }
+        const double bytes = cnt.is_available(dram_bytes)
+                ? cnt.get(dram_bytes)
+                : cnt.get(llc_misses) * 64;
+        s << bytes / ops();
+    };
+
+    // Roofline model: the attainable performance is the minimum of the peak
+    // compute throughput and the memory bandwidth multiplied by the
+    // arithmetic intensity, which is based on the problem input and output
+    // sizes.
+    const bool has_roofline = roofline::is_initialized() && is_cpu()
+            && ops() > 0 && res->ibytes + res->obytes > 0;
+    const double ai = has_roofline ? ops() / (res->ibytes + res->obytes) : 0;
+    const double peak_ops = has_roofline ? roofline::peak_ops(ops_dt()) : 0;
+    const double peak_bw_ops = ai * roofline::machine().bw_bytes_per_sec;
+
+    auto dump_eff = [&](const timer::timer_t &t) {
+        const double attainable = std::min(peak_ops, peak_bw_ops);
+        if (has_roofline && attainable > 0 && t.sec(mode) > 0)
+            s << 100. * ops() / t.sec(mode) / attainable;
+        else
+            s << "n/a";
+    };
+
+    auto dump_ai = [&]() {
+        if (has_roofline)
+            s << ai;
+        else
+            s << "n/a";
+    };
+
+    auto dump_bound = [&]() {
+        if (has_roofline && peak_ops > 0 && peak_bw_ops > 0)
+            s << (peak_bw_ops < peak_ops ? "memory" : "compute");
+        else
+            s << "n/a";
+    };
+
     // Please update doc/knobs_perf_report.md in case of any new options!
 
 #define HANDLE(opt, ...) \
@@ -118,9 +213,35 @@ void base_perf_report_t::handle_option(std::ostream &s, const char *&option,
     HANDLE("obytes", s << res->obytes / unit);
     HANDLE("iobytes", s << (res->ibytes + res->obytes) / unit);
     HANDLE("idx", s << benchdnn_stat.tests);
+    HANDLE("thrpt", dump_thrpt(1));
+    HANDLE("thrpt_flops", dump_thrpt(ops()));
+    // Options operating on the roofline model.
+    HANDLE("ai", dump_ai());
+    HANDLE("eff", dump_eff(res->timer_map.perf_timer()));
+    HANDLE("bound", dump_bound());
+    // Options operating on hardware counters.
+    HANDLE("cycles", dump_counter(cycles));
+    HANDLE("insts", dump_counter(instructions));
+    HANDLE("ipc", dump_ipc());
+    HANDLE("llc_misses", dump_counter(llc_misses));
+    HANDLE("dtlb_misses", dump_counter(dtlb_misses));
+    HANDLE("dram_bytes", dump_counter(dram_bytes));
+    HANDLE("dram_bw", dump_dram_bw(res->timer_map.perf_timer()));
+    HANDLE("bpf", dump_bpf());
 
 #undef HANDLE
 
+    // Percentiles of the time of a run, e.g. %p99time% or %p99.9time%.
+    if (c == 'p' && isdigit(option[1])) {
+        char *end = nullptr;
+        const double p = strtod(option + 1, &end);
+        if (p > 0 && p <= 100 && !strncmp(end, "time%", 5)) {
+            s << res->timer_map.perf_timer().percentile_ms(p) / unit;
+            option = end + 5;
+            return;
+        }
+    }
+
     auto opt_name = std::string(option);
     opt_name.pop_back();
     BENCHDNN_PRINT(0, "Error: perf report option \"%s\" is not supported\n",
@@ -54,6 +54,8 @@ struct base_perf_report_t {
     virtual const std::string *wtag() const { return nullptr; }
     virtual const dnnl_prop_kind_t *prop() const { return nullptr; }
     virtual const int64_t *user_mb() const { return nullptr; }
+    // Data type of the computations used to pick the peak for the roofline.
+    virtual dnnl_data_type_t ops_dt() const { return dnnl_f32; }
 
     /* designed to be overloaded in reorder only to match verbose output */
     virtual void dump_engine(std::ostream &s) const { s << engine_tgt_kind; }
@@ -73,10 +75,10 @@ private:
     void handle_option(std::ostream &s, const char *&option, res_t *res,
             const char *prb_str) const;
 
-    void dump_perf_footer() const {
+    void dump_perf_footer(const std::string &pt) const {
         static bool footer_printed = false;
         if (!footer_printed) {
-            BENCHDNN_PRINT(0, "Output template: %s\n", pt_);
+            BENCHDNN_PRINT(0, "Output template: %s\n", pt.c_str());
             footer_printed = true;
         }
     }
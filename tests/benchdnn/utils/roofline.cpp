@@ -0,0 +1,180 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "tests/test_thread.hpp"
+
+#include "cpu/platform.hpp"
+
+#include "common.hpp"
+#include "utils/roofline.hpp"
+
+namespace roofline {
+
+namespace {
+
+machine_t machine_ {0., 0, 0.};
+bool initialized = false;
+
+double sec_now() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Runs a chain of dependent register additions, each of which takes a cycle
+// on all supported CPUs. Additions of immediate values are not used as some
+// CPUs eliminate them at the renaming stage. The result reflects the
+// frequency of a single core, which may be higher than the all-core frequency
+// under load.
+double estimate_freq_hz() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ADD4 "add %1, %0\n\tadd %1, %0\n\tadd %1, %0\n\tadd %1, %0\n\t"
+    const long n_iters = 4 * 1000 * 1000;
+    const int n_adds = 16;
+    double best_sec = 0;
+    for (int run = 0; run < 3; run++) {
+        long x = 0;
+        const double start = sec_now();
+        for (long i = 0; i < n_iters; i++)
+            __asm__ volatile(ADD4 ADD4 ADD4 ADD4 : "+r"(x) : "r"(i));
+        const double sec = sec_now() - start;
+        if (run == 0 || sec < best_sec) best_sec = sec;
+    }
+#undef ADD4
+    return best_sec > 0 ? (double)n_iters * n_adds / best_sec : 0;
+#else
+    return 0;
+#endif
+}
+
+// Measures the bandwidth of a parallel copy with scaling between two buffers
+// which are much larger than the last level cache. The traffic is counted
+// the same way as in the STREAM benchmark, i.e. without write-allocate.
+double measure_bw_bytes_per_sec(int nthr) {
+    using namespace dnnl::impl::cpu;
+    const size_t llc_size
+            = (size_t)platform::get_per_core_cache_size(3) * nthr;
+    const size_t buf_size
+            = std::max((size_t)64 * 1024 * 1024, 4 * llc_size);
+    const int64_t nelems = (int64_t)(buf_size / sizeof(float));
+
+    float *src = (float *)zmalloc(buf_size, 64);
+    float *dst = (float *)zmalloc(buf_size, 64);
+    if (!src || !dst) {
+        zfree(src);
+        zfree(dst);
+        return 0;
+    }
+
+    const int64_t chunk = 16 * 1024;
+    const int64_t nchunks = div_up(nelems, chunk);
+    auto copy = [&](float alpha) {
+        dnnl::impl::parallel_nd(nchunks, [&](int64_t c) {
+            const int64_t end = std::min(nelems, (c + 1) * chunk);
+            for (int64_t i = c * chunk; i < end; i++)
+                dst[i] = alpha * src[i];
+        });
+    };
+
+    // The first run touches the pages with the same thread distribution.
+    copy(0.f);
+    double best_sec = 0;
+    for (int run = 0; run < 5; run++) {
+        const double start = sec_now();
+        copy(1.f);
+        const double sec = sec_now() - start;
+        if (run == 0 || sec < best_sec) best_sec = sec;
+    }
+
+    zfree(src);
+    zfree(dst);
+    return best_sec > 0 ? 2. * buf_size / best_sec : 0;
+}
+
+// The number of operations per cycle per core assumes two vector execution
+// ports capable of FMA (or dot-product) instructions for Intel AVX2 and newer
+// ISAs. Data types without native support fall back to the f32 peak.
+double ops_per_cycle(dnnl_cpu_isa_t isa, dnnl_data_type_t dt) {
+    const bool is_int8 = dt == dnnl_s8 || dt == dnnl_u8;
+    const bool is_bf16 = dt == dnnl_bf16;
+    switch (isa) {
+        case dnnl_cpu_isa_sse41: return is_int8 ? 16 : 8;
+        case dnnl_cpu_isa_avx: return 16;
+        case dnnl_cpu_isa_avx2: return is_int8 ? 64 : 32;
+        case dnnl_cpu_isa_avx2_vnni: return is_int8 ? 128 : 32;
+        case dnnl_cpu_isa_avx512_mic:
+        case dnnl_cpu_isa_avx512_mic_4ops:
+        case dnnl_cpu_isa_avx512_core: return is_int8 ? 128 : 64;
+        case dnnl_cpu_isa_avx512_core_vnni: return is_int8 ? 256 : 64;
+        case dnnl_cpu_isa_avx512_core_bf16:
+            return is_int8 ? 256 : is_bf16 ? 128 : 64;
+        case dnnl_cpu_isa_avx512_core_amx:
+            return is_int8 ? 2048 : is_bf16 ? 1024 : 64;
+        default: return 0;
+    }
+}
+
+const char *isa2str(dnnl_cpu_isa_t isa) {
+    switch (isa) {
+        case dnnl_cpu_isa_sse41: return "sse41";
+        case dnnl_cpu_isa_avx: return "avx";
+        case dnnl_cpu_isa_avx2: return "avx2";
+        case dnnl_cpu_isa_avx2_vnni: return "avx2_vnni";
+        case dnnl_cpu_isa_avx512_mic: return "avx512_mic";
+        case dnnl_cpu_isa_avx512_mic_4ops: return "avx512_mic_4ops";
+        case dnnl_cpu_isa_avx512_core: return "avx512_core";
+        case dnnl_cpu_isa_avx512_core_vnni: return "avx512_core_vnni";
+        case dnnl_cpu_isa_avx512_core_bf16: return "avx512_core_bf16";
+        case dnnl_cpu_isa_avx512_core_amx: return "avx512_core_amx";
+        default: return "unknown";
+    }
+}
+
+} // namespace
+
+void init() {
+    if (initialized) return;
+    initialized = true;
+    machine_.nthr = dnnl_get_max_threads();
+    machine_.freq_hz = estimate_freq_hz();
+    machine_.bw_bytes_per_sec = measure_bw_bytes_per_sec(machine_.nthr);
+
+    BENCHDNN_PRINT(0,
+            "Roofline: isa:%s, nthr:%d, freq:%g GHz, f32 peak:%g GFLOPS, "
+            "bandwidth:%g GB/s\n",
+            isa2str(dnnl_get_effective_cpu_isa()), machine_.nthr,
+            machine_.freq_hz / 1e9, peak_ops(dnnl_f32) / 1e9,
+            machine_.bw_bytes_per_sec / 1e9);
+}
+
+bool is_initialized() {
+    return initialized;
+}
+
+const machine_t &machine() {
+    return machine_;
+}
+
+double peak_ops(dnnl_data_type_t dt) {
+    return ops_per_cycle(dnnl_get_effective_cpu_isa(), dt) * machine_.freq_hz
+            * machine_.nthr;
+}
+
+} // namespace roofline
@@ -0,0 +1,43 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef UTILS_ROOFLINE_HPP
+#define UTILS_ROOFLINE_HPP
+
+#include "oneapi/dnnl/dnnl_types.h"
+
+namespace roofline {
+
+// Machine characteristics used to build the roofline model of a CPU.
+struct machine_t {
+    double freq_hz; // estimated core frequency
+    int nthr; // number of threads used by the library
+    double bw_bytes_per_sec; // attainable memory bandwidth
+};
+
+// Estimates the frequency and measures the memory bandwidth. The function is
+// called once when the roofline report is requested.
+void init();
+bool is_initialized();
+const machine_t &machine();
+
+// Returns the peak number of operations per second for a given data type of
+// the computations on the current effective CPU ISA, or 0 if unknown.
+double peak_ops(dnnl_data_type_t dt);
+
+} // namespace roofline
+
+#endif
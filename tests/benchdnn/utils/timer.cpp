@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 
 #include "common.hpp"
 #include "utils/timer.hpp"
@@ -51,6 +52,7 @@ void timer_t::reset() {
     for (int i = 0; i < n_modes; ++i)
         ms_[i] = 0;
     ms_start_ = 0;
+    samples_ms_.clear();
 
     start();
 }
@@ -85,9 +87,47 @@ void timer_t::stop(int add_times) {
     ticks_[mode_t::max]
             = times_ ? std::max(ticks_[mode_t::max], d_ticks) : d_ticks;
 
+    if (keep_samples_) samples_ms_.push_back(d_ms);
     times_ += add_times;
 }
 
+double timer_t::percentile_ms(double p) const {
+    if (samples_ms_.empty()) return 0;
+
+    // Nearest-rank method.
+    std::vector<double> sorted(samples_ms_);
+    const size_t n = sorted.size();
+    size_t rank = (size_t)std::ceil(p / 100. * n);
+    rank = std::min(std::max(rank, (size_t)1), n);
+    std::nth_element(sorted.begin(), sorted.begin() + rank - 1, sorted.end());
+    return sorted[rank - 1];
+}
+
+void timer_t::merge(const timer_t &rhs) {
+    if (rhs.times_ == 0) return;
+    if (times_ == 0) {
+        *this = rhs;
+        return;
+    }
+
+    ms_[mode_t::min] = std::min(ms_[mode_t::min], rhs.ms_[mode_t::min]);
+    ms_[mode_t::max] = std::max(ms_[mode_t::max], rhs.ms_[mode_t::max]);
+    ms_[mode_t::avg] += rhs.ms_[mode_t::avg];
+    ms_[mode_t::sum] += rhs.ms_[mode_t::sum];
+
+    ticks_[mode_t::min]
+            = std::min(ticks_[mode_t::min], rhs.ticks_[mode_t::min]);
+    ticks_[mode_t::max]
+            = std::max(ticks_[mode_t::max], rhs.ticks_[mode_t::max]);
+    ticks_[mode_t::avg] += rhs.ticks_[mode_t::avg];
+    ticks_[mode_t::sum] += rhs.ticks_[mode_t::sum];
+
+    if (keep_samples_)
+        samples_ms_.insert(samples_ms_.end(), rhs.samples_ms_.begin(),
+                rhs.samples_ms_.end());
+    times_ += rhs.times_;
+}
+
 timer_t &timer_t::operator=(const timer_t &rhs) {
     if (this == &rhs) return *this;
     times_ = rhs.times_;
@@ -97,6 +137,7 @@ timer_t &timer_t::operator=(const timer_t &rhs) {
     for (int i = 0; i < n_modes; ++i)
         ms_[i] = rhs.ms_[i];
     ms_start_ = rhs.ms_start_;
+    if (keep_samples_) samples_ms_ = rhs.samples_ms_;
     return *this;
 }
 
@@ -104,7 +145,8 @@ timer_t &timer_map_t::get_timer(const std::string &name) {
     auto it = timers.find(name);
     if (it != timers.end()) return it->second;
     // Set a new timer if requested one wasn't found
-    timers.insert(std::make_pair(std::string(name), timer_t()));
+    const bool keep_samples = name == timer_t::perf_timer;
+    timers.insert(std::make_pair(std::string(name), timer_t(keep_samples)));
     return timers.find(name)->second;
 }
 
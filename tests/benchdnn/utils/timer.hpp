@@ -19,6 +19,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #define TIME_FUNC(func, res, name) \
     do { \
@@ -33,10 +34,17 @@
 
 namespace timer {
 
+double ms_now();
+
 struct timer_t {
     enum mode_t { min = 0, avg = 1, max = 2, sum = 3, n_modes };
 
-    timer_t() { reset(); }
+    // Only timers that keep the samples of the runs report percentiles.
+    // Other timers do not keep them, since they are not reset between
+    // problems and would grow without a bound.
+    timer_t(bool keep_samples = false) : keep_samples_(keep_samples) {
+        reset();
+    }
 
     void reset(); /** fully reset the measurements */
 
@@ -61,11 +69,20 @@ struct timer_t {
         return ticks_[mode] / (mode == avg ? times() : 1);
     }
 
+    // Returns the p-th percentile (0 < p <= 100) of the time of a run. The
+    // time of a batch of runs is averaged and counted as a single sample.
+    double percentile_ms(double p) const;
+
+    // Adds the measurements of another timer, e.g. of a concurrent instance.
+    void merge(const timer_t &rhs);
+
     timer_t &operator=(const timer_t &rhs);
 
     int times_;
     unsigned long long ticks_[n_modes], ticks_start_;
     double ms_[n_modes], ms_start_;
+    bool keep_samples_;
+    std::vector<double> samples_ms_;
 
     // Section with timer fixed timer names for ease of use
     static const std::string perf_timer;
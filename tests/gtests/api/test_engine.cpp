@@ -14,8 +14,15 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <thread>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include "dnnl_test_common.hpp"
 #include "gtest/gtest.h"
 
@@ -76,4 +83,126 @@ HANDLE_EXCEPTIONS_FOR_TEST_P(engine_test_t, TestMultithreading) {
 INSTANTIATE_TEST_SUITE_P(AllEngineKinds, engine_test_t,
         ::testing::Values(engine::kind::cpu, engine::kind::gpu));
 
+namespace {
+struct allocator_stats_t {
+    std::atomic<int> n_allocs[3];
+    std::atomic<int> n_frees[3];
+};
+
+void *test_alloc(size_t size, size_t alignment, dnnl_allocation_usage_t usage,
+        void *context) {
+    auto *stats = static_cast<allocator_stats_t *>(context);
+    stats->n_allocs[usage]++;
+    void *ptr = nullptr;
+#ifdef _WIN32
+    ptr = _aligned_malloc(size, alignment);
+#else
+    if (::posix_memalign(&ptr, alignment, size) != 0) ptr = nullptr;
+#endif
+    return ptr;
+}
+
+void test_free(void *ptr, dnnl_allocation_usage_t usage, void *context) {
+    auto *stats = static_cast<allocator_stats_t *>(context);
+    stats->n_frees[usage]++;
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    ::free(ptr);
+#endif
+}
+} // namespace
+
+class engine_allocator_test_t : public ::testing::Test {};
+
+HANDLE_EXCEPTIONS_FOR_TEST(engine_allocator_test_t, TestUserAllocator) {
+    if (engine::get_count(engine::kind::cpu) == 0) return;
+#ifdef DNNL_WITH_SYCL
+    // User allocators are not supported for SYCL engines.
+    EXPECT_ANY_THROW(
+            engine(engine::kind::cpu, 0, test_alloc, test_free, nullptr));
+    return;
+#endif
+
+    allocator_stats_t stats {};
+    {
+        engine eng(engine::kind::cpu, 0, test_alloc, test_free, &stats);
+
+        memory::desc src_md({16, 32, 14, 14}, memory::data_type::f32,
+                memory::format_tag::nchw);
+        memory::desc wei_md({32, 32, 3, 3}, memory::data_type::f32,
+                memory::format_tag::oihw);
+        auto src = memory(src_md, eng);
+        ASSERT_EQ(stats.n_allocs[dnnl_allocation_usage_memory], 1);
+
+        auto pd = convolution_backward_weights::primitive_desc(
+                {algorithm::convolution_direct, src_md, wei_md, src_md,
+                        {1, 1}, {1, 1}, {1, 1}},
+                eng,
+                convolution_forward::primitive_desc(
+                        {prop_kind::forward_training,
+                                algorithm::convolution_direct, src_md, wei_md,
+                                src_md, {1, 1}, {1, 1}, {1, 1}},
+                        eng));
+        auto prim = convolution_backward_weights(pd);
+        const bool has_scratchpad
+                = pd.query_s64(query::memory_consumption_s64) > 0;
+        ASSERT_EQ(stats.n_allocs[dnnl_allocation_usage_scratchpad] > 0,
+                has_scratchpad);
+    }
+    ASSERT_EQ(stats.n_frees[dnnl_allocation_usage_memory].load(),
+            stats.n_allocs[dnnl_allocation_usage_memory].load());
+    ASSERT_EQ(stats.n_frees[dnnl_allocation_usage_scratchpad].load(),
+            stats.n_allocs[dnnl_allocation_usage_scratchpad].load());
+}
+
+class engine_affinity_test_t : public ::testing::Test {};
+
+HANDLE_EXCEPTIONS_FOR_TEST(engine_affinity_test_t, TestCpuAffinity) {
+    if (engine::get_count(engine::kind::cpu) == 0) return;
+    EXPECT_ANY_THROW(engine(engine::kind::cpu, 0, std::vector<int>()));
+    EXPECT_ANY_THROW(engine(engine::kind::cpu, 0, std::vector<int> {-1}));
+#if defined(DNNL_WITH_SYCL) || !defined(__linux__)
+    // Core binding is not supported for SYCL engines and outside of Linux.
+    EXPECT_ANY_THROW(engine(engine::kind::cpu, 0, std::vector<int> {0}));
+    return;
+#endif
+
+    // The topology may be unknown, e.g. in a container.
+    auto cores = get_numa_node_cores(0);
+    if (cores.empty()) cores = {0};
+    engine eng(engine::kind::cpu, 0, cores);
+    auto strm = make_stream(eng);
+
+    memory::desc md({4, 16, 8, 8}, memory::data_type::f32,
+            memory::format_tag::nchw);
+    auto src = memory(md, eng);
+    auto dst = memory(md, eng);
+    const size_t nelems = md.get_size() / sizeof(float);
+    {
+        auto src_ptr = map_memory<float>(src);
+        for (size_t i = 0; i < nelems; i++)
+            src_ptr[i] = (float)i - nelems / 2;
+    }
+
+    auto relu = eltwise_forward(
+            {{prop_kind::forward_inference, algorithm::eltwise_relu, md, 0.f},
+                    eng});
+#if defined(__linux__)
+    cpu_set_t mask_before, mask_after;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(mask_before), &mask_before), 0);
+#endif
+    relu.execute(strm, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+    strm.wait();
+#if defined(__linux__)
+    // The binding of the calling thread is restored after the execution.
+    ASSERT_EQ(sched_getaffinity(0, sizeof(mask_after), &mask_after), 0);
+    ASSERT_TRUE(CPU_EQUAL(&mask_before, &mask_after));
+#endif
+
+    auto dst_ptr = map_memory<float>(dst);
+    for (size_t i = 0; i < nelems; i++)
+        ASSERT_EQ(dst_ptr[i], std::max((float)i - nelems / 2, 0.f));
+}
+
 } // namespace dnnl
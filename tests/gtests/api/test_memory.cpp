@@ -20,8 +20,13 @@
 #include "oneapi/dnnl/dnnl.h"
 #include "oneapi/dnnl/dnnl.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <limits>
 #include <new>
+#include <string>
+#include <vector>
 
 #ifdef DNNL_WITH_SYCL
 #include "oneapi/dnnl/dnnl_sycl.hpp"
@@ -118,6 +123,88 @@ TEST_P(memory_test_cpp_t, OutOfMemory) {
     if (!is_sycl) FAIL() << "Expected exception.";
 }
 
+TEST_P(memory_test_cpp_t, HugePages) {
+    dnnl_engine_kind_t eng_kind_c = GetParam();
+    engine::kind eng_kind = static_cast<engine::kind>(eng_kind_c);
+    SKIP_IF(eng_kind != engine::kind::cpu || is_sycl_engine(eng_kind_c),
+            "Huge pages are supported for native CPU engines only.");
+    SKIP_IF(engine::get_count(eng_kind) == 0, "Engine is not found.");
+
+    engine eng(eng_kind, 0);
+    const auto old_mode = get_cpu_hugepages_mode();
+    for (auto mode : {cpu_hugepages_mode::thp, cpu_hugepages_mode::hugetlb}) {
+        if (set_cpu_hugepages_mode(mode) == status::unimplemented) break;
+        ASSERT_EQ(get_cpu_hugepages_mode(), mode);
+
+        // Only the first buffer is large enough to use huge pages.
+        for (memory::dim sz : {3 * 1024 * 1024 + 3, 4 * 1024}) {
+            memory::desc md({sz}, memory::data_type::u8, memory::format_tag::x);
+            memory mem(md, eng);
+            auto *ptr = static_cast<uint8_t *>(mem.get_data_handle());
+            ASSERT_NE(ptr, nullptr);
+            for (memory::dim i = 0; i < sz; i += 4096)
+                ptr[i] = (uint8_t)i;
+            ptr[sz - 1] = 1;
+            ASSERT_EQ(ptr[sz - 1], 1);
+        }
+    }
+    ASSERT_EQ(set_cpu_hugepages_mode(old_mode), status::success);
+}
+
+TEST_P(memory_test_cpp_t, CreateFromFile) {
+    dnnl_engine_kind_t eng_kind_c = GetParam();
+    engine::kind eng_kind = static_cast<engine::kind>(eng_kind_c);
+    SKIP_IF(eng_kind != engine::kind::cpu || is_sycl_engine(eng_kind_c),
+            "File mapping is supported for native CPU engines only.");
+    SKIP_IF(engine::get_count(eng_kind) == 0, "Engine is not found.");
+#ifndef __linux__
+    SKIP_IF(true, "File mapping is supported on Linux only.");
+#endif
+
+    engine eng(eng_kind, 0);
+    const memory::dim n = 1000;
+    const size_t offset = 4096 + 64;
+    std::vector<float> data(n);
+    for (memory::dim i = 0; i < n; i++)
+        data[i] = float(i % 7) - 3.f;
+
+    const std::string path = "test_memory_create_from_file.bin";
+    {
+        std::ofstream f(path, std::ios::binary);
+        const std::vector<char> header(offset, 0);
+        f.write(header.data(), header.size());
+        f.write(reinterpret_cast<const char *>(data.data()),
+                data.size() * sizeof(float));
+    }
+
+    memory::desc md({n}, memory::data_type::f32, memory::format_tag::x);
+    {
+        auto src = memory::create_from_file(md, eng, path, offset);
+        const auto *ptr = static_cast<const float *>(src.get_data_handle());
+        for (memory::dim i = 0; i < n; i++)
+            ASSERT_EQ(ptr[i], data[i]);
+
+        auto dst = memory(md, eng);
+        stream s(eng);
+        eltwise_forward({{prop_kind::forward_inference,
+                                 algorithm::eltwise_relu, md, 0.f},
+                eng})
+                .execute(s, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+        s.wait();
+        const auto *dst_ptr = static_cast<const float *>(dst.get_data_handle());
+        for (memory::dim i = 0; i < n; i++)
+            ASSERT_EQ(dst_ptr[i], std::max(data[i], 0.f));
+    }
+
+    // Offset is not aligned to the data type size.
+    EXPECT_ANY_THROW(memory::create_from_file(md, eng, path, offset + 2));
+    // Region does not fit into the file.
+    EXPECT_ANY_THROW(memory::create_from_file(md, eng, path, offset + 4));
+    EXPECT_ANY_THROW(memory::create_from_file(md, eng, path + ".none", 0));
+
+    std::remove(path.c_str());
+}
+
 namespace {
 struct print_to_string_param_name_t {
     template <class ParamType>
@@ -19,6 +19,7 @@
 
 #include "oneapi/dnnl/dnnl.h"
 
+#include <algorithm>
 #include <tuple>
 
 namespace dnnl {
@@ -137,6 +138,77 @@ TEST(stream_test_c_t, GetStream) {
 }
 #endif
 
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE \
+        && DNNL_CPU_THREADING_RUNTIME != DNNL_RUNTIME_THREADPOOL
+HANDLE_EXCEPTIONS_FOR_TEST(stream_test_cpp_t, MaxThreads) {
+    engine eng(engine::kind::cpu, 0);
+    EXPECT_ANY_THROW(stream(eng, stream::flags::default_flags, -1));
+    ASSERT_EQ(set_max_threads_limit(-1), status::invalid_arguments);
+
+    const int max_threads = 2;
+    stream strm(eng, stream::flags::default_flags, max_threads);
+    ASSERT_EQ(strm.get_max_threads(), max_threads);
+
+    memory::desc md({4, 16, 8, 8}, memory::data_type::f32,
+            memory::format_tag::nchw);
+    auto src = memory(md, eng);
+    auto dst = memory(md, eng);
+    const size_t nelems = md.get_size() / sizeof(float);
+    {
+        auto src_ptr = map_memory<float>(src);
+        for (size_t i = 0; i < nelems; i++)
+            src_ptr[i] = (float)i - nelems / 2;
+    }
+
+    // Create the primitive for the width of the stream.
+    const int prev_limit = get_max_threads_limit();
+    ASSERT_EQ(set_max_threads_limit(max_threads), status::success);
+    ASSERT_EQ(get_max_threads_limit(), max_threads);
+    auto relu = eltwise_forward(
+            {{prop_kind::forward_inference, algorithm::eltwise_relu, md, 0.f},
+                    eng});
+    ASSERT_EQ(set_max_threads_limit(prev_limit), status::success);
+
+    relu.execute(strm, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+    strm.wait();
+    // The stream limit is removed after the execution.
+    ASSERT_EQ(get_max_threads_limit(), prev_limit);
+
+    auto dst_ptr = map_memory<float>(dst);
+    for (size_t i = 0; i < nelems; i++)
+        ASSERT_EQ(dst_ptr[i], std::max((float)i - nelems / 2, 0.f));
+}
+
+HANDLE_EXCEPTIONS_FOR_TEST(stream_test_cpp_t, MaxThreadsWiderExecution) {
+    engine eng(engine::kind::cpu, 0);
+    SKIP_IF(unsupported_data_type(memory::data_type::bf16, eng),
+            "Engine does not support this data type.");
+
+    // The per-thread scratchpad of bf16 nhwc pooling is sized at creation:
+    // the primitive must not use more threads when executed without the
+    // limit.
+    memory::desc src_md({8, 16, 8, 8}, memory::data_type::bf16,
+            memory::format_tag::nhwc);
+    memory::desc dst_md({8, 16, 4, 4}, memory::data_type::bf16,
+            memory::format_tag::nhwc);
+    const int prev_limit = get_max_threads_limit();
+    ASSERT_EQ(set_max_threads_limit(1), status::success);
+    auto pd = pooling_v2_forward::primitive_desc(
+            {prop_kind::forward_inference, algorithm::pooling_max, src_md,
+                    dst_md, {2, 2}, {2, 2}, {0, 0}, {0, 0}, {0, 0}},
+            eng);
+    auto pool = pooling_v2_forward(pd);
+    ASSERT_EQ(set_max_threads_limit(prev_limit), status::success);
+
+    auto src = memory(src_md, eng);
+    auto dst = memory(dst_md, eng);
+    stream strm(eng);
+    pool.execute(strm, {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
+    strm.wait();
+    ASSERT_EQ(get_max_threads_limit(), prev_limit);
+}
+#endif
+
 namespace {
 struct print_to_string_param_name_t {
     template <class ParamType>
@@ -0,0 +1,73 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+class tracing_test_t : public ::testing::Test {};
+
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE
+HANDLE_EXCEPTIONS_FOR_TEST(tracing_test_t, TestTraceFile) {
+    engine eng(engine::kind::cpu, 0);
+    const std::string path = "test_tracing.json";
+    auto st = set_trace_file(path);
+    if (st == status::unimplemented) return; // verbose is disabled
+
+    memory::desc md({2, 16}, memory::data_type::f32, memory::format_tag::ab);
+    auto mem = test::make_memory(md, eng);
+    stream s(eng);
+    auto relu_d = eltwise_forward::desc(
+            prop_kind::forward_inference, algorithm::eltwise_relu, md, 0.f);
+    auto relu = eltwise_forward({relu_d, eng});
+    for (int i = 0; i < 3; i++)
+        relu.execute(s, {{DNNL_ARG_SRC, mem}, {DNNL_ARG_DST, mem}});
+    s.wait();
+
+    ASSERT_EQ(flush_trace(), status::success);
+    // Disabling tracing must not write the events again.
+    ASSERT_EQ(set_trace_file(""), status::success);
+
+    std::ifstream f(path);
+    std::stringstream ss;
+    ss << f.rdbuf();
+    const std::string trace = ss.str();
+    std::remove(path.c_str());
+
+    ASSERT_EQ(trace.compare(0, 2, "[\n"), 0);
+    size_t n_exec = 0, n_create = 0;
+    for (size_t pos = trace.find("\"cat\":\"exec\""); pos != std::string::npos;
+            pos = trace.find("\"cat\":\"exec\"", pos + 1))
+        n_exec++;
+    for (size_t pos = trace.find("\"cat\":\"create\"");
+            pos != std::string::npos;
+            pos = trace.find("\"cat\":\"create\"", pos + 1))
+        n_create++;
+    ASSERT_EQ(n_exec, 3u);
+    ASSERT_EQ(n_create, 1u);
+    ASSERT_NE(trace.find("\"name\":\"eltwise\""), std::string::npos);
+}
+#endif
+
+} // namespace dnnl
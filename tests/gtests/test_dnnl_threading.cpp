@@ -14,6 +14,7 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <thread>
 #include <vector>
 
 #include "dnnl_test_common.hpp"
@@ -29,6 +30,104 @@ TEST(test_parallel, Test) {
     });
 }
 
+TEST(test_parallel, Nested) {
+    const int nthr = dnnl_get_max_threads();
+    std::vector<int> counts(nthr * nthr, 0);
+    impl::parallel(nthr, [&](int ithr, int) {
+        impl::parallel_nd(
+                nthr, [&](impl::dim_t jthr) { counts[ithr * nthr + jthr]++; });
+    });
+    for (int i = 0; i < nthr * nthr; i++)
+        ASSERT_EQ(counts[i], 1);
+}
+
+TEST(test_parallel, MaxThreadsLimit) {
+    const int limit = 2;
+    ASSERT_EQ(set_max_threads_limit(limit), status::success);
+    ASSERT_LE(dnnl_get_max_threads(), limit);
+    impl::parallel(0, [&](int ithr, int nthr) {
+        ASSERT_LE(nthr, limit);
+        // The threads of the region inherit the limit.
+        ASSERT_EQ(impl::get_max_threads_limit(), limit);
+    });
+    ASSERT_EQ(set_max_threads_limit(0), status::success);
+}
+
+TEST(test_parallel, Stats) {
+    impl::parallel_stats_t stats;
+    SKIP_IF(impl::set_parallel_stats(&stats) != impl::status::success,
+            "Parallel statistics are not supported.");
+
+    const int nthr = dnnl_get_max_threads();
+    const impl::dim_t work_amount = 10 * nthr + 3;
+    impl::parallel_nd(work_amount, [](impl::dim_t) {});
+    impl::set_parallel_stats(nullptr);
+    // Regions started after the collection is stopped are not accounted.
+    impl::parallel(nthr, [](int, int) {});
+
+    ASSERT_EQ(stats.n_regions, 1);
+    ASSERT_LE(stats.max_nthr, nthr);
+    const int region_nthr = stats.max_nthr;
+    ASSERT_EQ(stats.max_items,
+            (double)impl::utils::div_up(work_amount, region_nthr));
+    ASSERT_DOUBLE_EQ(stats.avg_items * region_nthr, (double)work_amount);
+    ASSERT_GE(stats.max_busy_ms, stats.avg_busy_ms);
+    ASSERT_GE(stats.imbalance(), 1.);
+}
+
+// Several application threads start regions at the same time. With the
+// work-stealing runtime they share the same pool.
+TEST(test_parallel, ConcurrentCallers) {
+    const int n_callers = 4;
+    const int n_regions = 20;
+    const impl::dim_t work_amount = 1000;
+    std::vector<std::vector<int>> counts(
+            n_callers, std::vector<int>(work_amount, 0));
+    std::vector<std::thread> callers;
+    for (int i = 0; i < n_callers; i++)
+        callers.emplace_back([&, i]() {
+            for (int r = 0; r < n_regions; r++)
+                impl::parallel_nd(
+                        work_amount, [&](impl::dim_t j) { counts[i][j]++; });
+        });
+    for (auto &t : callers)
+        t.join();
+    for (int i = 0; i < n_callers; i++)
+        for (impl::dim_t j = 0; j < work_amount; j++)
+            ASSERT_EQ(counts[i][j], n_regions);
+}
+
+// Only the first task starts a nested region: its tasks have to be taken by
+// the threads that are done with the outer region.
+TEST(test_parallel, NestedUnbalanced) {
+    const int nthr = dnnl_get_max_threads();
+    const int n_inner = 4 * nthr;
+    std::vector<int> counts(n_inner, 0);
+    impl::parallel(nthr, [&](int ithr, int) {
+        if (ithr != 0) return;
+        impl::parallel(n_inner, [&](int jthr, int) { counts[jthr]++; });
+    });
+    for (int i = 0; i < n_inner; i++)
+        ASSERT_EQ(counts[i], 1);
+}
+
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_WORK_STEALING
+TEST(test_parallel, WorkStealingRuntime) {
+    ASSERT_EQ(dnnl_version()->cpu_runtime, DNNL_RUNTIME_WORK_STEALING);
+    ASSERT_EQ(
+            dnnl_get_max_threads(), impl::work_stealing::get_num_threads());
+    // A region may be wider than the pool: the tasks are queued.
+    const int nthr = 3 * impl::work_stealing::get_num_threads() + 1;
+    std::vector<int> counts(nthr, 0);
+    impl::parallel(nthr, [&](int ithr, int region_nthr) {
+        ASSERT_EQ(region_nthr, nthr);
+        counts[ithr]++;
+    });
+    for (int i = 0; i < nthr; i++)
+        ASSERT_EQ(counts[i], 1);
+}
+#endif
+
 using data_t = ptrdiff_t;
 
 struct nd_params_t {
@@ -109,6 +109,149 @@ TEST(primitive_cache_test, TestCacheHit) {
 #endif
     ASSERT_EQ(get_primitive_cache_size(), 2);
 }
+
+TEST(primitive_cache_test, TestCapacityBytes) {
+    set_primitive_cache_capacity(0);
+    set_primitive_cache_capacity(16);
+    ASSERT_EQ(get_primitive_cache_capacity_bytes(), 0u);
+    ASSERT_EQ(get_primitive_cache_usage_bytes(), 0u);
+
+    fill_primitive_cache(8);
+    ASSERT_EQ(get_primitive_cache_usage_entries(), 8);
+    const size_t size_bytes = get_primitive_cache_usage_bytes();
+    ASSERT_GT(size_bytes, 0u);
+
+    set_primitive_cache_capacity_bytes(size_bytes / 2);
+    ASSERT_LE(get_primitive_cache_usage_bytes(), size_bytes / 2);
+    ASSERT_LT(get_primitive_cache_usage_entries(), 8);
+
+    fill_primitive_cache(8);
+    ASSERT_LE(get_primitive_cache_usage_bytes(), size_bytes / 2);
+
+    set_primitive_cache_capacity_bytes(0);
+    fill_primitive_cache(8);
+    ASSERT_EQ(get_primitive_cache_usage_entries(), 8);
+    ASSERT_EQ(get_primitive_cache_usage_bytes(), size_bytes);
+
+    set_primitive_cache_capacity(0);
+    ASSERT_EQ(get_primitive_cache_usage_bytes(), 0u);
+}
+
+TEST(primitive_cache_test, TestStats) {
+    set_primitive_cache_capacity(0);
+    set_primitive_cache_capacity(4);
+    reset_primitive_cache_stats();
+
+    fill_primitive_cache(6);
+    auto stats = get_primitive_cache_stats(primitive::kind::eltwise);
+    ASSERT_EQ(stats.hits, 0u);
+    ASSERT_EQ(stats.misses, 6u);
+    ASSERT_EQ(stats.evictions, 2u);
+    ASSERT_GE(stats.creation_time_ms, 0.);
+
+    // The last 4 primitives are still in the cache.
+    set_primitive_cache_capacity(6);
+    fill_primitive_cache(6);
+    stats = get_primitive_cache_stats(primitive::kind::eltwise);
+    ASSERT_EQ(stats.hits, 4u);
+    ASSERT_EQ(stats.misses, 8u);
+    ASSERT_EQ(stats.evictions, 2u);
+
+    auto total = get_primitive_cache_stats();
+    ASSERT_GE(total.hits, stats.hits);
+    ASSERT_GE(total.misses, stats.misses);
+    ASSERT_EQ(get_primitive_cache_stats(primitive::kind::convolution).misses,
+            0u);
+
+    reset_primitive_cache_stats();
+    total = get_primitive_cache_stats();
+    ASSERT_EQ(total.hits + total.misses + total.evictions, 0u);
+}
+
+TEST(primitive_cache_test, TestAsyncCreation) {
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+
+    set_primitive_cache_capacity(0);
+    set_primitive_cache_capacity(8);
+    reset_primitive_cache_stats();
+
+    engine eng(get_test_engine_kind(), 0);
+    std::vector<eltwise_forward::primitive_desc> pds;
+    std::vector<primitive_future> futures;
+    for (int i = 1; i <= 4; i++) {
+        auto relu_d = eltwise_forward::desc(prop_kind::forward_inference,
+                algorithm::eltwise_relu, {{i, 1, 1, 1}, dt::f32, tag::nchw},
+                0.f, 0.f);
+        pds.emplace_back(relu_d, eng);
+        futures.emplace_back(pds.back());
+    }
+
+    for (const auto &f : futures) {
+        auto p = f.get_primitive();
+        ASSERT_TRUE(f.is_ready());
+        ASSERT_EQ(p.get_kind(), primitive::kind::eltwise);
+        // A future can be queried multiple times.
+        ASSERT_EQ(f.get_primitive().get_primitive_desc(),
+                f.get_primitive().get_primitive_desc());
+    }
+    ASSERT_EQ(get_primitive_cache_size(), 4);
+
+    // Primitives created in the background are served from the cache.
+    for (const auto &pd : pds)
+        eltwise_forward p(pd);
+    auto stats = get_primitive_cache_stats(primitive::kind::eltwise);
+    ASSERT_EQ(stats.misses, 4u);
+    ASSERT_EQ(stats.hits, 4u);
+}
+
+TEST(primitive_cache_test, TestAsyncCreationPdDestroyed) {
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+
+    set_primitive_cache_capacity(0);
+    set_primitive_cache_capacity(8);
+
+    engine eng(get_test_engine_kind(), 0);
+    primitive_future f;
+    {
+        auto relu_d = eltwise_forward::desc(prop_kind::forward_inference,
+                algorithm::eltwise_relu, {{5, 1, 1, 1}, dt::f32, tag::nchw},
+                0.f, 0.f);
+        eltwise_forward::primitive_desc pd(relu_d, eng);
+        f = primitive_future(pd);
+    }
+    // The primitive descriptor is destroyed before the creation completes.
+    auto p = f.get_primitive();
+    ASSERT_EQ(p.get_kind(), primitive::kind::eltwise);
+    ASSERT_EQ(get_primitive_cache_size(), 1);
+}
+
+TEST(primitive_cache_test, TestPersistentCache) {
+    const std::string path = "dnnl_test_primitive_cache.bin";
+
+    set_primitive_cache_capacity(0);
+    set_primitive_cache_capacity(8);
+    fill_primitive_cache(4);
+    export_primitive_cache(path);
+
+    set_primitive_cache_capacity(0);
+    set_primitive_cache_capacity(8);
+    engine eng(get_test_engine_kind(), 0);
+    ASSERT_EQ(import_primitive_cache(eng, path), 4);
+    ASSERT_EQ(get_primitive_cache_size(), 4);
+
+    const size_t hits = get_primitive_cache_persistent_hits();
+    fill_primitive_cache(4);
+    ASSERT_EQ(get_primitive_cache_size(), 4);
+    ASSERT_EQ(get_primitive_cache_persistent_hits(), hits + 4);
+
+    // Each imported primitive is counted once.
+    fill_primitive_cache(4);
+    ASSERT_EQ(get_primitive_cache_persistent_hits(), hits + 4);
+
+    std::remove(path.c_str());
+}
 #endif
 
 } // namespace dnnl
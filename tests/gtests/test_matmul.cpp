@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 
 #include "oneapi/dnnl/dnnl.hpp"
+#include "tests/test_isa_common.hpp"
 
 #include <vector>
 
@@ -396,6 +397,309 @@ using iface = matmul_iface_test_t;
 
 using data_type = memory::data_type;
 
+class matmul_grouped_test_t
+    : public ::testing::TestWithParam<
+              std::tuple<memory::data_type, memory::data_type>> {};
+
+HANDLE_EXCEPTIONS_FOR_TEST_P(matmul_grouped_test_t, TestGroupedMatmul) {
+    auto engine_kind = get_test_engine_kind();
+    SKIP_IF(engine_kind != engine::kind::cpu,
+            "Grouped matmul is supported only on CPU");
+    const auto src_dt = std::get<0>(GetParam());
+    const auto wei_dt = std::get<1>(GetParam());
+    SKIP_IF(unsupported_data_type(src_dt) || unsupported_data_type(wei_dt),
+            "Engine does not support this data type.");
+
+    engine e {engine_kind, 0};
+    stream s(e);
+
+    // the second group is empty, the last ones are not multiples of any
+    // reasonable block size
+    const std::vector<int32_t> offsets = {0, 5, 5, 100, 133};
+    const memory::dim G = (memory::dim)offsets.size() - 1;
+    const memory::dim M = offsets.back(), K = 37, N = 70;
+
+    using tag = memory::format_tag;
+    memory::desc src_md({M, K}, src_dt, tag::ab);
+    memory::desc wei_md({G, K, N}, wei_dt, tag::abc);
+    memory::desc bia_md({G, 1, N}, data_type::f32, tag::abc);
+    memory::desc dst_md({M, N}, data_type::f32, tag::ab);
+    memory::desc off_md({G + 1}, data_type::s32, tag::a);
+
+    auto pd = matmul::primitive_desc(
+            matmul::grouped_desc(src_md, wei_md, bia_md, dst_md, off_md), e);
+    ASSERT_EQ(pd.group_offsets_desc(), off_md);
+    // The primitive is a matmul, the descriptor keeps the group offsets.
+    ASSERT_EQ(pd.get_kind(), primitive::kind::matmul);
+    const dnnl_matmul_grouped_desc_t *grouped_desc = nullptr;
+    ASSERT_EQ(dnnl_primitive_desc_query(pd.get(), dnnl_query_matmul_grouped_d,
+                      0, &grouped_desc),
+            dnnl_success);
+    ASSERT_EQ(grouped_desc->primitive_kind, dnnl_matmul_grouped);
+    ASSERT_EQ(memory::desc(grouped_desc->group_offsets_desc), off_md);
+
+    memory src(src_md, e), wei(wei_md, e), bia(bia_md, e), dst(dst_md, e),
+            off(off_md, e);
+
+    // small integer values keep the results exact for all data types
+    auto fill = [](const memory &mem, memory::data_type dt, int seed) {
+        const size_t nelems = mem.get_desc().get_size()
+                / memory::data_type_size(mem.get_desc().data_type());
+        auto val = [&](size_t i) { return (int)((i * 13 + seed) % 7) - 3; };
+        if (dt == data_type::f32) {
+            auto ptr = map_memory<float>(mem);
+            for (size_t i = 0; i < nelems; i++)
+                ptr[i] = (float)val(i);
+        } else if (dt == data_type::s8) {
+            auto ptr = map_memory<int8_t>(mem);
+            for (size_t i = 0; i < nelems; i++)
+                ptr[i] = (int8_t)val(i);
+        } else {
+            auto ptr = map_memory<uint8_t>(mem);
+            for (size_t i = 0; i < nelems; i++)
+                ptr[i] = (uint8_t)(val(i) + 3);
+        }
+    };
+    auto to_f32 = [](const memory &mem, memory::data_type dt) {
+        const size_t nelems = mem.get_desc().get_size()
+                / memory::data_type_size(mem.get_desc().data_type());
+        std::vector<float> res(nelems);
+        if (dt == data_type::f32) {
+            auto ptr = map_memory<float>(mem);
+            for (size_t i = 0; i < nelems; i++)
+                res[i] = ptr[i];
+        } else if (dt == data_type::s8) {
+            auto ptr = map_memory<int8_t>(mem);
+            for (size_t i = 0; i < nelems; i++)
+                res[i] = ptr[i];
+        } else {
+            auto ptr = map_memory<uint8_t>(mem);
+            for (size_t i = 0; i < nelems; i++)
+                res[i] = ptr[i];
+        }
+        return res;
+    };
+    fill(src, src_dt, 1);
+    fill(wei, wei_dt, 2);
+    fill(bia, data_type::f32, 3);
+    {
+        auto ptr = map_memory<int32_t>(off);
+        for (size_t i = 0; i < offsets.size(); i++)
+            ptr[i] = offsets[i];
+    }
+
+    matmul(pd).execute(s,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                    {DNNL_ARG_BIAS, bia}, {DNNL_ARG_DST, dst},
+                    {DNNL_ARG_GROUP_OFFSETS, off}});
+    s.wait();
+
+    const auto src_f = to_f32(src, src_dt);
+    const auto wei_f = to_f32(wei, wei_dt);
+    const auto bia_f = to_f32(bia, data_type::f32);
+
+    auto dst_ptr = map_memory<float>(dst);
+    for_(memory::dim g = 0; g < G; g++)
+    for_(memory::dim m = offsets[g]; m < offsets[g + 1]; m++)
+    for (memory::dim n = 0; n < N; n++) {
+        float ref = bia_f[g * N + n];
+        for (memory::dim k = 0; k < K; k++)
+            ref += src_f[m * K + k] * wei_f[(g * K + k) * N + n];
+        ASSERT_EQ(dst_ptr[m * N + n], ref) << "g: " << g << " m: " << m;
+    }
+
+    // offsets that do not cover all the rows are rejected at execution
+    map_memory<int32_t>(off)[G] = (int32_t)M - 1;
+    EXPECT_ANY_THROW(matmul(pd).execute(s,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                    {DNNL_ARG_BIAS, bia}, {DNNL_ARG_DST, dst},
+                    {DNNL_ARG_GROUP_OFFSETS, off}}));
+}
+
+INSTANTIATE_TEST_SUITE_P(Grouped, matmul_grouped_test_t,
+        ::testing::Values(std::make_tuple(data_type::f32, data_type::f32),
+                std::make_tuple(data_type::u8, data_type::s8)));
+
+class matmul_wei_decompression_test_t
+    : public ::testing::TestWithParam<memory::data_type> {};
+
+HANDLE_EXCEPTIONS_FOR_TEST_P(
+        matmul_wei_decompression_test_t, TestWeiDecompression) {
+    auto engine_kind = get_test_engine_kind();
+    SKIP_IF(engine_kind != engine::kind::cpu,
+            "Weights decompression is supported only on CPU");
+    const auto src_dt = GetParam();
+    SKIP_IF(unsupported_data_type(src_dt),
+            "Engine does not support this data type.");
+
+    engine e {engine_kind, 0};
+    stream s(e);
+
+    const memory::dim M = 19, K = 70, N = 37;
+    const int32_t wei_zp = 3;
+
+    using tag = memory::format_tag;
+    memory::desc src_md({M, K}, src_dt, tag::ab);
+    memory::desc wei_md({K, N}, data_type::s8, tag::ab);
+    memory::desc dst_md({M, N}, data_type::f32, tag::ab);
+
+    // per-N dequantization scales are passed as output scales
+    std::vector<float> scales(N);
+    for (memory::dim n = 0; n < N; n++)
+        scales[n] = 0.25f * (float)(n % 4 + 1);
+
+    primitive_attr attr;
+    attr.set_output_scales(1 << 1, scales);
+    attr.set_zero_points(DNNL_ARG_WEIGHTS, 0, {DNNL_RUNTIME_S32_VAL});
+
+    auto pd = matmul::primitive_desc(
+            matmul::desc(src_md, wei_md, dst_md), attr, e);
+
+    // The brgemm implementation decompresses the weights while packing them.
+    // For bf16 it is available only with AMX.
+    bool expect_brgemm = false;
+#if DNNL_X64 && (DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE)
+    expect_brgemm = src_dt == data_type::f32
+            ? dnnl::mayiuse(cpu_isa::avx512_core)
+            : dnnl::mayiuse(cpu_isa::avx512_core_amx);
+#endif
+    if (expect_brgemm) {
+        std::string impl_info;
+        ASSERT_NO_THROW(impl_info = pd.impl_info_str(););
+        ASSERT_EQ(impl_info.find("brg"), 0u) << impl_info;
+    }
+
+    memory src(src_md, e), wei(wei_md, e), dst(dst_md, e);
+    memory zp_mem({{1}, data_type::s32, tag::a}, e);
+
+    // small integer values keep the results exact for all data types
+    auto val = [](memory::dim i, int seed) {
+        return (int)((i * 13 + seed) % 7) - 3;
+    };
+    {
+        auto ptr = map_memory<int8_t>(wei);
+        for (memory::dim i = 0; i < K * N; i++)
+            ptr[i] = (int8_t)(val(i, 2) * 20);
+    }
+    if (src_dt == data_type::f32) {
+        auto ptr = map_memory<float>(src);
+        for (memory::dim i = 0; i < M * K; i++)
+            ptr[i] = (float)val(i, 1);
+    } else {
+        auto ptr = map_memory<bfloat16_t>(src);
+        for (memory::dim i = 0; i < M * K; i++)
+            ptr[i] = (float)val(i, 1);
+    }
+    map_memory<int32_t>(zp_mem)[0] = wei_zp;
+
+    matmul(pd).execute(s,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei}, {DNNL_ARG_DST, dst},
+                    {DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_WEIGHTS, zp_mem}});
+    s.wait();
+
+    auto wei_ptr = map_memory<int8_t>(wei);
+    auto dst_ptr = map_memory<float>(dst);
+    for_(memory::dim m = 0; m < M; m++)
+    for (memory::dim n = 0; n < N; n++) {
+        float ref = 0.f;
+        for (memory::dim k = 0; k < K; k++)
+            ref += (float)val(m * K + k, 1)
+                    * (float)(wei_ptr[k * N + n] - wei_zp);
+        ref *= scales[n];
+        ASSERT_EQ(dst_ptr[m * N + n], ref) << "m: " << m << " n: " << n;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(WeiDecompression, matmul_wei_decompression_test_t,
+        ::testing::Values(data_type::f32, data_type::bf16));
+
+class matmul_src_dyn_quant_test_t
+    : public ::testing::TestWithParam<memory::data_type> {};
+
+HANDLE_EXCEPTIONS_FOR_TEST_P(matmul_src_dyn_quant_test_t, TestSrcDynQuant) {
+    auto engine_kind = get_test_engine_kind();
+    SKIP_IF(engine_kind != engine::kind::cpu,
+            "Src dynamic quantization is supported only on CPU");
+    const auto src_dt = GetParam();
+    SKIP_IF(unsupported_data_type(src_dt),
+            "Engine does not support this data type.");
+
+    engine e {engine_kind, 0};
+    stream s(e);
+
+    const memory::dim B = 2, M = 21, K = 70, N = 37;
+
+    using tag = memory::format_tag;
+    memory::desc src_md({B, M, K}, src_dt, tag::abc);
+    memory::desc wei_md({1, K, N}, data_type::s8, tag::abc);
+    memory::desc bia_md({1, 1, N}, data_type::f32, tag::abc);
+    memory::desc dst_md({B, M, N}, data_type::f32, tag::abc);
+
+    primitive_attr attr;
+    attr.set_output_scales(0, {0.5f});
+    attr.set_src_dynamic_quantization(data_type::s8);
+    ASSERT_EQ(attr.get_src_dynamic_quantization(), data_type::s8);
+
+    auto pd = matmul::primitive_desc(
+            matmul::desc(src_md, wei_md, bia_md, dst_md), attr, e);
+
+    // The brgemm implementation runs int8 computations only with AMX.
+    bool expect_brgemm = false;
+#if DNNL_X64 && (DNNL_CPU_RUNTIME != DNNL_RUNTIME_NONE)
+    expect_brgemm = dnnl::mayiuse(cpu_isa::avx512_core_amx);
+#endif
+    if (expect_brgemm) {
+        std::string impl_info;
+        ASSERT_NO_THROW(impl_info = pd.impl_info_str(););
+        ASSERT_EQ(impl_info.find("brg"), 0u) << impl_info;
+    }
+
+    memory src(src_md, e), wei(wei_md, e), bia(bia_md, e), dst(dst_md, e);
+
+    // src rows hold integers multiplied by a power-of-two row scale with the
+    // row maximum equal to 127 scales, so that the quantization is exact
+    auto q_val = [&](memory::dim i) {
+        return i % K == 0 ? 127 : (int)((i * 13 + 1) % 7 - 3) * 40;
+    };
+    auto row_scale = [](memory::dim row) { return 1.f / (1 << (row % 4)); };
+    auto wei_val = [](memory::dim i) { return (int)((i * 11 + 2) % 7) - 3; };
+    {
+        auto ptr = map_memory<int8_t>(wei);
+        for (memory::dim i = 0; i < K * N; i++)
+            ptr[i] = (int8_t)wei_val(i);
+        auto bia_ptr = map_memory<float>(bia);
+        for (memory::dim n = 0; n < N; n++)
+            bia_ptr[n] = (float)(n % 5);
+    }
+    if (src_dt == data_type::f32) {
+        auto ptr = map_memory<float>(src);
+        for (memory::dim i = 0; i < B * M * K; i++)
+            ptr[i] = q_val(i) * row_scale(i / K);
+    } else {
+        auto ptr = map_memory<bfloat16_t>(src);
+        for (memory::dim i = 0; i < B * M * K; i++)
+            ptr[i] = q_val(i) * row_scale(i / K);
+    }
+
+    matmul(pd).execute(s,
+            {{DNNL_ARG_SRC, src}, {DNNL_ARG_WEIGHTS, wei},
+                    {DNNL_ARG_BIAS, bia}, {DNNL_ARG_DST, dst}});
+    s.wait();
+
+    auto dst_ptr = map_memory<float>(dst);
+    for_(memory::dim row = 0; row < B * M; row++)
+    for (memory::dim n = 0; n < N; n++) {
+        int acc = 0;
+        for (memory::dim k = 0; k < K; k++)
+            acc += q_val(row * K + k) * wei_val(k * N + n);
+        const float ref = 0.5f * (acc * row_scale(row) + (float)(n % 5));
+        ASSERT_EQ(dst_ptr[row * N + n], ref) << "row: " << row << " n: " << n;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(SrcDynQuant, matmul_src_dyn_quant_test_t,
+        ::testing::Values(data_type::f32, data_type::bf16));
+
 TEST_P(iface, TestsMatMul) {}
 
 static auto cases_ef = []() {
@@ -19,6 +19,8 @@
 
 #include "dnnl.hpp"
 
+#include <thread>
+
 namespace dnnl {
 
 TEST(primitive_cache_mt_test, TestGeneralCase) {
@@ -102,4 +104,50 @@ TEST(primitive_cache_mt_test, TestMTCacheHit) {
     ASSERT_EQ(get_primitive_cache_size(), n_primitives);
 }
 
+// All threads create the same set of primitives concurrently: every request
+// after the initial creation must be a cache hit regardless of the number of
+// shards.
+TEST(primitive_cache_mt_test, TestMTCacheHits) {
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+
+    engine eng(get_test_engine_kind(), 0);
+
+    dnnl::set_primitive_cache_capacity(0);
+    dnnl::set_primitive_cache_capacity(1024);
+
+    const int n_primitives = 64;
+    const int n_iters = 100;
+    const int nthr = 8;
+
+    auto create_eltwise_primitive = [&](int np) {
+        auto relu_d = eltwise_forward::desc(prop_kind::forward_inference,
+                algorithm::eltwise_relu, {{np, 1, 1, 1}, dt::f32, tag::nchw},
+                0.f, 0.f);
+        auto relu_pd = eltwise_forward::primitive_desc(relu_d, eng);
+        auto relu = eltwise_forward(relu_pd);
+    };
+
+    for (int i = 0; i < n_primitives; i++)
+        create_eltwise_primitive(i);
+
+    const auto stats_before = get_primitive_cache_stats();
+
+    std::vector<std::thread> threads;
+    for (int ithr = 0; ithr < nthr; ithr++) {
+        threads.emplace_back([&, ithr]() {
+            for (int i = 0; i < n_iters; i++)
+                create_eltwise_primitive((ithr + i) % n_primitives);
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+
+    const auto stats_after = get_primitive_cache_stats();
+    ASSERT_EQ(stats_after.hits - stats_before.hits, (size_t)nthr * n_iters);
+    ASSERT_EQ(stats_after.misses, stats_before.misses);
+    ASSERT_EQ(stats_after.evictions, stats_before.evictions);
+    ASSERT_EQ(get_primitive_cache_size(), n_primitives);
+}
+
 } // namespace dnnl
@@ -0,0 +1,134 @@
+/*******************************************************************************
+* Copyright 2021 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <thread>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+using dt = memory::data_type;
+using tag = memory::format_tag;
+
+class scratchpad_pool_test_t : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Scratchpad pool is implemented for CPU only.
+        if (get_test_engine_kind() != engine::kind::cpu) return;
+
+        eng_ = engine(engine::kind::cpu, 0);
+        strm_ = stream(eng_);
+
+        // Backward by weights convolution with bias uses scratchpad for the
+        // reduction over the minibatch in most implementations.
+        memory::desc src_md({16, 32, 14, 14}, dt::f32, tag::any);
+        memory::desc wei_md({32, 32, 3, 3}, dt::f32, tag::any);
+        memory::desc bia_md({32}, dt::f32, tag::any);
+        memory::desc dst_md({16, 32, 14, 14}, dt::f32, tag::any);
+        memory::dims strides {1, 1}, padding {1, 1};
+
+        auto fwd_pd = convolution_forward::primitive_desc(
+                {prop_kind::forward_training, algorithm::convolution_direct,
+                        src_md, wei_md, bia_md, dst_md, strides, padding,
+                        padding},
+                eng_);
+        pd_ = convolution_backward_weights::primitive_desc(
+                {algorithm::convolution_direct, src_md, wei_md, bia_md,
+                        dst_md, strides, padding, padding},
+                eng_, fwd_pd);
+        args_ = {{DNNL_ARG_SRC, test::make_memory(pd_.src_desc(), eng_)},
+                {DNNL_ARG_DIFF_DST,
+                        test::make_memory(pd_.diff_dst_desc(), eng_)},
+                {DNNL_ARG_DIFF_WEIGHTS,
+                        test::make_memory(pd_.diff_weights_desc(), eng_)},
+                {DNNL_ARG_DIFF_BIAS,
+                        test::make_memory(pd_.diff_bias_desc(), eng_)}};
+    }
+
+    // Returns false if the pool is not used for the primitive, e.g. when it
+    // is not enabled or the primitive does not need a scratchpad.
+    bool execute_and_check_pool() {
+        if (!pd_) return false;
+        auto before = get_scratchpad_pool_stats();
+        convolution_backward_weights(pd_).execute(strm_, args_);
+        strm_.wait();
+        auto after = get_scratchpad_pool_stats();
+        return after.n_allocations + after.n_reuses
+                > before.n_allocations + before.n_reuses;
+    }
+
+    engine eng_;
+    stream strm_;
+    convolution_backward_weights::primitive_desc pd_;
+    std::unordered_map<int, memory> args_;
+};
+
+TEST_F(scratchpad_pool_test_t, TestReuse) {
+    SKIP_IF(!execute_and_check_pool(), "Scratchpad pool is not used.");
+
+    auto stats = get_scratchpad_pool_stats();
+    ASSERT_EQ(stats.in_use, 0u);
+    ASSERT_GT(stats.peak_in_use, 0u);
+    ASSERT_GE(stats.peak_total, stats.peak_in_use);
+    ASSERT_GT(stats.cached, 0u);
+
+    // The buffer returned to the pool is taken again by the next execution
+    // on the same thread.
+    for (int i = 0; i < 4; i++)
+        ASSERT_TRUE(execute_and_check_pool());
+    auto new_stats = get_scratchpad_pool_stats();
+    ASSERT_EQ(new_stats.n_allocations, stats.n_allocations);
+    ASSERT_EQ(new_stats.n_reuses, stats.n_reuses + 4);
+    ASSERT_EQ(new_stats.in_use, 0u);
+}
+
+TEST_F(scratchpad_pool_test_t, TestConcurrentExecution) {
+    SKIP_IF(!execute_and_check_pool(), "Scratchpad pool is not used.");
+
+    // With the pool, the same primitive can be executed concurrently since
+    // each execution gets its own scratchpad. The inputs are shared, while
+    // each thread writes to its own outputs.
+    const int nthr = 4;
+    std::vector<std::unordered_map<int, memory>> thr_args(nthr, args_);
+    for (auto &args : thr_args) {
+        args[DNNL_ARG_DIFF_WEIGHTS]
+                = test::make_memory(pd_.diff_weights_desc(), eng_);
+        args[DNNL_ARG_DIFF_BIAS]
+                = test::make_memory(pd_.diff_bias_desc(), eng_);
+    }
+
+    convolution_backward_weights prim(pd_);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nthr; i++)
+        threads.emplace_back([&, i]() {
+            stream strm(eng_);
+            for (int j = 0; j < 4; j++)
+                prim.execute(strm, thr_args[i]);
+            strm.wait();
+        });
+    for (auto &t : threads)
+        t.join();
+
+    auto stats = get_scratchpad_pool_stats();
+    ASSERT_EQ(stats.in_use, 0u);
+    ASSERT_GE(stats.peak_total, stats.cached);
+}
+
+} // namespace dnnl